@@ -22,6 +22,8 @@
 #include "mir/dispatch/dispatchable.h"
 #include "mir/posix_rw_mutex.h"
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <initializer_list>
 #include <list>
@@ -97,6 +99,9 @@ public:
 private:
     PosixRWMutex lifetime_mutex;
     std::list<std::pair<std::shared_ptr<Dispatchable>, bool>> dispatchee_holder;
+    /// Bumped (with lifetime_mutex held) whenever a watch is removed, so dispatch() only needs to
+    /// re-check the sources it has harvested when this has changed
+    std::atomic<uint64_t> removal_generation{0};
 
     Fd epoll_fd;
 };
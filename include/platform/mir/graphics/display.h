@@ -124,6 +124,28 @@ public:
      */
     virtual void configure(DisplayConfiguration const& conf) = 0;
 
+    /**
+     * Sets a new output configuration, keeping the DisplaySyncGroups of outputs it leaves unchanged.
+     *
+     * Before a DisplaySyncGroup is destroyed \p before_removal is called with it; after that
+     * the group and its DisplayBuffers must no longer be used. Groups that are kept remain valid
+     * and may continue to be composited to while this function runs. Groups that are created can
+     * be found with for_each_display_sync_group() afterwards.
+     *
+     * If this function returns \c false the configuration has not been applied (although
+     * \p before_removal may already have been called) and has to be applied with configure().
+     *
+     * \param conf [in]            Configuration to apply.
+     * \param before_removal [in]  Called with each group that is about to be destroyed.
+     * \return      \c true if \p conf has been applied as the new output configuration.
+     */
+    virtual bool apply_keeping_unchanged_sync_groups(
+        DisplayConfiguration const& /*conf*/,
+        std::function<void(DisplaySyncGroup&)> const& /*before_removal*/)
+    {
+        return false;
+    }
+
     /**
      * Registers a handler for display configuration changes.
      *
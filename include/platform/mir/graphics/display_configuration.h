@@ -143,6 +143,11 @@ struct DisplayConfigurationOutput
 
     mir::optional_value<geometry::Size> custom_logical_size;
 
+    /** Whether the output supports variable refresh rate (VESA Adaptive Sync/FreeSync/G-Sync) */
+    bool adaptive_sync_capable{false};
+    /** Whether variable refresh may be used for fullscreen content on this output */
+    bool adaptive_sync{false};
+
     /** The logical rectangle occupied by the output, based on its position,
         current mode and orientation (rotation) */
     geometry::Rectangle extents() const;
@@ -187,6 +192,8 @@ struct UserDisplayConfigurationOutput
     MirOutputGammaSupported const& gamma_supported;
     std::vector<uint8_t const> const& edid;
     mir::optional_value<geometry::Size>& custom_logical_size;
+    bool const& adaptive_sync_capable;
+    bool& adaptive_sync;
 
     UserDisplayConfigurationOutput(DisplayConfigurationOutput& master);
     geometry::Rectangle extents() const;
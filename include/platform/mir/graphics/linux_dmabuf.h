@@ -24,26 +24,40 @@
 #include <EGL/egl.h>
 
 #include "mir/graphics/buffer.h"
+#include "mir/graphics/dmabuf_buffer.h"
 #include "mir/graphics/egl_extensions.h"
 
+#include <optional>
+#include <vector>
+
 
 namespace mir
 {
 class Executor;
 
-namespace renderer
-{
-namespace gl
-{
-class Context;
-}
-}
-
 namespace graphics
 {
 
 class DmaBufFormatDescriptors;
 
+/**
+ * Import dmabufs into EGL
+ *
+ * This needs no current context, so may be called on any thread. Drivers can take
+ * milliseconds over it, so it's best kept off the Wayland thread.
+ *
+ * \param modifier  The format modifier of the planes, if the client specified one
+ * \return  An EGLImageKHR handle to the imported dmabufs, owned by the caller
+ * \throws  A std::system_error containing the EGL error on failure.
+ */
+auto import_dmabuf_egl_image(
+    EGLDisplay dpy,
+    EGLExtensions const& egl_extensions,
+    geometry::Size size,
+    uint32_t format,
+    std::optional<uint64_t> modifier,
+    std::vector<DMABufBuffer::PlaneDescriptor> const& planes) -> EGLImageKHR;
+
 class LinuxDmaBufUnstable : public mir::wayland::LinuxDmabufV1::Global
 {
 public:
@@ -51,14 +65,22 @@ public:
         wl_display* display,
         EGLDisplay dpy,
         std::shared_ptr<EGLExtensions> egl_extensions,
-        EGLExtensions::EXTImageDmaBufImportModifiers const& dmabuf_ext);
+        EGLExtensions::EXTImageDmaBufImportModifiers const& dmabuf_ext,
+        std::shared_ptr<Executor> wayland_executor,
+        std::shared_ptr<Executor> egl_delegate);
 
+    /**
+     * Import \a buffer if it was created through linux-dmabuf
+     *
+     * The import into a texture happens on \a egl_delegate's thread, so no GL context
+     * needs to be current.
+     *
+     * \return The imported buffer, or null if \a buffer is not a dmabuf buffer
+     */
     std::shared_ptr<Buffer> buffer_from_resource(
         wl_resource* buffer,
-        std::shared_ptr<renderer::gl::Context> ctx,
         std::function<void()>&& on_consumed,
-        std::function<void()>&& on_release,
-        std::shared_ptr<Executor> wayland_executor);
+        std::function<void()>&& on_release);
 
 private:
     class Instance;
@@ -67,6 +89,9 @@ private:
     EGLDisplay const dpy;
     std::shared_ptr<EGLExtensions> const egl_extensions;
     std::shared_ptr<DmaBufFormatDescriptors> const formats;
+    std::shared_ptr<Executor> const wayland_executor;
+    /// Runs work with a current EGL context that shares textures with the compositor
+    std::shared_ptr<Executor> const egl_delegate;
 };
 
 }
@@ -35,6 +35,7 @@ extern char const* const compositor_report_opt;
 extern char const* const display_report_opt;
 extern char const* const scene_report_opt;
 extern char const* const input_report_opt;
+extern char const* const input_latency_report_opt;
 extern char const* const seat_report_opt;
 extern char const* const touchspots_opt;
 extern char const* const cursor_opt;
@@ -42,6 +43,11 @@ extern char const* const fatal_except_opt;
 extern char const* const debug_opt;
 extern char const* const composite_delay_opt;
 extern char const* const enable_key_repeat_opt;
+extern char const* const occluded_frame_interval_opt;
+extern char const* const client_max_surfaces_opt;
+extern char const* const client_max_frame_callbacks_opt;
+extern char const* const client_max_commit_rate_opt;
+extern char const* const client_max_buffer_memory_opt;
 extern char const* const x11_display_opt;
 extern char const* const x11_scale_opt;
 extern char const* const wayland_extensions_opt;
@@ -58,6 +64,7 @@ extern char const* const platform_display_libs;
 extern char const* const platform_rendering_libs;
 extern char const* const platform_input_lib;
 extern char const* const platform_path;
+extern char const* const platform_probe_cache_opt;
 
 extern char const* const console_provider;
 extern char const* const logind_console;
@@ -31,11 +31,15 @@
 #include <string.h>
 #include <system_error>
 #include <algorithm>
+#include <array>
 
 namespace md = mir::dispatch;
 
 namespace
 {
+/// The most ready sources harvested by one call to dispatch()
+int const max_events_per_dispatch = 16;
+
 class DispatchableAdaptor : public md::Dispatchable
 {
 public:
@@ -108,45 +112,133 @@ bool md::MultiplexingDispatchable::dispatch(md::FdEvents events)
         return false;
     }
 
-    std::shared_ptr<md::Dispatchable> source;
-    bool rearm_source{false};
-    epoll_event event;
+    /* Harvest a batch of ready sources with a single epoll_wait() (and a single
+     * acquisition of the lifetime lock) so that when many devices report at once
+     * we don't pay for a syscall and a lock per event.
+     */
+    std::array<epoll_event, max_events_per_dispatch> ready_events;
+    std::array<std::pair<std::shared_ptr<md::Dispatchable>, bool>, max_events_per_dispatch> ready_sources;
+    std::array<bool, max_events_per_dispatch> still_watched;
+    int ready_count;
+    uint64_t validated_generation;
 
     {
         std::shared_lock<decltype(lifetime_mutex)> lock{lifetime_mutex};
 
-        auto result = epoll_wait(epoll_fd, &event, 1, 0);
+        ready_count = epoll_wait(epoll_fd, ready_events.data(), ready_events.size(), 0);
 
-        if (result < 0)
+        if (ready_count < 0)
         {
             BOOST_THROW_EXCEPTION((std::system_error{errno,
                                                      std::system_category(),
                                                      "Failed to wait on fds"}));
         }
 
-        if (result == 0)
+        if (ready_count == 0)
         {
             // Some other thread must have stolen the event we were woken for;
             // that's ok, just return.
             return true;
         }
 
-        auto event_source = reinterpret_cast<decltype(dispatchee_holder)::pointer>(event.data.ptr);
-
-        source = event_source->first;
-        rearm_source = event_source->second;
+        for (int i = 0; i != ready_count; ++i)
+        {
+            ready_sources[i] = *reinterpret_cast<decltype(dispatchee_holder)::pointer>(ready_events[i].data.ptr);
+            still_watched[i] = true;
+        }
+        validated_generation = removal_generation;
     }
 
-    if (!source->dispatch(epoll_to_fd_event(event)))
+    /* A source removed since the batch was harvested (possibly by another source's dispatch())
+     * may have had its fd reused by a new watch, so mustn't be dispatched or re-armed. Removals
+     * are rare, so the batch is only re-checked when one has happened; must be called with
+     * lifetime_mutex held.
+     */
+    auto const revalidate_if_removals = [&]()
+        {
+            auto const generation = removal_generation.load();
+            if (generation == validated_generation)
+            {
+                return;
+            }
+            validated_generation = generation;
+
+            for (int i = 0; i != ready_count; ++i)
+            {
+                auto const& source = ready_sources[i].first;
+                still_watched[i] = still_watched[i] && std::any_of(
+                    dispatchee_holder.begin(),
+                    dispatchee_holder.end(),
+                    [&source](auto const& candidate) { return candidate.first == source; });
+            }
+        };
+
+    // Sequential sources are re-armed once the whole batch has been dispatched
+    std::array<int, max_events_per_dispatch> to_rearm;
+    int rearm_count{0};
+
+    auto const rearm = [&]()
+        {
+            if (rearm_count == 0)
+            {
+                return;
+            }
+
+            std::shared_lock<decltype(lifetime_mutex)> lock{lifetime_mutex};
+            revalidate_if_removals();
+            for (int n = 0; n != rearm_count; ++n)
+            {
+                auto const i = to_rearm[n];
+                auto const& source = ready_sources[i].first;
+
+                if (still_watched[i])
+                {
+                    ready_events[i].events = fd_event_to_epoll(source->relevant_events()) | EPOLLONESHOT;
+                    epoll_ctl(epoll_fd, EPOLL_CTL_MOD, source->watch_fd(), &ready_events[i]);
+                }
+            }
+        };
+
+    int next{0};
+    try
     {
-        remove_watch(source);
+        for (; next != ready_count; ++next)
+        {
+            auto const& source = ready_sources[next].first;
+            if (removal_generation != validated_generation)
+            {
+                std::shared_lock<decltype(lifetime_mutex)> lock{lifetime_mutex};
+                revalidate_if_removals();
+            }
+            if (!still_watched[next])
+            {
+                continue;
+            }
+            if (!source->dispatch(epoll_to_fd_event(ready_events[next])))
+            {
+                remove_watch(source);
+            }
+            else if (ready_sources[next].second)
+            {
+                to_rearm[rearm_count++] = next;
+            }
+        }
     }
-    else if (rearm_source)
+    catch (...)
     {
-        event.events = fd_event_to_epoll(source->relevant_events()) | EPOLLONESHOT;
-        epoll_ctl(epoll_fd, EPOLL_CTL_MOD, source->watch_fd(), &event);
+        // The sources we haven't got to still have their events pending
+        for (++next; next < ready_count; ++next)
+        {
+            if (ready_sources[next].second)
+            {
+                to_rearm[rearm_count++] = next;
+            }
+        }
+        rearm();
+        throw;
     }
 
+    rearm();
     return true;
 }
 
@@ -227,4 +319,5 @@ void md::MultiplexingDispatchable::remove_watch(Fd const& fd)
     {
         return candidate.first->watch_fd() == fd;
     });
+    ++removal_generation;
 }
@@ -0,0 +1,190 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/input/compiled_keymap.h"
+#include "mir/input/keymap.h"
+#include "mir/anonymous_shm_file.h"
+
+#include <xkbcommon/xkbcommon.h>
+#include <boost/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <system_error>
+#include <vector>
+
+#include <fcntl.h>
+#include <linux/memfd.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace mi = mir::input;
+
+namespace
+{
+/// Serialises every reference count change on the shared xkb_keymaps (and their contexts)
+std::mutex xkb_references;
+
+std::mutex cache_mutex;
+std::vector<std::weak_ptr<mi::CompiledKeymap const>> cache;
+
+void unref_state(xkb_state* state)
+{
+    std::lock_guard<std::mutex> lock{xkb_references};
+    xkb_state_unref(state);
+}
+
+auto compile(mi::Keymap const& keymap, xkb_context* context) -> xkb_keymap*
+{
+    try
+    {
+        return keymap.make_unique_xkb_keymap(context).release();
+    }
+    catch (...)
+    {
+        xkb_context_unref(context);
+        throw;
+    }
+}
+
+auto text_of(xkb_keymap* keymap) -> std::unique_ptr<char, void(*)(void*)>
+{
+    return {xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1), &free};
+}
+
+/// A memfd holding \a size bytes of \a data that can no longer be changed, or an invalid Fd if memfds can't be sealed
+auto sealed_memfd_of(char const* data, size_t size) -> mir::Fd
+{
+    mir::Fd const fd{static_cast<int>(syscall(SYS_memfd_create, "mir-keymap", MFD_CLOEXEC | MFD_ALLOW_SEALING))};
+    if (fd == mir::Fd::invalid)
+    {
+        return {};
+    }
+
+    for (size_t written = 0; written < size; )
+    {
+        auto const result = write(fd, data + written, size - written);
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            return {};
+        }
+        written += result;
+    }
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0)
+    {
+        return {};
+    }
+    return fd;
+}
+
+auto anonymous_file_of(char const* data, size_t size) -> mir::Fd
+{
+    mir::AnonymousShmFile file{size};
+    memcpy(file.base_ptr(), data, size);
+    return mir::Fd{fcntl(file.fd(), F_DUPFD_CLOEXEC, 0)};
+}
+}
+
+auto mi::CompiledKeymap::of(std::shared_ptr<Keymap> const& keymap) -> std::shared_ptr<CompiledKeymap const>
+{
+    std::lock_guard<std::mutex> lock{cache_mutex};
+
+    cache.erase(
+        std::remove_if(cache.begin(), cache.end(), [](auto const& entry) { return entry.expired(); }),
+        cache.end());
+
+    for (auto const& entry : cache)
+    {
+        if (auto const compiled = entry.lock())
+        {
+            if (compiled->keymap()->matches(*keymap))
+            {
+                return compiled;
+            }
+        }
+    }
+
+    std::shared_ptr<CompiledKeymap const> const compiled{new CompiledKeymap{keymap}};
+    cache.push_back(compiled);
+    return compiled;
+}
+
+mi::CompiledKeymap::CompiledKeymap(std::shared_ptr<Keymap> const& keymap)
+    : keymap_{keymap},
+      context{xkb_context_new(XKB_CONTEXT_NO_FLAGS)},
+      compiled{compile(*keymap, context)}
+{
+    auto const keymap_text = text_of(compiled);
+    text_size_ = strlen(keymap_text.get()) + 1;
+
+    text = sealed_memfd_of(keymap_text.get(), text_size_);
+    text_sealed = text != Fd::invalid;
+    if (!text_sealed)
+    {
+        text = anonymous_file_of(keymap_text.get(), text_size_);
+    }
+}
+
+mi::CompiledKeymap::~CompiledKeymap()
+{
+    // States made from the keymap may outlive us, so this may not be the last reference
+    std::lock_guard<std::mutex> lock{xkb_references};
+    xkb_keymap_unref(compiled);
+    xkb_context_unref(context);
+}
+
+auto mi::CompiledKeymap::keymap() const -> std::shared_ptr<Keymap> const&
+{
+    return keymap_;
+}
+
+auto mi::CompiledKeymap::make_state() const -> XKBStatePtr
+{
+    std::lock_guard<std::mutex> lock{xkb_references};
+    return {xkb_state_new(compiled), &unref_state};
+}
+
+auto mi::CompiledKeymap::text_fd() const -> Fd
+{
+    if (text_sealed)
+    {
+        // Reopening (rather than duplicating) gives a file description with its own offset
+        auto const path = "/proc/self/fd/" + std::to_string(int{text});
+        Fd reopened{open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+        if (reopened != Fd::invalid)
+        {
+            return reopened;
+        }
+    }
+
+    // Without a sealed file (or /proc) to share, each client gets its own copy
+    std::vector<char> keymap_text(text_size_);
+    if (pread(text, keymap_text.data(), text_size_, 0) != static_cast<ssize_t>(text_size_))
+    {
+        BOOST_THROW_EXCEPTION((std::system_error{errno, std::system_category(), "Failed to read keymap"}));
+    }
+    return anonymous_file_of(keymap_text.data(), text_size_);
+}
+
+auto mi::CompiledKeymap::text_size() const -> size_t
+{
+    return text_size_;
+}
@@ -114,11 +114,6 @@ mi::XKBComposeTablePtr make_unique_compose_table_from_locale(mi::XKBContextPtr c
             XKB_COMPOSE_COMPILE_NO_FLAGS),
            &xkb_compose_table_unref};
 }
-
-mi::XKBStatePtr make_unique_state(xkb_keymap* keymap)
-{
-    return {xkb_state_new(keymap), xkb_state_unref};
-}
 }
 
 mi::XKBContextPtr mi::make_unique_context()
@@ -217,7 +212,7 @@ void mircv::XKBMapper::set_keymap(std::shared_ptr<Keymap> new_keymap)
 {
     std::lock_guard<std::mutex> lg(guard);
     default_keymap = std::move(new_keymap);
-    default_compiled_keymap = default_keymap->make_unique_xkb_keymap(context.get());
+    default_compiled_keymap = CompiledKeymap::of(default_keymap);
     device_mapping.clear();
 }
 
@@ -230,7 +225,7 @@ void mircv::XKBMapper::set_keymap(MirInputDeviceId id, std::shared_ptr<Keymap> n
 {
     std::lock_guard<std::mutex> lg(guard);
 
-    auto compiled_keymap = new_keymap->make_unique_xkb_keymap(context.get());
+    auto compiled_keymap = CompiledKeymap::of(new_keymap);
     auto mapping_state = std::make_unique<XkbMappingState>(std::move(new_keymap), std::move(compiled_keymap));
 
     device_mapping.erase(id);
@@ -275,10 +270,10 @@ MirInputEventModifiers mircv::XKBMapper::device_modifiers(MirInputDeviceId id) c
 
 mircv::XKBMapper::XkbMappingState::XkbMappingState(
     std::shared_ptr<Keymap> keymap,
-    std::shared_ptr<xkb_keymap> compiled_keymap)
+    std::shared_ptr<CompiledKeymap const> compiled_keymap)
     : keymap{std::move(keymap)},
       compiled_keymap{std::move(compiled_keymap)},
-      state{make_unique_state(this->compiled_keymap.get())}
+      state{this->compiled_keymap->make_state()}
 {
 }
 
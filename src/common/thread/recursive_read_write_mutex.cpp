@@ -19,69 +19,126 @@
 #include "mir/recursive_read_write_mutex.h"
 
 #include <algorithm>
+#include <vector>
 
-void mir::RecursiveReadWriteMutex::read_lock()
+namespace
 {
-    auto const my_id = std::this_thread::get_id();
+struct ReadLockCount
+{
+    unsigned long long mutex_id;
+    unsigned int count;
+};
 
-    std::unique_lock<decltype(mutex)> lock{mutex};
-    cv.wait(lock, [&]{
-        return !write_locking_thread.count ||
-            write_locking_thread.id == my_id; });
+// The read locks held by this thread. There are rarely more than a few,
+// so a linear search is cheaper than anything cleverer.
+thread_local std::vector<ReadLockCount> read_locks_held;
+
+auto read_lock_count_for(unsigned long long mutex_id) -> std::vector<ReadLockCount>::iterator
+{
+    return std::find_if(
+        read_locks_held.begin(),
+        read_locks_held.end(),
+        [mutex_id](ReadLockCount const& candidate) { return mutex_id == candidate.mutex_id; });
+}
 
-    auto const my_count = std::find_if(
-        read_locking_threads.begin(),
-        read_locking_threads.end(),
-        [my_id](ThreadLockCount const& candidate) { return my_id == candidate.id; });
+std::atomic<unsigned long long> next_mutex_id{0};
+}
 
-    if (my_count == read_locking_threads.end())
+mir::RecursiveReadWriteMutex::RecursiveReadWriteMutex() :
+    id{next_mutex_id.fetch_add(1, std::memory_order_relaxed)}
+{
+}
+
+void mir::RecursiveReadWriteMutex::read_lock()
+{
+    auto const my_count = read_lock_count_for(id);
+
+    if (my_count != read_locks_held.end())
     {
-        read_locking_threads.push_back(ThreadLockCount(my_id, 1U));
+        ++(my_count->count);
+        return;
     }
-    else
+
+    for (;;)
     {
-        ++(my_count->count);
+        reading_threads.fetch_add(1);
+
+        if (!writer.load() || write_locking_thread.load() == std::this_thread::get_id())
+            break;
+
+        // Back off until the writer has finished (or given up)
+        reading_threads.fetch_sub(1);
+
+        std::unique_lock<decltype(mutex)> lock{mutex};
+        readers_released.notify_all();
+        writer_released.wait(lock, [this]{ return !writer.load(); });
     }
+
+    read_locks_held.push_back(ReadLockCount{id, 1U});
 }
 
 void mir::RecursiveReadWriteMutex::read_unlock()
 {
-    auto const my_id = std::this_thread::get_id();
+    auto const my_count = read_lock_count_for(id);
 
-    std::lock_guard<decltype(mutex)> lock{mutex};
-    auto const my_count = std::find_if(
-        read_locking_threads.begin(),
-        read_locking_threads.end(),
-        [my_id](ThreadLockCount const& candidate) { return my_id == candidate.id; });
+    if (--(my_count->count))
+        return;
+
+    *my_count = read_locks_held.back();
+    read_locks_held.pop_back();
 
-    --(my_count->count);
+    reading_threads.fetch_sub(1);
 
-    cv.notify_all();
+    // Only a waiting writer is interested in readers leaving
+    if (waiting_writers.load())
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        readers_released.notify_all();
+    }
 }
 
 void mir::RecursiveReadWriteMutex::write_lock()
 {
     auto const my_id = std::this_thread::get_id();
 
+    if (write_locking_thread.load() == my_id)
+    {
+        ++write_lock_count;
+        return;
+    }
+
+    // A thread upgrading its own read lock only waits for the other readers
+    unsigned int const my_reads = read_lock_count_for(id) != read_locks_held.end() ? 1 : 0;
+
     std::unique_lock<decltype(mutex)> lock{mutex};
-    cv.wait(lock, [&]
-        {
-            if (write_locking_thread.count &&
-                write_locking_thread.id != my_id) return false;
-            for (auto const& candidate : read_locking_threads)
-            {
-                if (candidate.id != my_id && candidate.count != 0) return false;
-            }
-            return true;
-        });
-
-    ++write_locking_thread.count;
-    write_locking_thread.id = my_id;
+    waiting_writers.fetch_add(1);
+
+    for (;;)
+    {
+        writer_released.wait(lock, [this]{ return !writer.load(); });
+
+        writer.store(true);
+        if (reading_threads.load() == my_reads)
+            break;
+
+        // Other threads are reading: don't hold them (or an upgrading reader) off while we wait
+        writer.store(false);
+        writer_released.notify_all();
+        readers_released.wait(lock, [&]{ return reading_threads.load() == my_reads; });
+    }
+
+    waiting_writers.fetch_sub(1);
+    write_locking_thread.store(my_id);
+    write_lock_count = 1;
 }
 
 void mir::RecursiveReadWriteMutex::write_unlock()
 {
+    if (--write_lock_count)
+        return;
+
     std::lock_guard<decltype(mutex)> lock{mutex};
-    --write_locking_thread.count;
-    cv.notify_all();
+    write_locking_thread.store(std::thread::id{});
+    writer.store(false);
+    writer_released.notify_all();
 }
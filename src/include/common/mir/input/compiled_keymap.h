@@ -0,0 +1,84 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_INPUT_COMPILED_KEYMAP_H_
+#define MIR_INPUT_COMPILED_KEYMAP_H_
+
+#include "mir/fd.h"
+
+#include <memory>
+
+struct xkb_context;
+struct xkb_keymap;
+struct xkb_state;
+
+namespace mir
+{
+namespace input
+{
+class Keymap;
+
+using XKBStatePtr = std::unique_ptr<xkb_state, void(*)(xkb_state*)>;
+
+/**
+ * An XKB keymap compiled once for everything in the process using a matching Keymap
+ *
+ * The keymap text that Wayland clients are sent is kept in a sealed memfd, so
+ * that each wl_keyboard only needs to be sent a file descriptor.
+ *
+ * libxkbcommon's reference counting isn't thread safe, so the compiled keymap
+ * is only exposed through the states made by make_state(), which synchronise
+ * their references to it.
+ */
+class CompiledKeymap
+{
+public:
+    /// The compilation of \a keymap, shared with the other users of matching Keymaps
+    static auto of(std::shared_ptr<Keymap> const& keymap) -> std::shared_ptr<CompiledKeymap const>;
+
+    ~CompiledKeymap();
+
+    auto keymap() const -> std::shared_ptr<Keymap> const&;
+
+    /// A new state for the compiled keymap. The keymap itself is immutable, so states can be used on any thread.
+    auto make_state() const -> XKBStatePtr;
+
+    /**
+     * A read-only file description of the nul-terminated XKB_KEYMAP_FORMAT_TEXT_V1 keymap
+     *
+     * Each call opens a new file description, so that clients can't disturb
+     * each other's file offset.
+     */
+    auto text_fd() const -> Fd;
+    /// The size of the keymap text, including the nul terminator
+    auto text_size() const -> size_t;
+
+private:
+    CompiledKeymap(std::shared_ptr<Keymap> const& keymap);
+    CompiledKeymap(CompiledKeymap const&) = delete;
+    CompiledKeymap& operator=(CompiledKeymap const&) = delete;
+
+    std::shared_ptr<Keymap> const keymap_;
+    xkb_context* const context;
+    xkb_keymap* const compiled;
+    size_t text_size_;
+    Fd text;
+    bool text_sealed;
+};
+}
+}
+
+#endif // MIR_INPUT_COMPILED_KEYMAP_H_
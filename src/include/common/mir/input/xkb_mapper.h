@@ -23,6 +23,7 @@
 
 #include "mir/input/key_mapper.h"
 #include "mir/input/keymap.h"
+#include "mir/input/compiled_keymap.h"
 #include "mir/optional_value.h"
 
 #include <xkbcommon/xkbcommon.h>
@@ -39,7 +40,6 @@ namespace input
 using XKBContextPtr = std::unique_ptr<xkb_context, void(*)(xkb_context*)>;
 XKBContextPtr make_unique_context();
 
-using XKBStatePtr = std::unique_ptr<xkb_state, void(*)(xkb_state*)>;
 using XKBComposeTablePtr = std::unique_ptr<xkb_compose_table, void(*)(xkb_compose_table*)>;
 using XKBComposeStatePtr = std::unique_ptr<xkb_compose_state, void(*)(xkb_compose_state*)>;
 
@@ -83,7 +83,7 @@ private:
 
     struct XkbMappingState
     {
-        explicit XkbMappingState(std::shared_ptr<Keymap> keymap, std::shared_ptr<xkb_keymap> compiled_keymap);
+        explicit XkbMappingState(std::shared_ptr<Keymap> keymap, std::shared_ptr<CompiledKeymap const> compiled_keymap);
         void set_key_state(std::vector<uint32_t> const& key_state);
 
         bool update_and_map(MirEvent& event, ComposeState* compose_state);
@@ -94,7 +94,7 @@ private:
         void release_modifier(MirInputEventModifiers mod);
 
         std::shared_ptr<Keymap> const keymap;
-        std::shared_ptr<xkb_keymap> const compiled_keymap;
+        std::shared_ptr<CompiledKeymap const> const compiled_keymap;
         XKBStatePtr state;
         MirInputEventModifiers modifier_state{0};
     };
@@ -104,7 +104,7 @@ private:
 
     XKBContextPtr context;
     std::shared_ptr<Keymap> default_keymap;
-    std::shared_ptr<xkb_keymap> default_compiled_keymap;
+    std::shared_ptr<CompiledKeymap const> default_compiled_keymap;
     XKBComposeTablePtr compose_table;
 
     mir::optional_value<MirInputEventModifiers> modifier_state;
@@ -19,18 +19,30 @@
 #ifndef MIR_RECURSIVE_READ_WRITE_MUTEX_H_
 #define MIR_RECURSIVE_READ_WRITE_MUTEX_H_
 
+#include <atomic>
 #include <condition_variable>
 #include <thread>
-#include <vector>
 
 namespace mir
 {
 /** a recursive read-write mutex.
  * Note that a write lock can be acquired if no other threads have a read lock.
+ * A thread holding a read lock may take a write lock (once the other readers
+ * have finished).
+ *
+ * There is no writer preference: a writer waiting for readers to finish does
+ * not stop other threads taking new read locks, so a continuous stream of
+ * readers can delay a writer indefinitely.
+ *
+ * Taking an uncontended read lock touches only an atomic counter and a
+ * per-thread record of the read locks held; the internal mutex is only used
+ * when a reader or writer has to wait.
  */
 class RecursiveReadWriteMutex
 {
 public:
+    RecursiveReadWriteMutex();
+
     void read_lock();
 
     void read_unlock();
@@ -40,17 +52,21 @@ public:
     void write_unlock();
 
 private:
+    /// Identifies this mutex in the per-thread records (addresses get reused)
+    unsigned long long const id;
+
     std::mutex mutex;
-    std::condition_variable cv;
-    struct ThreadLockCount
-    {
-        ThreadLockCount() : id(), count(0) {}
-        ThreadLockCount(std::thread::id id, unsigned int count) : id(id), count(count) {}
-        std::thread::id id;
-        unsigned int count;
-    };
-    std::vector<ThreadLockCount> read_locking_threads;
-    ThreadLockCount write_locking_thread;
+    std::condition_variable writer_released;
+    std::condition_variable readers_released;
+
+    /// Threads holding at least one read lock (recursive locks are counted per-thread)
+    std::atomic<unsigned int> reading_threads{0};
+    /// Set while a writer holds, or is trying to take, the lock
+    std::atomic<bool> writer{false};
+    /// Writers waiting for readers to release the lock
+    std::atomic<unsigned int> waiting_writers{0};
+    std::atomic<std::thread::id> write_locking_thread{std::thread::id{}};
+    unsigned int write_lock_count{0};
 };
 
 class RecursiveReadLock
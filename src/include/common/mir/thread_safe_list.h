@@ -22,8 +22,11 @@
 
 #include "mir/recursive_read_write_mutex.h"
 
-#include <atomic>
+#include <algorithm>
 #include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace mir
 {
@@ -45,6 +48,15 @@ namespace mir
  *    - Element{}: value initialization should create an invalid element
  */
 
+/*
+ * The items are held in an immutable vector that is replaced (copy-on-write)
+ * by add() and the removal functions. for_each() iterates over whichever
+ * vector is current, holding the list-wide items_mutex only for as long as
+ * it takes to copy the pointer to it, so a callback can add or remove
+ * elements. The per-item lock only guarantees that, once remove() returns,
+ * no other thread is still calling (or will later call) the function for the
+ * removed element.
+ */
 template<class Element>
 class ThreadSafeList
 {
@@ -58,128 +70,149 @@ public:
 private:
     struct ListItem
     {
-        ListItem() {}
+        explicit ListItem(Element const& element) : element{element} {}
         RecursiveReadWriteMutex mutex;
-        Element element{};
-        std::atomic<ListItem*> next{nullptr};
+        Element element;
+    };
+
+    using Items = std::vector<std::shared_ptr<ListItem>>;
 
-        ~ListItem() { delete next.load(); }
-    } head;
+    auto current_items() const -> std::shared_ptr<Items const>;
+    void replace_items(std::shared_ptr<Items const> updated);
+    void erase(std::vector<std::shared_ptr<ListItem>> const& removed);
+
+    std::mutex mutable update_mutex;    ///< Serialises add() and erase()
+    std::mutex mutable items_mutex;     ///< Guards the items pointer itself
+    std::shared_ptr<Items const> items{std::make_shared<Items const>()};
 };
 
 template<class Element>
-void ThreadSafeList<Element>::for_each(
-    std::function<void(Element const& element)> const& f)
+auto ThreadSafeList<Element>::current_items() const -> std::shared_ptr<Items const>
 {
-    ListItem* current_item = &head;
+    std::lock_guard<decltype(items_mutex)> lock{items_mutex};
+    return items;
+}
 
-    while (current_item)
+template<class Element>
+void ThreadSafeList<Element>::replace_items(std::shared_ptr<Items const> updated)
+{
     {
-        RecursiveReadLock lock{current_item->mutex};
+        std::lock_guard<decltype(items_mutex)> lock{items_mutex};
+        std::swap(items, updated);
+    }
+    // updated now holds the old items, which may be released here outside the lock
+}
 
-        // We need to take a copy in case we recursively remove during call
-        if (auto const copy_of_element = current_item->element) f(copy_of_element);
+template<class Element>
+void ThreadSafeList<Element>::erase(std::vector<std::shared_ptr<ListItem>> const& removed)
+{
+    std::lock_guard<decltype(update_mutex)> lock{update_mutex};
+
+    auto updated = std::make_shared<Items>();
+    updated->reserve(items->size());
 
-        current_item = current_item->next;
+    for (auto const& item : *items)
+    {
+        if (std::find(removed.begin(), removed.end(), item) == removed.end())
+            updated->push_back(item);
     }
+
+    replace_items(std::move(updated));
 }
 
 template<class Element>
-void ThreadSafeList<Element>::add(Element const& element)
+void ThreadSafeList<Element>::for_each(
+    std::function<void(Element const& element)> const& f)
 {
-    ListItem* current_item = &head;
+    auto const snapshot = current_items();
 
-    do
+    for (auto const& item : *snapshot)
     {
-        // Note: we release the read lock to avoid two threads calling add at
-        // the same time mutually blocking the other's upgrade to write lock.
-        {
-            RecursiveReadLock lock{current_item->mutex};
-            if (current_item->element) continue;
-        }
+        RecursiveReadLock lock{item->mutex};
 
-        RecursiveWriteLock lock{current_item->mutex};
-
-        if (!current_item->element)
-        {
-            current_item->element = element;
-            return;
-        }
+        // We need to take a copy in case we recursively remove during call
+        if (auto const copy_of_element = item->element) f(copy_of_element);
     }
-    while (current_item->next && (current_item = current_item->next));
+}
 
-    // No empty Items so append a new one
-    auto new_item = new ListItem;
-    new_item->element = element;
+template<class Element>
+void ThreadSafeList<Element>::add(Element const& element)
+{
+    auto const new_item = std::make_shared<ListItem>(element);
 
-    for (ListItem* expected{nullptr};
-        !current_item->next.compare_exchange_weak(expected, new_item);
-        expected = nullptr)
-    {
-        if (expected) current_item = expected;
-    }
+    std::lock_guard<decltype(update_mutex)> lock{update_mutex};
+
+    auto updated = std::make_shared<Items>();
+    updated->reserve(items->size() + 1);
+    *updated = *items;
+    updated->push_back(new_item);
+
+    replace_items(std::move(updated));
 }
 
 template<class Element>
 void ThreadSafeList<Element>::remove(Element const& element)
 {
-    ListItem* current_item = &head;
+    auto const snapshot = current_items();
 
-    do
+    for (auto const& item : *snapshot)
     {
         {
-            RecursiveReadLock lock{current_item->mutex};
-            if (current_item->element != element) continue;
+            RecursiveReadLock lock{item->mutex};
+            if (item->element != element) continue;
         }
 
-        RecursiveWriteLock lock{current_item->mutex};
-
-        if (current_item->element == element)
         {
-            current_item->element = Element{};
-            return;
+            RecursiveWriteLock lock{item->mutex};
+            if (item->element != element) continue;
+            item->element = Element{};
         }
+
+        erase({item});
+        return;
     }
-    while ((current_item = current_item->next));
 }
 
 template<class Element>
 unsigned int ThreadSafeList<Element>::remove_all(Element const& element)
 {
-    ListItem* current_item = &head;
-    auto removed = 0u;
+    auto const snapshot = current_items();
+    std::vector<std::shared_ptr<ListItem>> removed;
 
-    do
+    for (auto const& item : *snapshot)
     {
         {
-            RecursiveReadLock lock{current_item->mutex};
-            if (current_item->element != element) continue;
+            RecursiveReadLock lock{item->mutex};
+            if (item->element != element) continue;
         }
 
-        RecursiveWriteLock lock{current_item->mutex};
+        RecursiveWriteLock lock{item->mutex};
 
-        if (current_item->element == element)
+        if (item->element == element)
         {
-            current_item->element = Element{};
-            ++removed;
+            item->element = Element{};
+            removed.push_back(item);
         }
     }
-    while ((current_item = current_item->next));
 
-    return removed;
+    if (!removed.empty())
+        erase(removed);
+
+    return removed.size();
 }
 
 template<class Element>
 void ThreadSafeList<Element>::clear()
 {
-    ListItem* current_item = &head;
+    auto const snapshot = current_items();
 
-    do
+    for (auto const& item : *snapshot)
     {
-        RecursiveWriteLock lock{current_item->mutex};
-        current_item->element = Element{};
+        RecursiveWriteLock lock{item->mutex};
+        item->element = Element{};
     }
-    while ((current_item = current_item->next));
+
+    erase(*snapshot);
 }
 
 }
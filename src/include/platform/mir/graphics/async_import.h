@@ -0,0 +1,70 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_ASYNC_IMPORT_H_
+#define MIR_GRAPHICS_ASYNC_IMPORT_H_
+
+#include "mir/executor.h"
+#include "mir/wayland/wayland_base.h"
+
+#include <functional>
+#include <memory>
+
+namespace mir
+{
+namespace graphics
+{
+/**
+ * Run \a import on \a egl_delegate's thread, then \a report its result on the Wayland thread
+ *
+ * This keeps (potentially slow) driver work off the Wayland thread for requests that
+ * answer with an event. The client may destroy \a requester while the import is
+ * running; \a report is then not called, as there is no-one left to tell.
+ *
+ * \param import    [in] Returns whether the import succeeded. It runs with a current
+ *                       EGL context, and must not touch \a requester.
+ * \param report    [in] Called with the live \a requester and the result of \a import
+ */
+template<typename Requester>
+void async_import(
+    Executor& egl_delegate,
+    std::shared_ptr<Executor> wayland_executor,
+    wayland::Weak<Requester> requester,
+    std::function<bool()> import,
+    std::function<void(Requester&, bool)> report)
+{
+    egl_delegate.spawn(
+        [wayland_executor = std::move(wayland_executor),
+         requester = std::move(requester),
+         import = std::move(import),
+         report = std::move(report)]()
+        {
+            auto const imported = import();
+
+            wayland_executor->spawn(
+                [requester, imported, report]()
+                {
+                    if (requester)
+                    {
+                        report(requester.value(), imported);
+                    }
+                });
+        });
+}
+}
+}
+
+#endif // MIR_GRAPHICS_ASYNC_IMPORT_H_
@@ -0,0 +1,90 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_BACKGROUND_GL_WORK_H_
+#define MIR_GRAPHICS_BACKGROUND_GL_WORK_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace mir
+{
+namespace graphics
+{
+/**
+ * GL work that is started on the EGL delegate thread, but may be needed sooner
+ *
+ * Buffers use this to get their texture ready before the compositor draws them.
+ * Whichever of run_in_background() and ensure_done() gets there first does the
+ * work; the other waits for it to finish, or has nothing left to do.
+ */
+class BackgroundGLWork
+{
+public:
+    BackgroundGLWork() = default;
+
+    /**
+     * Run \a work, unless it has been started already, and wait for its GL commands to complete
+     *
+     * If \a work throws it is left to a later ensure_done() to try again.
+     *
+     * \note    This must be called with a current GL context
+     * \throws  Whatever \a work throws
+     */
+    void run_in_background(std::function<void()> const& work);
+
+    /**
+     * Wait for \a work to finish if it is running; run it here if it hasn't started yet
+     *
+     * \note    This must be called with a current GL context
+     * \throws  Whatever \a work throws
+     */
+    void ensure_done(std::function<void()> const& work);
+
+    /**
+     * Call \a callback once the work has been attempted: immediately if it already has been,
+     * otherwise on whichever thread finishes the attempt
+     *
+     * \a callback is also called if run_in_background() fails, as ensure_done() will then try again.
+     */
+    void when_done(std::function<void()>&& callback);
+
+private:
+    BackgroundGLWork(BackgroundGLWork const&) = delete;
+    BackgroundGLWork& operator=(BackgroundGLWork const&) = delete;
+
+    enum class State
+    {
+        pending,
+        in_progress,
+        done
+    };
+
+    /// Marks the work as attempted, returning the callbacks that were waiting for that
+    auto attempted_locked(std::unique_lock<std::mutex> const&) -> std::vector<std::function<void()>>;
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    State state{State::pending};
+    bool attempted{false};
+    std::vector<std::function<void()>> on_attempted;
+};
+}
+}
+
+#endif // MIR_GRAPHICS_BACKGROUND_GL_WORK_H_
@@ -0,0 +1,55 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_PREPARED_IN_BACKGROUND_H_
+#define MIR_GRAPHICS_PREPARED_IN_BACKGROUND_H_
+
+#include <functional>
+
+namespace mir
+{
+namespace graphics
+{
+/**
+ * A Buffer whose content is made ready to draw on another thread
+ *
+ * wl_shm buffers, for example, are uploaded to a texture on the EGL delegate thread.
+ * Drawing such a buffer before it is ready makes the compositor wait for, or do, that
+ * work at frame time, so streams hold it back and keep showing the previous buffer.
+ */
+class PreparedInBackground
+{
+public:
+    virtual ~PreparedInBackground() = default;
+
+    /**
+     * Call \a on_ready once the buffer can be drawn without waiting
+     *
+     * This is immediately if it already can be, otherwise on the thread that prepares it.
+     * \a on_ready is also called if preparing it fails, as drawing then falls back to
+     * preparing it on the compositor thread.
+     */
+    virtual void when_ready(std::function<void()>&& on_ready) = 0;
+
+protected:
+    PreparedInBackground() = default;
+    PreparedInBackground(PreparedInBackground const&) = delete;
+    PreparedInBackground& operator=(PreparedInBackground const&) = delete;
+};
+}
+}
+
+#endif // MIR_GRAPHICS_PREPARED_IN_BACKGROUND_H_
@@ -21,6 +21,10 @@
 
 namespace mir
 {
+namespace graphics
+{
+class DisplaySyncGroup;
+}
 namespace compositor
 {
 
@@ -32,6 +36,28 @@ public:
     virtual void start() = 0;
     virtual void stop() = 0;
 
+    /**
+     * Stops compositing to a display sync group that is about to be destroyed.
+     *
+     * Compositors that can leave the other groups unaffected should override this;
+     * by default compositing to every group is stopped.
+     */
+    virtual void stop_compositing_to(graphics::DisplaySyncGroup const& /*group*/)
+    {
+        stop();
+    }
+
+    /**
+     * Starts compositing to display sync groups that are not yet being composited to.
+     *
+     * By default this restarts compositing to every group, matching the default
+     * stop_compositing_to().
+     */
+    virtual void start_compositing_to_new_groups()
+    {
+        start();
+    }
+
 protected:
     Compositor() = default;
     Compositor(Compositor const&) = delete;
@@ -0,0 +1,58 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_COMPOSITOR_INPUT_LATENCY_REPORT_H_
+#define MIR_COMPOSITOR_INPUT_LATENCY_REPORT_H_
+
+#include "mir/graphics/buffer_id.h"
+#include "mir/graphics/renderable.h"
+
+#include <chrono>
+
+namespace mir
+{
+namespace compositor
+{
+
+/// Correlates input events with the frame that first shows a client's response to them.
+///
+/// The frontend tags buffers committed in response to input with the time of that input, the compositor
+/// reports which buffers went into each frame and when that frame was posted to the display.
+class InputLatencyReport
+{
+public:
+    typedef const void* SurfaceId;        // e.g. the frontend surface
+    typedef const void* SubCompositorId;  // e.g. display buffer
+
+    /// A client committed \a buffer to \a surface after being sent input with the (CLOCK_MONOTONIC) \a input_time
+    virtual void buffer_committed(SurfaceId surface, graphics::BufferID buffer, std::chrono::nanoseconds input_time) = 0;
+    virtual void surface_destroyed(SurfaceId surface) = 0;
+
+    /// The renderables that the next frame posted by \a id will show
+    virtual void renderables_in_frame(SubCompositorId id, graphics::RenderableList const& renderables) = 0;
+    virtual void frame_posted(SubCompositorId id) = 0;
+
+protected:
+    InputLatencyReport() = default;
+    virtual ~InputLatencyReport() = default;
+    InputLatencyReport(InputLatencyReport const&) = delete;
+    InputLatencyReport& operator=(InputLatencyReport const&) = delete;
+};
+
+}
+}
+
+#endif // MIR_COMPOSITOR_INPUT_LATENCY_REPORT_H_
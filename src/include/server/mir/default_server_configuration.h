@@ -56,6 +56,7 @@ class Drawer;
 class DisplayBufferCompositorFactory;
 class Compositor;
 class CompositorReport;
+class InputLatencyReport;
 }
 namespace frontend
 {
@@ -242,6 +243,7 @@ public:
      * configurable interfaces for modifying compositor
      *  @{ */
     virtual std::shared_ptr<compositor::CompositorReport> the_compositor_report();
+    virtual std::shared_ptr<compositor::InputLatencyReport> the_input_latency_report();
     virtual std::shared_ptr<compositor::DisplayBufferCompositorFactory> the_display_buffer_compositor_factory();
     virtual std::shared_ptr<compositor::DisplayBufferCompositorFactory> wrap_display_buffer_compositor_factory(
         std::shared_ptr<compositor::DisplayBufferCompositorFactory> const& wrapped);
@@ -416,6 +418,7 @@ protected:
     CachedPtr<compositor::DisplayBufferCompositorFactory> display_buffer_compositor_factory;
     CachedPtr<compositor::Compositor> compositor;
     CachedPtr<compositor::CompositorReport> compositor_report;
+    CachedPtr<compositor::InputLatencyReport> input_latency_report;
     CachedPtr<logging::Logger> logger;
     CachedPtr<graphics::DisplayReport> display_report;
     CachedPtr<time::Clock> clock;
@@ -466,6 +469,10 @@ private:
     // Helpers for platform library loading
     std::vector<std::shared_ptr<mir::SharedLibrary>> platform_libraries;
     auto the_platform_libaries() -> std::vector<std::shared_ptr<mir::SharedLibrary>> const&;
+    // Everything on the platform path, shared by display and rendering platform selection
+    std::vector<std::shared_ptr<mir::SharedLibrary>> platform_candidates;
+    auto the_platform_candidates() -> std::vector<std::shared_ptr<mir::SharedLibrary>> const&;
+    void release_unused_platform_candidates();
 
     std::vector<std::shared_ptr<graphics::DisplayPlatform>> display_platforms;
     std::vector<std::shared_ptr<graphics::RenderingPlatform>> rendering_platforms;
@@ -167,6 +167,7 @@ private:
     std::atomic<bool> running_;
     detail::FdSources fd_sources;
     detail::SignalSources signal_sources;
+    detail::ServerActionQueue server_actions;
     std::mutex do_not_process_mutex;
     std::vector<void const*> do_not_process;
     std::mutex run_on_halt_mutex;
@@ -25,6 +25,7 @@
 
 #include <functional>
 #include <vector>
+#include <deque>
 #include <mutex>
 #include <memory>
 #include <unordered_map>
@@ -67,12 +68,6 @@ private:
 void add_idle_gsource(
     GMainContext* main_context, int priority, std::function<void()> const& callback);
 
-void add_server_action_gsource(
-    GMainContext* main_context,
-    void const* owner,
-    std::function<void()> const& action,
-    std::function<bool(void const*)> const& should_dispatch);
-
 GSourceHandle add_timer_gsource(
     GMainContext* main_context,
     std::shared_ptr<time::Clock> const& clock,
@@ -98,6 +93,38 @@ private:
     std::vector<std::unique_ptr<FdSource>> sources;
 };
 
+class ServerActionQueue
+{
+public:
+    ServerActionQueue(GMainContext* main_context, std::function<bool(void const*)> const& should_dispatch);
+    ~ServerActionQueue();
+
+    /// Queue an action that is held while should_dispatch(owner) is false
+    void enqueue(void const* owner, std::function<void()> const& action);
+    /// Queue an action that is never held
+    void spawn(std::function<void()> const& action);
+
+private:
+    struct Source;
+    struct Action
+    {
+        void const* owner;
+        bool pausable;
+        std::function<void()> action;
+    };
+
+    void add(Action&& action);
+    bool has_dispatchable_action();
+    void dispatch();
+
+    GMainContext* const main_context;
+    std::function<bool(void const*)> const should_dispatch;
+    std::mutex actions_mutex;
+    std::deque<Action> actions;
+    bool wakeup_pending{false};
+    GSourceHandle gsource;
+};
+
 class SignalSources
 {
 public:
@@ -25,6 +25,10 @@
 
 namespace mir
 {
+namespace geometry
+{
+struct Rectangle;
+}
 namespace scene
 {
 class Observer;
@@ -59,6 +63,10 @@ public:
     // TODO: How can something like SurfaceObserver be adapted to work with non surface renderables?
     virtual void emit_scene_changed() = 0;
 
+    // As emit_scene_changed(), but only the area covered by \a damage needs recomposition
+    // (e.g. the old and new positions of an input visualization that moved).
+    virtual void emit_scene_damaged(geometry::Rectangle const& damage) = 0;
+
 protected:
     Scene() = default;
     Scene(Scene const&) = delete;
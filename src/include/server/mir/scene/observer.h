@@ -24,6 +24,10 @@
 
 namespace mir
 {
+namespace geometry
+{
+struct Rectangle;
+}
 namespace scene
 {
 class Surface;
@@ -51,6 +55,10 @@ public:
     /// and will require full recomposition.
     virtual void scene_changed() = 0;
 
+    /// Used to indicate something beyond the present surfaces has changed within
+    /// \a damage (e.g. a software cursor moved) and only that area needs recomposition.
+    virtual void scene_damaged(geometry::Rectangle const& damage) = 0;
+
     /// Called at observer registration to notify of already existing surfaces.
     virtual void surface_exists(std::shared_ptr<Surface> const& surface) = 0;
 
@@ -0,0 +1,112 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/background_gl_work.h"
+
+#include <GLES2/gl2.h>
+
+namespace mg = mir::graphics;
+
+void mg::BackgroundGLWork::run_in_background(std::function<void()> const& work)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (state != State::pending)
+        {
+            return;
+        }
+        state = State::in_progress;
+    }
+
+    try
+    {
+        work();
+        /* Other contexts only see the results once our commands have completed;
+         * waiting here means ensure_done() never has to wait on the GPU itself.
+         */
+        glFinish();
+    }
+    catch (...)
+    {
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            state = State::pending;
+            callbacks = attempted_locked(lock);
+        }
+        finished.notify_all();
+        for (auto const& callback : callbacks)
+        {
+            callback();
+        }
+        throw;
+    }
+
+    std::vector<std::function<void()>> callbacks;
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        state = State::done;
+        callbacks = attempted_locked(lock);
+    }
+    finished.notify_all();
+    for (auto const& callback : callbacks)
+    {
+        callback();
+    }
+}
+
+void mg::BackgroundGLWork::ensure_done(std::function<void()> const& work)
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    finished.wait(lock, [this]() { return state != State::in_progress; });
+
+    if (state == State::pending)
+    {
+        // Doing the work here is quicker than waiting for the background thread to get to it
+        work();
+        state = State::done;
+    }
+
+    auto const callbacks = attempted_locked(lock);
+    lock.unlock();
+    for (auto const& callback : callbacks)
+    {
+        callback();
+    }
+}
+
+void mg::BackgroundGLWork::when_done(std::function<void()>&& callback)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (!attempted)
+        {
+            on_attempted.push_back(std::move(callback));
+            return;
+        }
+    }
+
+    callback();
+}
+
+auto mg::BackgroundGLWork::attempted_locked(std::unique_lock<std::mutex> const&) -> std::vector<std::function<void()>>
+{
+    attempted = true;
+
+    std::vector<std::function<void()>> callbacks;
+    callbacks.swap(on_attempted);
+    return callbacks;
+}
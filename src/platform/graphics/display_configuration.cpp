@@ -133,6 +133,12 @@ std::ostream& mg::operator<<(std::ostream& out, mg::DisplayConfigurationOutput c
     out << std::endl;
 
     out << "\torientation: " << val.orientation << '\n';
+    out << "\tadaptive sync: ";
+    if (val.adaptive_sync_capable)
+        out << (val.adaptive_sync ? "enabled" : "disabled");
+    else
+        out << "not supported";
+    out << std::endl;
     out << "}" << std::endl;
 
     return out;
@@ -188,6 +194,8 @@ bool mg::operator==(mg::DisplayConfigurationOutput const& val1,
                (val1.current_mode_index == val2.current_mode_index) &&
                (val1.modes.size() == val2.modes.size()) &&
                (val1.custom_logical_size == val2.custom_logical_size) &&
+               (val1.adaptive_sync_capable == val2.adaptive_sync_capable) &&
+               (val1.adaptive_sync == val2.adaptive_sync) &&
                (val1.scale == val2.scale) &&
                (val1.form_factor == val2.form_factor)};
 
@@ -331,7 +339,9 @@ mg::UserDisplayConfigurationOutput::UserDisplayConfigurationOutput(
         gamma(master.gamma),
         gamma_supported(master.gamma_supported),
         edid(*reinterpret_cast<std::vector<uint8_t const>*>(&master.edid)),
-        custom_logical_size(master.custom_logical_size)
+        custom_logical_size(master.custom_logical_size),
+        adaptive_sync_capable(master.adaptive_sync_capable),
+        adaptive_sync(master.adaptive_sync)
 {
 }
 
@@ -23,12 +23,13 @@
 #include "wayland_wrapper.h"
 #include "mir/graphics/egl_extensions.h"
 #include "mir/graphics/egl_error.h"
-#include "mir/renderer/gl/context.h"
 #include "mir/graphics/texture.h"
 #include "mir/graphics/program_factory.h"
 #include "mir/graphics/buffer.h"
 #include "mir/graphics/buffer_basic.h"
 #include "mir/graphics/dmabuf_buffer.h"
+#include "mir/graphics/async_import.h"
+#include "mir/graphics/background_gl_work.h"
 #include "mir/executor.h"
 
 #define MIR_LOG_COMPONENT "linux-dmabuf-import"
@@ -369,17 +370,131 @@ BufferGLDescription const ExternalOES = {
     "}\n"
 };
 
+struct EGLPlaneAttribs
+{
+    EGLint fd;
+    EGLint offset;
+    EGLint pitch;
+    EGLint modifier_lo;
+    EGLint modifier_hi;
+};
+
+constexpr std::array<EGLPlaneAttribs, 4> egl_attribs = {
+    EGLPlaneAttribs {
+        EGL_DMA_BUF_PLANE0_FD_EXT,
+        EGL_DMA_BUF_PLANE0_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE0_PITCH_EXT,
+        EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT
+    },
+    EGLPlaneAttribs {
+        EGL_DMA_BUF_PLANE1_FD_EXT,
+        EGL_DMA_BUF_PLANE1_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE1_PITCH_EXT,
+        EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT
+    },
+    EGLPlaneAttribs {
+        EGL_DMA_BUF_PLANE2_FD_EXT,
+        EGL_DMA_BUF_PLANE2_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE2_PITCH_EXT,
+        EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT
+    },
+    EGLPlaneAttribs {
+        EGL_DMA_BUF_PLANE3_FD_EXT,
+        EGL_DMA_BUF_PLANE3_OFFSET_EXT,
+        EGL_DMA_BUF_PLANE3_PITCH_EXT,
+        EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
+        EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT
+    }
+};
+
+}
+
+auto mg::import_dmabuf_egl_image(
+    EGLDisplay dpy,
+    EGLExtensions const& egl_extensions,
+    geom::Size size,
+    uint32_t format,
+    std::optional<uint64_t> modifier,
+    std::vector<DMABufBuffer::PlaneDescriptor> const& planes) -> EGLImageKHR
+{
+    std::vector<EGLint> attributes;
+
+    attributes.push_back(EGL_WIDTH);
+    attributes.push_back(size.width.as_int());
+    attributes.push_back(EGL_HEIGHT);
+    attributes.push_back(size.height.as_int());
+    attributes.push_back(EGL_LINUX_DRM_FOURCC_EXT);
+    attributes.push_back(format);
+
+    for(auto i = 0u; i < planes.size(); ++i)
+    {
+        auto const& attrib_names = egl_attribs[i];
+        auto const& plane = planes[i];
+
+        attributes.push_back(attrib_names.fd);
+        attributes.push_back(static_cast<int>(plane.dma_buf));
+        attributes.push_back(attrib_names.offset);
+        attributes.push_back(plane.offset);
+        attributes.push_back(attrib_names.pitch);
+        attributes.push_back(plane.stride);
+        if (modifier && *modifier != DRM_FORMAT_MOD_INVALID)
+        {
+            attributes.push_back(attrib_names.modifier_lo);
+            attributes.push_back(*modifier & 0xFFFFFFFF);
+            attributes.push_back(attrib_names.modifier_hi);
+            attributes.push_back(*modifier >> 32);
+        }
+    }
+    attributes.push_back(EGL_NONE);
+
+    auto const image = egl_extensions.base(dpy).eglCreateImageKHR(
+        dpy,
+        EGL_NO_CONTEXT,
+        EGL_LINUX_DMA_BUF_EXT,
+        nullptr,
+        attributes.data());
+
+    if (image == EGL_NO_IMAGE_KHR)
+    {
+        auto const msg = planes.size() > 1 ?
+            "Failed to import supplied dmabufs" :
+            "Failed to import supplied dmabuf";
+        BOOST_THROW_EXCEPTION((mg::egl_error(msg)));
+    }
+
+    return image;
+}
+
+namespace
+{
+/// Checks that EGL can import the dmabufs, without keeping the result
+void validate_import(
+    EGLDisplay dpy,
+    mg::EGLExtensions const& egl_extensions,
+    geom::Size size,
+    uint32_t format,
+    uint64_t modifier,
+    std::vector<PlaneInfo> const& planes)
+{
+    auto const image = mg::import_dmabuf_egl_image(dpy, egl_extensions, size, format, modifier, planes);
+    egl_extensions.base(dpy).eglDestroyImageKHR(dpy, image);
+}
+
 /**
  * Holds on to all imported dmabuf buffers, and allows looking up by wl_buffer
  *
+ * The dmabufs have already been validated by importing them into EGL; they are
+ * imported again each time the buffer is committed.
+ *
  * \note This is not threadsafe, and should only be accessed on the Wayland thread
  */
 class WlDmaBufBuffer : public mir::wayland::Buffer
 {
 public:
     WlDmaBufBuffer(
-        EGLDisplay dpy,
-        std::shared_ptr<mg::EGLExtensions> egl_extensions,
         BufferGLDescription const& desc,
         wl_resource* wl_buffer,
         int32_t width,
@@ -389,26 +504,14 @@ public:
         uint64_t modifier,
         std::vector<PlaneInfo> plane_params)
             : Buffer(wl_buffer, Version<1>{}),
-              dpy{dpy},
-              egl_extensions{std::move(egl_extensions)},
               desc{desc},
               width{width},
               height{height},
               format_{format},
               flags{flags},
               modifier_{modifier},
-              planes_{std::move(plane_params)},
-              image{EGL_NO_IMAGE_KHR}
-    {
-        reimport_egl_image();
-    }
-
-    ~WlDmaBufBuffer()
+              planes_{std::move(plane_params)}
     {
-        if (image != EGL_NO_IMAGE_KHR)
-        {
-            egl_extensions->base(dpy).eglDestroyImageKHR(dpy, image);
-        }
     }
 
     static auto maybe_dmabuf_from_wl_buffer(wl_resource* buffer) -> WlDmaBufBuffer*
@@ -442,67 +545,6 @@ public:
     {
         return desc;
     }
-    /**
-     * Reimport dmabufs into EGL
-     *
-     * This is necessary to call each time the buffer is re-submitted by the client,
-     * to ensure any state is properly synchronised.
-     *
-     * \return  An EGLImageKHR handle to the imported
-     * \throws  A std::system_error containing the EGL error on failure.
-     */
-    auto reimport_egl_image() -> EGLImageKHR
-    {
-        std::vector<EGLint> attributes;
-
-        attributes.push_back(EGL_WIDTH);
-        attributes.push_back(width);
-        attributes.push_back(EGL_HEIGHT);
-        attributes.push_back(height);
-        attributes.push_back(EGL_LINUX_DRM_FOURCC_EXT);
-        attributes.push_back(format());
-
-        for(auto i = 0u; i < planes_.size(); ++i)
-        {
-            auto const& attrib_names = egl_attribs[i];
-            auto const& plane = planes()[i];
-
-            attributes.push_back(attrib_names.fd);
-            attributes.push_back(static_cast<int>(plane.dma_buf));
-            attributes.push_back(attrib_names.offset);
-            attributes.push_back(plane.offset);
-            attributes.push_back(attrib_names.pitch);
-            attributes.push_back(plane.stride);
-            if (modifier() != DRM_FORMAT_MOD_INVALID)
-            {
-                attributes.push_back(attrib_names.modifier_lo);
-                attributes.push_back(modifier() & 0xFFFFFFFF);
-                attributes.push_back(attrib_names.modifier_hi);
-                attributes.push_back(modifier() >> 32);
-            }
-        }
-        attributes.push_back(EGL_NONE);
-        if (image != EGL_NO_IMAGE_KHR)
-        {
-            egl_extensions->base(dpy).eglDestroyImageKHR(dpy, image);
-        }
-        image = egl_extensions->base(dpy).eglCreateImageKHR(
-            dpy,
-            EGL_NO_CONTEXT,
-            EGL_LINUX_DMA_BUF_EXT,
-            nullptr,
-            attributes.data());
-
-        if (image == EGL_NO_IMAGE_KHR)
-        {
-            auto const msg = planes_.size() > 1 ?
-                "Failed to import supplied dmabufs" :
-                "Failed to import supplied dmabuf";
-            BOOST_THROW_EXCEPTION((mg::egl_error(msg)));
-        }
-
-        return image;
-    }
 
     auto modifier() -> uint64_t
     {
@@ -514,54 +556,12 @@ public:
         return planes_;
     }
 private:
-    EGLDisplay const dpy;
-    std::shared_ptr<mg::EGLExtensions> const egl_extensions;
     BufferGLDescription const& desc;
     int32_t const width, height;
     uint32_t const format_;
     uint32_t const flags;
     uint64_t const modifier_;
     std::vector<PlaneInfo> const planes_;
-    EGLImageKHR image;
-
-    struct EGLPlaneAttribs
-    {
-        EGLint fd;
-        EGLint offset;
-        EGLint pitch;
-        EGLint modifier_lo;
-        EGLint modifier_hi;
-    };
-    static constexpr std::array<EGLPlaneAttribs, 4> egl_attribs = {
-        EGLPlaneAttribs {
-            EGL_DMA_BUF_PLANE0_FD_EXT,
-            EGL_DMA_BUF_PLANE0_OFFSET_EXT,
-            EGL_DMA_BUF_PLANE0_PITCH_EXT,
-            EGL_DMA_BUF_PLANE0_MODIFIER_LO_EXT,
-            EGL_DMA_BUF_PLANE0_MODIFIER_HI_EXT
-        },
-        EGLPlaneAttribs {
-            EGL_DMA_BUF_PLANE1_FD_EXT,
-            EGL_DMA_BUF_PLANE1_OFFSET_EXT,
-            EGL_DMA_BUF_PLANE1_PITCH_EXT,
-            EGL_DMA_BUF_PLANE1_MODIFIER_LO_EXT,
-            EGL_DMA_BUF_PLANE1_MODIFIER_HI_EXT
-        },
-        EGLPlaneAttribs {
-            EGL_DMA_BUF_PLANE2_FD_EXT,
-            EGL_DMA_BUF_PLANE2_OFFSET_EXT,
-            EGL_DMA_BUF_PLANE2_PITCH_EXT,
-            EGL_DMA_BUF_PLANE2_MODIFIER_LO_EXT,
-            EGL_DMA_BUF_PLANE2_MODIFIER_HI_EXT
-        },
-        EGLPlaneAttribs {
-            EGL_DMA_BUF_PLANE3_FD_EXT,
-            EGL_DMA_BUF_PLANE3_OFFSET_EXT,
-            EGL_DMA_BUF_PLANE3_PITCH_EXT,
-            EGL_DMA_BUF_PLANE3_MODIFIER_LO_EXT,
-            EGL_DMA_BUF_PLANE3_MODIFIER_HI_EXT
-        }
-    };
 };
 
 class LinuxDmaBufParams : public mir::wayland::LinuxBufferParamsV1
@@ -571,12 +571,16 @@ public:
         wl_resource* new_resource,
         EGLDisplay dpy,
         std::shared_ptr<mg::EGLExtensions> egl_extensions,
-        std::shared_ptr<mg::DmaBufFormatDescriptors const> formats)
+        std::shared_ptr<mg::DmaBufFormatDescriptors const> formats,
+        std::shared_ptr<mir::Executor> wayland_executor,
+        std::shared_ptr<mir::Executor> egl_delegate)
         : mir::wayland::LinuxBufferParamsV1(new_resource, Version<3>{}),
           consumed{false},
           dpy{dpy},
           egl_extensions{std::move(egl_extensions)},
-          formats{std::move(formats)}
+          formats{std::move(formats)},
+          wayland_executor{std::move(wayland_executor)},
+          egl_delegate{std::move(egl_delegate)}
     {
     }
 
@@ -590,6 +594,8 @@ private:
     EGLDisplay dpy;
     std::shared_ptr<mg::EGLExtensions> egl_extensions;
     std::shared_ptr<mg::DmaBufFormatDescriptors const> const formats;
+    std::shared_ptr<mir::Executor> const wayland_executor;
+    std::shared_ptr<mir::Executor> const egl_delegate;
 
     void add(
         mir::Fd fd,
@@ -750,48 +756,88 @@ private:
                 static_cast<uint32_t>(requested_modifier & 0xFFFFFFFF)}));
     }
 
+    /**
+     * Protocol checks happen here, but the (potentially slow) EGL import that checks
+     * the driver can use the dmabufs happens on the EGL delegate thread. The created
+     * or failed event is sent once that finishes.
+     */
     void create(int32_t width, int32_t height, uint32_t format, uint32_t flags) override
     {
         validate_params(width, height, format, flags);
 
-        try
-        {
-            auto const buffer_resource = wl_resource_create(client, &wl_buffer_interface, 1, 0);
-            if (!buffer_resource)
+        auto const last_valid_plane = validate_and_count_planes();
+        auto const& desc = descriptor_for_format_and_modifiers(format);
+        consumed = true;
+
+        auto const size = geom::Size{width, height};
+        auto const valid_planes = std::make_shared<std::vector<PlaneInfo> const>(planes.cbegin(), last_valid_plane);
+        mg::async_import<LinuxDmaBufParams>(
+            *egl_delegate,
+            wayland_executor,
+            mw::make_weak(this),
+            [dpy = dpy, egl_extensions = egl_extensions, size, format, modifier = modifier.value(), valid_planes]()
             {
-                wl_client_post_no_memory(client);
-                return;
-            }
+                try
+                {
+                    validate_import(dpy, *egl_extensions, size, format, modifier, *valid_planes);
+                    return true;
+                }
+                catch (std::exception const& err)
+                {
+                    /* The client should handle this fine, but let's make sure we can see
+                     * any failures that might happen.
+                     */
+                    mir::log_debug("Failed to import client dmabufs: %s", err.what());
+                    return false;
+                }
+            },
+            [desc = &desc, width, height, format, flags, modifier = modifier.value(), valid_planes](
+                LinuxDmaBufParams& params,
+                bool imported)
+            {
+                params.import_finished(imported, *desc, width, height, format, flags, modifier, *valid_planes);
+            });
+    }
 
-            auto const last_valid_plane = validate_and_count_planes();
-            new WlDmaBufBuffer{
-                dpy,
-                egl_extensions,
-                descriptor_for_format_and_modifiers(format),
-                buffer_resource,
-                width,
-                height,
-                format,
-                flags,
-                modifier.value(),
-                {planes.cbegin(), last_valid_plane}};
-            send_created_event(buffer_resource);
-        }
-        catch (std::system_error const& err)
+    void import_finished(
+        bool imported,
+        BufferGLDescription const& desc,
+        int32_t width,
+        int32_t height,
+        uint32_t format,
+        uint32_t flags,
+        uint64_t modifier,
+        std::vector<PlaneInfo> const& planes)
+    {
+        if (!imported)
         {
-            if (err.code().category() != mg::egl_category())
-            {
-                throw;
-            }
-            /* The client should handle this fine, but let's make sure we can see
-             * any failures that might happen.
-             */
-            mir::log_debug("Failed to import client dmabufs: %s", err.what());
             send_failed_event();
+            return;
         }
-        consumed = true;
+
+        auto const buffer_resource = wl_resource_create(client, &wl_buffer_interface, 1, 0);
+        if (!buffer_resource)
+        {
+            wl_client_post_no_memory(client);
+            return;
+        }
+
+        new WlDmaBufBuffer{
+            desc,
+            buffer_resource,
+            width,
+            height,
+            format,
+            flags,
+            modifier,
+            planes};
+        send_created_event(buffer_resource);
     }
 
+    /**
+     * The client may use the buffer as soon as this returns, and a failed import is a
+     * protocol error, so this imports synchronously.
+     */
     void
     create_immed(
         struct wl_resource* buffer_id,
@@ -805,18 +851,20 @@ private:
         try
         {
             auto const last_valid_plane = validate_and_count_planes();
+            std::vector<PlaneInfo> const valid_planes{planes.cbegin(), last_valid_plane};
+            auto const& desc = descriptor_for_format_and_modifiers(format);
+
+            validate_import(dpy, *egl_extensions, geom::Size{width, height}, format, modifier.value(), valid_planes);
 
             new WlDmaBufBuffer{
-                dpy,
-                egl_extensions,
-                descriptor_for_format_and_modifiers(format),
+                desc,
                 buffer_id,
                 width,
                 height,
                 format,
                 flags,
                 modifier.value(),
-                {planes.cbegin(), last_valid_plane}};
+                valid_planes};
         }
         catch (std::system_error const& err)
         {
@@ -841,13 +889,6 @@ private:
     }
 };
 
-GLuint get_tex_id()
-{
-    GLuint tex;
-    glGenTextures(1, &tex);
-    return tex;
-}
-
 bool drm_format_has_alpha(uint32_t format)
 {
     /* TODO: We should really have something like libweston/pixel-formats.h
@@ -880,17 +921,15 @@ class WaylandDmabufTexBuffer :
     public mg::DMABufBuffer
 {
 public:
-    // Note: Must be called with a current EGL context
     WaylandDmabufTexBuffer(
         WlDmaBufBuffer& source,
-        mg::EGLExtensions const& extensions,
-        std::shared_ptr<mir::renderer::gl::Context> ctx,
+        std::shared_ptr<mg::EGLExtensions> extensions,
         EGLDisplay dpy,
         std::function<void()>&& on_consumed,
         std::function<void()>&& on_release,
-        std::shared_ptr<mir::Executor> wayland_executor)
-        : ctx{std::move(ctx)},
-          tex{get_tex_id()},
+        std::shared_ptr<mir::Executor> egl_delegate)
+        : extensions{std::move(extensions)},
+          dpy{dpy},
           desc{source.descriptor()},
           on_consumed{std::move(on_consumed)},
           on_release{std::move(on_release)},
@@ -900,36 +939,36 @@ public:
           planes_{source.planes()},
           modifier_{source.modifier()},
           fourcc{source.format()},
-          wayland_executor{std::move(wayland_executor)}
+          egl_delegate{std::move(egl_delegate)}
     {
-        eglBindAPI(EGL_OPENGL_ES_API);
-
-        auto const target = source.descriptor().target;
-
-        glBindTexture(target, tex);
-        extensions.base(dpy).glEGLImageTargetTexture2DOES(target, source.reimport_egl_image());
-        // tex is now an EGLImage sibling, so we can free the EGLImage without
-        // freeing the backing data.
-
-        glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
     }
 
     ~WaylandDmabufTexBuffer() override
     {
-        wayland_executor->spawn(
-            [context = ctx, tex = tex]()
-            {
-              context->make_current();
+        if (tex)
+        {
+            egl_delegate->spawn([tex = tex]() { glDeleteTextures(1, &tex); });
+        }
 
-              glDeleteTextures(1, &tex);
+        on_release();
+    }
 
-              context->release_current();
+    /**
+     * Start importing the dmabufs into a texture on the EGL delegate thread
+     *
+     * This keeps the driver's import work off the Wayland thread, and lets it overlap
+     * with whatever the compositor is doing until the buffer is next drawn.
+     */
+    static void import_in_background(std::shared_ptr<WaylandDmabufTexBuffer> const& buffer)
+    {
+        buffer->egl_delegate->spawn(
+            [weak_buffer = std::weak_ptr<WaylandDmabufTexBuffer>{buffer}]()
+            {
+                if (auto const buffer = weak_buffer.lock())
+                {
+                    buffer->background_import();
+                }
             });
-
-        on_release();
     }
 
     mir::geometry::Size size() const override
@@ -974,6 +1013,8 @@ public:
 
     void bind() override
     {
+        texture_import.ensure_done([this]() { import_to_texture(); });
+
         glBindTexture(desc.target, tex);
 
         std::lock_guard<decltype(consumed_mutex)> lock(consumed_mutex);
@@ -1001,10 +1042,49 @@ public:
     }
 
 private:
-    std::shared_ptr<mir::renderer::gl::Context> const ctx;
-    GLuint const tex;
+    /// \note This must be called with a current GL context
+    void background_import()
+    {
+        texture_import.run_in_background([this]() { import_to_texture(); });
+    }
+
+    /// \note This must be called with a current GL context
+    void import_to_texture()
+    {
+        eglBindAPI(EGL_OPENGL_ES_API);
+
+        auto const target = desc.target;
+
+        glGenTextures(1, &tex);
+        glBindTexture(target, tex);
+
+        try
+        {
+            auto const image = mg::import_dmabuf_egl_image(dpy, *extensions, size_, fourcc, modifier_, planes_);
+            extensions->base(dpy).glEGLImageTargetTexture2DOES(target, image);
+            // tex is now an EGLImage sibling, so we can free the EGLImage without
+            // freeing the backing data.
+            extensions->base(dpy).eglDestroyImageKHR(dpy, image);
+        }
+        catch (std::exception const& err)
+        {
+            // The dmabufs imported when the buffer was created, so this is unexpected
+            mir::log_warning("Failed to import client dmabufs into a texture: %s", err.what());
+        }
+
+        glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+        glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+        glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+        glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    }
+
+    std::shared_ptr<mg::EGLExtensions> const extensions;
+    EGLDisplay const dpy;
+    GLuint tex{0};
     BufferGLDescription const& desc;
 
+    mg::BackgroundGLWork texture_import;
+
     std::mutex consumed_mutex;
     std::function<void()> on_consumed;
     std::function<void()> const on_release;
@@ -1017,7 +1097,7 @@ private:
     std::optional<uint64_t> const modifier_;
     uint32_t const fourcc;
 
-    std::shared_ptr<mir::Executor> const wayland_executor;
+    std::shared_ptr<mir::Executor> const egl_delegate;
 };
 
 
@@ -1030,11 +1110,15 @@ public:
         wl_resource* new_resource,
         EGLDisplay dpy,
         std::shared_ptr<EGLExtensions> egl_extensions,
-        std::shared_ptr<DmaBufFormatDescriptors const> formats)
+        std::shared_ptr<DmaBufFormatDescriptors const> formats,
+        std::shared_ptr<Executor> wayland_executor,
+        std::shared_ptr<Executor> egl_delegate)
         : mir::wayland::LinuxDmabufV1(new_resource, Version<3>{}),
           dpy{dpy},
           egl_extensions{std::move(egl_extensions)},
-          formats{std::move(formats)}
+          formats{std::move(formats)},
+          wayland_executor{std::move(wayland_executor)},
+          egl_delegate{std::move(egl_delegate)}
     {
         for (auto i = 0u; i < this->formats->num_formats(); ++i)
         {
@@ -1057,49 +1141,55 @@ public:
 private:
     void create_params(struct wl_resource* params_id) override
     {
-        new LinuxDmaBufParams{params_id, dpy, egl_extensions, formats};
+        new LinuxDmaBufParams{params_id, dpy, egl_extensions, formats, wayland_executor, egl_delegate};
     }
 
     EGLDisplay const dpy;
     std::shared_ptr<EGLExtensions> const egl_extensions;
     std::shared_ptr<DmaBufFormatDescriptors const> const formats;
+    std::shared_ptr<Executor> const wayland_executor;
+    std::shared_ptr<Executor> const egl_delegate;
 };
 
 mg::LinuxDmaBufUnstable::LinuxDmaBufUnstable(
     wl_display* display,
     EGLDisplay dpy,
     std::shared_ptr<EGLExtensions> egl_extensions,
-    EGLExtensions::EXTImageDmaBufImportModifiers const& dmabuf_ext)
+    EGLExtensions::EXTImageDmaBufImportModifiers const& dmabuf_ext,
+    std::shared_ptr<Executor> wayland_executor,
+    std::shared_ptr<Executor> egl_delegate)
     : mir::wayland::LinuxDmabufV1::Global(display, Version<3>{}),
       dpy{dpy},
       egl_extensions{std::move(egl_extensions)},
-      formats{std::make_shared<DmaBufFormatDescriptors>(dpy, dmabuf_ext)}
+      formats{std::make_shared<DmaBufFormatDescriptors>(dpy, dmabuf_ext)},
+      wayland_executor{std::move(wayland_executor)},
+      egl_delegate{std::move(egl_delegate)}
 {
 }
 
 auto mg::LinuxDmaBufUnstable::buffer_from_resource(
     wl_resource* buffer,
-    std::shared_ptr<renderer::gl::Context> ctx,
     std::function<void()>&& on_consumed,
-    std::function<void()>&& on_release,
-    std::shared_ptr<Executor> wayland_executor)
+    std::function<void()>&& on_release)
     -> std::shared_ptr<Buffer>
 {
     if (auto dmabuf = WlDmaBufBuffer::maybe_dmabuf_from_wl_buffer(buffer))
     {
-        return std::make_shared<WaylandDmabufTexBuffer>(
+        auto const result = std::make_shared<WaylandDmabufTexBuffer>(
             *dmabuf,
-            *egl_extensions,
-            std::move(ctx),
+            egl_extensions,
             dpy,
             std::move(on_consumed),
             std::move(on_release),
-            std::move(wayland_executor));
+            egl_delegate);
+
+        WaylandDmabufTexBuffer::import_in_background(result);
+        return result;
     }
     return nullptr;
 }
 
 void mg::LinuxDmaBufUnstable::bind(wl_resource* new_resource)
 {
-    new LinuxDmaBufUnstable::Instance{new_resource, dpy, egl_extensions, formats};
+    new LinuxDmaBufUnstable::Instance{new_resource, dpy, egl_extensions, formats, wayland_executor, egl_delegate};
 }
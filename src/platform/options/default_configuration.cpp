@@ -31,6 +31,7 @@ char const* const mo::compositor_report_opt       = "compositor-report";
 char const* const mo::display_report_opt          = "display-report";
 char const* const mo::scene_report_opt            = "scene-report";
 char const* const mo::input_report_opt            = "input-report";
+char const* const mo::input_latency_report_opt    = "input-latency-report";
 char const* const mo::seat_report_opt            = "seat-report";
 char const* const mo::shared_library_prober_report_opt = "shared-library-prober-report";
 char const* const mo::shell_report_opt            = "shell-report";
@@ -40,6 +41,11 @@ char const* const mo::fatal_except_opt            = "on-fatal-error-except";
 char const* const mo::debug_opt                   = "debug";
 char const* const mo::composite_delay_opt         = "composite-delay";
 char const* const mo::enable_key_repeat_opt       = "enable-key-repeat";
+char const* const mo::occluded_frame_interval_opt = "occluded-frame-interval";
+char const* const mo::client_max_surfaces_opt     = "client-max-surfaces";
+char const* const mo::client_max_frame_callbacks_opt = "client-max-frame-callbacks";
+char const* const mo::client_max_commit_rate_opt  = "client-max-commit-rate";
+char const* const mo::client_max_buffer_memory_opt = "client-max-buffer-memory";
 char const* const mo::x11_display_opt             = "enable-x11";
 char const* const mo::x11_scale_opt               = "x11-scale";
 char const* const mo::wayland_extensions_opt      = "wayland-extensions";
@@ -54,6 +60,7 @@ char const* const mo::platform_display_libs = "platform-display-libs";
 char const* const mo::platform_rendering_libs = "platform-rendering-libs";
 char const* const mo::platform_input_lib = "platform-input-lib";
 char const* const mo::platform_path = "platform-path";
+char const* const mo::platform_probe_cache_opt = "platform-probe-cache";
 
 char const* const mo::console_provider = "console-provider";
 char const* const mo::logind_console = "logind";
@@ -109,7 +116,9 @@ std::string description_text(char const* program, std::string const& config_file
     std::string result{
         "Command-line options (e.g. \"--wayland-host=wayland-0\").\n\n"
         "Environment variables capitalise long form with prefix \"MIR_SERVER_\" and \"_\" in place of \"-\".\n"
-        "(E.g. \"MIR_SERVER_WAYLAND_HOST=wayland-0\")\n\n"};
+        "(E.g. \"MIR_SERVER_WAYLAND_HOST=wayland-0\")\n\n"
+        "The GL renderer caches compiled shader programs in $XDG_CACHE_HOME/mir (or $HOME/.cache/mir).\n"
+        "Set MIR_DISABLE_GL_PROGRAM_CACHE in the environment to disable this.\n\n"};
 
     if (program)
         result = std::string{"usage: "} + program + " [options]\n\n" + result;
@@ -149,6 +158,9 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "Library to use for platform input support (default: input-stub.so)")
         (platform_path, po::value<std::string>()->default_value(MIR_SERVER_PLATFORM_PATH),
             "Directory to look for platform libraries (default: " MIR_SERVER_PLATFORM_PATH ")")
+        (platform_probe_cache_opt, po::value<std::string>(),
+            "File in which to remember the graphics platforms selected for this hardware, "
+            "so that later starts only probe those (default: probe every platform)")
         (enable_input_opt, po::value<bool>()->default_value(enable_input_default),
             "Enable input.")
         (compositor_report_opt, po::value<std::string>()->default_value(off_opt_value),
@@ -157,6 +169,8 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "How to handle the Display report. [{log,lttng,off}]")
         (input_report_opt, po::value<std::string>()->default_value(off_opt_value),
             "How to handle to Input report. [{log,lttng,off}]")
+        (input_latency_report_opt, po::value<std::string>()->default_value(off_opt_value),
+            "How to handle the input-to-scanout latency report. [{log,lttng,off}]")
         (seat_report_opt, po::value<std::string>()->default_value(off_opt_value),
             "How to handle to Seat report. [{log,off}]")
         (scene_report_opt, po::value<std::string>()->default_value(off_opt_value),
@@ -177,6 +191,22 @@ mo::DefaultConfiguration::DefaultConfiguration(
             "Cursor (mouse pointer) to use [{auto,null,software}]")
         (enable_key_repeat_opt, po::value<bool>()->default_value(true),
              "Enable server generated key repeat")
+        (occluded_frame_interval_opt, po::value<int>()->default_value(1000),
+            "Interval in milliseconds at which frame callbacks are sent to surfaces "
+            "that are not visible on any output. "
+            "0 means none are sent until the surface becomes visible.")
+        (client_max_surfaces_opt, po::value<int>()->default_value(0),
+            "Maximum number of surfaces a Wayland client may have, "
+            "beyond which it is disconnected. 0 means unlimited.")
+        (client_max_frame_callbacks_opt, po::value<int>()->default_value(0),
+            "Maximum number of pending frame callbacks a Wayland client may have, "
+            "beyond which it is disconnected. 0 means unlimited.")
+        (client_max_commit_rate_opt, po::value<int>()->default_value(0),
+            "Maximum number of surface commits per second a Wayland client may make, "
+            "beyond which it is disconnected. 0 means unlimited.")
+        (client_max_buffer_memory_opt, po::value<int>()->default_value(0),
+            "Maximum memory in MiB of the buffers attached to a Wayland client's surfaces, "
+            "beyond which it is disconnected. 0 means unlimited.")
         (fatal_except_opt, "On \"fatal error\" conditions [e.g. drivers behaving "
             "in unexpected ways] throw an exception (instead of a core dump)")
         (debug_opt, "Enable extra development debugging. "
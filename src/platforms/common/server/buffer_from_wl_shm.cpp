@@ -19,10 +19,16 @@
 
 #include "buffer_from_wl_shm.h"
 #include "shm_buffer.h"
+#include "egl_context_executor.h"
+#include "shm_udmabuf.h"
 
 #include "mir/renderer/sw/pixel_source.h"
 #include "mir/executor.h"
 #include "mir/renderer/gl/context.h"
+#include "mir/graphics/background_gl_work.h"
+#include "mir/graphics/prepared_in_background.h"
+#include "mir/graphics/linux_dmabuf.h"
+#include "mir/graphics/egl_extensions.h"
 
 #define MIR_LOG_COMPONENT "wayland-gfx-helpers"
 #include "mir/log.h"
@@ -31,6 +37,8 @@
 #include <mutex>
 #include <atomic>
 
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
 #include <GLES2/gl2.h>
 #include <GLES2/gl2ext.h>
 
@@ -303,9 +311,33 @@ private:
     }
 };
 
+namespace
+{
+/// wl_shm formats are DRM fourccs, other than the two that the core protocol requires
+auto wl_format_to_drm_fourcc(uint32_t format) -> uint32_t
+{
+    constexpr auto fourcc =
+        [](char a, char b, char c, char d)
+        {
+            return uint32_t(a) | (uint32_t(b) << 8) | (uint32_t(c) << 16) | (uint32_t(d) << 24);
+        };
+
+    switch (format)
+    {
+    case WL_SHM_FORMAT_ARGB8888:
+        return fourcc('A', 'R', '2', '4');
+    case WL_SHM_FORMAT_XRGB8888:
+        return fourcc('X', 'R', '2', '4');
+    default:
+        return format;
+    }
+}
+}
+
 class WlShmBuffer :
     public mg::common::ShmBuffer,
-    public mir::renderer::software::ReadMappableBuffer
+    public mir::renderer::software::ReadMappableBuffer,
+    public mg::PreparedInBackground
 {
 public:
     WlShmBuffer(
@@ -313,31 +345,67 @@ public:
         std::shared_ptr<mgc::EGLContextExecutor> egl_delegate,
         mir::geometry::Size const& size,
         mir::geometry::Stride stride,
-        MirPixelFormat format,
+        uint32_t wl_format,
+        std::shared_ptr<mgc::shm_udmabuf::Import> udmabuf,
+        std::shared_ptr<mg::EGLExtensions> egl_extensions,
         std::function<void()>&& on_consumed)
-        : ShmBuffer(size, format, std::move(egl_delegate)),
+        : ShmBuffer(size, wl_format_to_mir_format(wl_format), std::move(egl_delegate)),
           on_consumed{std::move(on_consumed)},
-          buffer{std::move(buffer)},
-          stride_{stride}
+          buffer{std::make_shared<SharedWlBuffer>(std::move(buffer))},
+          stride_{stride},
+          drm_fourcc{wl_format_to_drm_fourcc(wl_format)},
+          udmabuf{std::move(udmabuf)},
+          egl_extensions{std::move(egl_extensions)}
+    {
+    }
+
+    /**
+     * Start copying the pixels to the texture on the EGL delegate thread
+     *
+     * This lets the copy overlap with whatever the compositor is doing, rather
+     * than happening in bind() at frame time. Streams don't hand the buffer to
+     * the compositor until it's done (see when_ready()), and a buffer that is
+     * superseded before the copy starts is released without being copied.
+     */
+    static void upload_in_background(std::shared_ptr<WlShmBuffer> const& buffer)
     {
+        buffer->egl_context_executor()->spawn(
+            [weak_buffer = std::weak_ptr<WlShmBuffer>{buffer}]()
+            {
+                if (auto const buffer = weak_buffer.lock())
+                {
+                    buffer->background_upload();
+                }
+            });
     }
 
     void bind() override
     {
         ShmBuffer::bind();
-        std::lock_guard<std::mutex> lock{upload_mutex};
-        if (!uploaded)
-        {
-            auto const mapping = map_readable();
-            upload_to_texture(mapping->data(), mapping->stride());
-            uploaded = true;
-        }
+        /* This only sends frame callbacks. The client gets WL_BUFFER_RELEASE once `buffer` is
+         * dropped, which for an aliased texture is not until the texture itself is deleted.
+         */
+        notify_consumed();
+
+        // Only if the background upload failed, or the buffer reached the compositor some other way
+        texture_upload.ensure_done([this]() { upload(); });
+    }
+
+    void when_ready(std::function<void()>&& on_ready) override
+    {
+        texture_upload.when_done(std::move(on_ready));
     }
 
     auto map_readable() -> std::unique_ptr<mir::renderer::software::Mapping<unsigned char const>> override
     {
         notify_consumed();
+        return map();
+    }
 
+private:
+    /// Map the client's pixels without counting as the compositor consuming them
+    auto map() -> std::unique_ptr<mir::renderer::software::Mapping<unsigned char const>>
+    {
         class Mapping : public mir::renderer::software::Mapping<unsigned char const>
         {
         public:
@@ -387,7 +455,7 @@ public:
             WlShmBuffer* const parent;
         };
 
-        if (auto locked_buffer = buffer.lock())
+        if (auto locked_buffer = buffer->lock())
         {
             return std::make_unique<Mapping>(std::move(locked_buffer), this);
         }
@@ -444,7 +512,72 @@ public:
         }
     }
 
-private:
+    /// Fill the bound texture, aliasing the client's memory if we can rather than copying it
+    void upload()
+    {
+        if (udmabuf && egl_extensions && import_udmabuf())
+        {
+            return;
+        }
+
+        auto const mapping = map();
+        upload_to_texture(mapping->data(), mapping->stride());
+    }
+
+    /// \note This must be called with the texture bound in a current GL context
+    auto import_udmabuf() -> bool
+    {
+        // The first upload of each wl_buffer creates the dmabuf; later commits reuse it
+        auto dmabuf = udmabuf->dmabuf();
+        if (dmabuf == mir::Fd::invalid)
+        {
+            return false;
+        }
+
+        auto const display = eglGetCurrentDisplay();
+        try
+        {
+            auto const image = mg::import_dmabuf_egl_image(
+                display,
+                *egl_extensions,
+                size(),
+                drm_fourcc,
+                std::nullopt,
+                {{std::move(dmabuf), stride_.as_uint32_t(), 0}});
+            egl_extensions->base(display).glEGLImageTargetTexture2DOES(GL_TEXTURE_2D, image);
+            // The texture is now an EGLImage sibling, so keeps the pixels alive by itself
+            egl_extensions->base(display).eglDestroyImageKHR(display, image);
+        }
+        catch (std::exception const& error)
+        {
+            mir::log_debug("Failed to import udmabuf as EGLImage; falling back to copying: %s", error.what());
+            return false;
+        }
+
+        // The client mustn't reuse the buffer while we might still draw from its memory
+        keep_until_texture_deleted(buffer);
+        return true;
+    }
+
+    /// \note This must be called with a current GL context
+    void background_upload()
+    {
+        try
+        {
+            texture_upload.run_in_background(
+                [this]()
+                {
+                    ShmBuffer::bind();
+                    upload();
+                });
+        }
+        catch (std::exception const& error)
+        {
+            // bind() will try again
+            mir::log_warning("Background upload of SHM buffer failed: %s", error.what());
+        }
+    }
+
     void notify_consumed()
     {
         bool has_not_been_consumed{false};
@@ -457,10 +590,12 @@ private:
     std::atomic<bool> consumed{false};
     std::function<void()> on_consumed;
 
-    std::mutex upload_mutex;
-    bool uploaded{false};
-    SharedWlBuffer const buffer;
+    mg::BackgroundGLWork texture_upload;
+    std::shared_ptr<SharedWlBuffer> const buffer;
     mir::geometry::Stride const stride_;
+    uint32_t const drm_fourcc;
+    std::shared_ptr<mgc::shm_udmabuf::Import> const udmabuf;   ///< Null unless the pool could be imported through udmabuf
+    std::shared_ptr<mg::EGLExtensions> const egl_extensions;
 };
 
 auto mg::wayland::buffer_from_wl_shm(
@@ -468,13 +603,23 @@ auto mg::wayland::buffer_from_wl_shm(
     std::shared_ptr<Executor> executor,
     std::shared_ptr<common::EGLContextExecutor> egl_delegate,
     std::function<void()>&& on_consumed) -> std::shared_ptr<Buffer>
+{
+    return buffer_from_wl_shm(buffer, std::move(executor), std::move(egl_delegate), nullptr, std::move(on_consumed));
+}
+
+auto mg::wayland::buffer_from_wl_shm(
+    wl_resource* buffer,
+    std::shared_ptr<Executor> executor,
+    std::shared_ptr<common::EGLContextExecutor> egl_delegate,
+    std::shared_ptr<EGLExtensions> egl_extensions,
+    std::function<void()>&& on_consumed) -> std::shared_ptr<Buffer>
 {
     auto const shm_buffer = wl_shm_buffer_get(buffer);
     if (!shm_buffer)
     {
         BOOST_THROW_EXCEPTION((std::logic_error{"Attempt to import a non-SHM buffer as a SHM buffer"}));
     }
-    return std::make_shared<WlShmBuffer>(
+    auto const result = std::make_shared<WlShmBuffer>(
         SharedWlBuffer{buffer, std::move(executor)},
         std::move(egl_delegate),
         mir::geometry::Size{
@@ -482,6 +627,11 @@ auto mg::wayland::buffer_from_wl_shm(
             wl_shm_buffer_get_height(shm_buffer)
         },
         mir::geometry::Stride{wl_shm_buffer_get_stride(shm_buffer)},
-        wl_format_to_mir_format(wl_shm_buffer_get_format(shm_buffer)),
+        wl_shm_buffer_get_format(shm_buffer),
+        egl_extensions ? mgc::shm_udmabuf::import_for(buffer) : nullptr,
+        std::move(egl_extensions),
         std::move(on_consumed));
+
+    WlShmBuffer::upload_in_background(result);
+    return result;
 }
@@ -32,6 +32,7 @@ class Executor;
 namespace graphics
 {
 class Buffer;
+class EGLExtensions;
 
 namespace common
 {
@@ -46,6 +47,9 @@ namespace wayland
  * The returned buffer will support the mg::gl::Texture and
  * mir::renderer::sw::PixelSource interfaces.
  *
+ * Copying the pixels to a texture starts straight away on \a egl_delegate's
+ * thread, so it is normally complete by the time the buffer is drawn.
+ *
  * \note This must be called on the Wayland thread, with a current GL context
  *
  * \param buffer        [in]    The Wayland SHM buffer to import
@@ -59,6 +63,23 @@ auto buffer_from_wl_shm(
     std::shared_ptr<Executor> executor,
     std::shared_ptr<common::EGLContextExecutor> egl_delegate,
     std::function<void()>&& on_consumed) -> std::shared_ptr<Buffer>;
+
+/**
+ * Get a mir::graphics::Buffer with the content of the shm buffer, aliasing it where possible
+ *
+ * If shm_udmabuf::install() is tracking the buffer's pool, the texture is an EGLImage
+ * of the client's memory rather than a copy of it. The client is then sent
+ * WL_BUFFER_RELEASE only once that texture has been deleted.
+ *
+ * \param egl_extensions [in]   Extensions for the display of \a egl_delegate's context
+ * \see buffer_from_wl_shm() for the other parameters
+ */
+auto buffer_from_wl_shm(
+    wl_resource* buffer,
+    std::shared_ptr<Executor> executor,
+    std::shared_ptr<common::EGLContextExecutor> egl_delegate,
+    std::shared_ptr<EGLExtensions> egl_extensions,
+    std::function<void()>&& on_consumed) -> std::shared_ptr<Buffer>;
 }
 }
 }
@@ -53,24 +53,29 @@ void mgc::EGLContextExecutor::process_loop(mgc::EGLContextExecutor* const me)
     me->ctx->make_current();
 
     std::unique_lock<std::mutex> lock{me->mutex};
-    while (!me->shutdown_requested)
+    while (!me->shutdown_requested || !me->work_queue.empty())
     {
-        for (auto& work : me->work_queue)
+        if (me->work_queue.empty())
         {
-            work();
+            me->new_work.wait(lock);
+            continue;
         }
-        me->work_queue.clear();
-
-        me->new_work.wait(lock);
-    }
 
-    // Drain the work-queue
-    for (auto& work : me->work_queue)
-    {
-        work();
+        /* Run the work without holding the lock: uploads can take a while, and
+         * neither spawn() nor work that spawns more work should wait on them.
+         * Dropping the functors here ensures their cleanup also happens with
+         * the EGL context current.
+         */
+        decltype(me->work_queue) work_queue;
+        std::swap(work_queue, me->work_queue);
+        lock.unlock();
+        for (auto& work : work_queue)
+        {
+            work();
+        }
+        work_queue.clear();
+        lock.lock();
     }
-    // …and ensure any functor cleanup happens with the EGL context current, too.
-    me->work_queue.clear();
 
     me->ctx->release_current();
 }
@@ -120,7 +120,8 @@ mgc::ShmBuffer::~ShmBuffer() noexcept
     if (tex_id != 0)
     {
         egl_delegate->spawn(
-            [id = tex_id]()
+            // Anything the texture aliases is released along with this functor, once the texture is gone
+            [id = tex_id, storage = std::move(texture_storage)]()
             {
                 glDeleteTextures(1, &id);
             });
@@ -180,6 +181,17 @@ void mgc::ShmBuffer::upload_to_texture(void const* pixels, geom::Stride const& s
     }
 }
 
+auto mgc::ShmBuffer::egl_context_executor() const -> std::shared_ptr<EGLContextExecutor> const&
+{
+    return egl_delegate;
+}
+
+void mgc::ShmBuffer::keep_until_texture_deleted(std::shared_ptr<void const> storage)
+{
+    std::lock_guard<decltype(tex_id_mutex)> lock{tex_id_mutex};
+    texture_storage = std::move(storage);
+}
+
 mg::NativeBufferBase* mgc::ShmBuffer::native_buffer_base()
 {
     return this;
@@ -69,12 +69,23 @@ protected:
 
     /// \note This must be called with a current GL context
     void upload_to_texture(void const* pixels, geometry::Stride const& stride);
+
+    /// Runs GL work on a thread with a current EGL context, sharing textures with the compositor
+    auto egl_context_executor() const -> std::shared_ptr<EGLContextExecutor> const&;
+
+    /**
+     * Keep \a storage alive until the texture has been deleted
+     *
+     * For textures that alias memory owned elsewhere rather than holding a copy of it.
+     */
+    void keep_until_texture_deleted(std::shared_ptr<void const> storage);
 private:
     geometry::Size const size_;
     MirPixelFormat const pixel_format_;
     std::shared_ptr<EGLContextExecutor> const egl_delegate;
     std::mutex tex_id_mutex;
     GLuint tex_id{0};
+    std::shared_ptr<void const> texture_storage;
 };
 
 class MemoryBackedShmBuffer :
@@ -0,0 +1,324 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shm_udmabuf.h"
+
+#define MIR_LOG_COMPONENT "wayland-gfx-helpers"
+#include "mir/log.h"
+
+#include <wayland-server-core.h>
+
+#include <linux/udmabuf.h>
+#include <sys/ioctl.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <type_traits>
+
+namespace shm_udmabuf = mir::graphics::common::shm_udmabuf;
+
+namespace
+{
+/// A duplicate of \a fd if it is a memfd that udmabuf will accept, otherwise an invalid Fd
+auto dup_if_sealed_memfd(int fd) -> mir::Fd
+{
+    // F_GET_SEALS fails for anything other than a memfd
+    auto const seals = fcntl(fd, F_GET_SEALS);
+    if (seals < 0 || !(seals & F_SEAL_SHRINK) || (seals & F_SEAL_WRITE))
+    {
+        return {};
+    }
+    return mir::Fd{fcntl(fd, F_DUPFD_CLOEXEC, 0)};
+}
+
+auto same_geometry(shm_udmabuf::BufferPlacement const& a, shm_udmabuf::BufferPlacement const& b) -> bool
+{
+    return a.width == b.width &&
+           a.height == b.height &&
+           a.stride == b.stride &&
+           a.format == b.format;
+}
+}
+
+shm_udmabuf::Import::Import(Fd udmabuf_device, Fd pool, BufferPlacement const& placement, size_t size)
+    : udmabuf_device{std::move(udmabuf_device)},
+      pool{std::move(pool)},
+      placement_{placement},
+      size{size}
+{
+}
+
+auto shm_udmabuf::Import::dmabuf() -> Fd
+{
+    std::call_once(
+        created,
+        [this]()
+        {
+            udmabuf_create create{};
+            create.memfd = pool;
+            create.flags = UDMABUF_FLAGS_CLOEXEC;
+            create.offset = placement_.offset;
+            create.size = size;
+
+            auto const dmabuf = ioctl(udmabuf_device, UDMABUF_CREATE, &create);
+            if (dmabuf < 0)
+            {
+                mir::log_debug("Failed to create udmabuf for wl_shm buffer: %s", strerror(errno));
+                return;
+            }
+            dmabuf_ = Fd{dmabuf};
+        });
+    return dmabuf_;
+}
+
+auto shm_udmabuf::Import::placement() const -> BufferPlacement const&
+{
+    return placement_;
+}
+
+shm_udmabuf::ClientPools::ClientPools(Fd udmabuf_device)
+    : udmabuf_device{std::move(udmabuf_device)}
+{
+}
+
+void shm_udmabuf::ClientPools::pool_created(uint32_t pool, int fd)
+{
+    if (auto sealed = dup_if_sealed_memfd(fd); sealed != Fd::invalid)
+    {
+        pools[pool] = std::move(sealed);
+    }
+}
+
+void shm_udmabuf::ClientPools::pool_destroyed(uint32_t pool)
+{
+    pools.erase(pool);
+}
+
+void shm_udmabuf::ClientPools::buffer_created(uint32_t buffer, uint32_t pool, BufferPlacement const& placement)
+{
+    // Object ids are reused, so forget whatever previously had this one
+    buffers.erase(buffer);
+
+    auto const pool_fd = pools.find(pool);
+    if (pool_fd == pools.end() || placement.stride <= 0 || placement.height <= 0)
+    {
+        return;
+    }
+
+    // udmabuf deals in whole pages
+    auto const page_size = sysconf(_SC_PAGESIZE);
+    auto const size = static_cast<off_t>(placement.stride) * placement.height;
+    auto const page_aligned_size = (size + page_size - 1) / page_size * page_size;
+    struct stat pool_stat;
+    if (placement.offset % page_size != 0 ||
+        fstat(pool_fd->second, &pool_stat) != 0 ||
+        placement.offset + page_aligned_size > pool_stat.st_size)
+    {
+        return;
+    }
+
+    buffers[buffer] = std::make_shared<Import>(
+        udmabuf_device,
+        pool_fd->second,
+        placement,
+        static_cast<size_t>(page_aligned_size));
+}
+
+void shm_udmabuf::ClientPools::buffer_destroyed(uint32_t buffer)
+{
+    buffers.erase(buffer);
+}
+
+auto shm_udmabuf::ClientPools::import_for(uint32_t buffer, BufferPlacement const& actual) const
+    -> std::shared_ptr<Import>
+{
+    auto const import = buffers.find(buffer);
+    if (import == buffers.end() || !same_geometry(import->second->placement(), actual))
+    {
+        return {};
+    }
+    return import->second;
+}
+
+namespace
+{
+struct ClientPoolsListener
+{
+    wl_listener destruction_listener;
+    shm_udmabuf::ClientPools* pools;
+};
+
+void on_client_destroyed(wl_listener* listener, void*)
+{
+    ClientPoolsListener* client_listener;
+    client_listener = wl_container_of(listener, client_listener, destruction_listener);
+    delete client_listener->pools;
+    delete client_listener;
+}
+
+auto existing_pools_for(wl_client* client) -> shm_udmabuf::ClientPools*
+{
+    static_assert(
+        std::is_standard_layout<ClientPoolsListener>::value,
+        "ClientPoolsListener must be Standard Layout for wl_container_of to be defined behaviour");
+
+    if (auto const listener = wl_client_get_destroy_listener(client, &on_client_destroyed))
+    {
+        ClientPoolsListener* client_listener;
+        client_listener = wl_container_of(listener, client_listener, destruction_listener);
+        return client_listener->pools;
+    }
+    return nullptr;
+}
+
+struct Importer
+{
+    wl_listener destruction_listener;
+    wl_protocol_logger* logger;
+    mir::Fd udmabuf_device;
+};
+
+auto pools_for(wl_client* client, Importer const& importer) -> shm_udmabuf::ClientPools&
+{
+    if (auto const pools = existing_pools_for(client))
+    {
+        return *pools;
+    }
+
+    auto const client_listener =
+        new ClientPoolsListener{{}, new shm_udmabuf::ClientPools{importer.udmabuf_device}};
+    client_listener->destruction_listener.notify = &on_client_destroyed;
+    wl_client_add_destroy_listener(client, &client_listener->destruction_listener);
+    return *client_listener->pools;
+}
+
+/// Decodes the wl_shm requests that ClientPools needs to know about
+void track_shm_requests(void* data, wl_protocol_logger_type type, wl_protocol_logger_message const* message)
+{
+    if (type != WL_PROTOCOL_LOGGER_REQUEST)
+    {
+        return;
+    }
+
+    auto const interface = wl_resource_get_class(message->resource);
+    auto const request = message->message->name;
+    auto const args = message->arguments;
+    auto const client = wl_resource_get_client(message->resource);
+
+    if (strcmp(interface, "wl_shm") == 0 && strcmp(request, "create_pool") == 0)
+    {
+        // create_pool(id new_id, fd fd, int size)
+        pools_for(client, *static_cast<Importer*>(data)).pool_created(args[0].n, args[1].h);
+        return;
+    }
+
+    // Anything else only matters if we saw the pool being created
+    auto const pools = existing_pools_for(client);
+    if (!pools)
+    {
+        return;
+    }
+
+    if (strcmp(interface, "wl_shm_pool") == 0)
+    {
+        if (strcmp(request, "create_buffer") == 0)
+        {
+            // create_buffer(id new_id, int offset, int width, int height, int stride, uint format)
+            pools->buffer_created(
+                args[0].n,
+                wl_resource_get_id(message->resource),
+                shm_udmabuf::BufferPlacement{args[1].i, args[2].i, args[3].i, args[4].i, args[5].u});
+        }
+        else if (strcmp(request, "destroy") == 0)
+        {
+            pools->pool_destroyed(wl_resource_get_id(message->resource));
+        }
+    }
+    else if (strcmp(interface, "wl_buffer") == 0 && strcmp(request, "destroy") == 0)
+    {
+        pools->buffer_destroyed(wl_resource_get_id(message->resource));
+    }
+}
+
+void on_display_destroyed(wl_listener* listener, void*)
+{
+    Importer* importer;
+    importer = wl_container_of(listener, importer, destruction_listener);
+    wl_protocol_logger_destroy(importer->logger);
+    delete importer;
+}
+
+auto importer_for(wl_display* display) -> Importer*
+{
+    static_assert(
+        std::is_standard_layout<Importer>::value,
+        "Importer must be Standard Layout for wl_container_of to be defined behaviour");
+
+    if (auto const listener = wl_display_get_destroy_listener(display, &on_display_destroyed))
+    {
+        Importer* importer;
+        importer = wl_container_of(listener, importer, destruction_listener);
+        return importer;
+    }
+    return nullptr;
+}
+}
+
+auto shm_udmabuf::install(wl_display* display) -> bool
+{
+    if (importer_for(display))
+    {
+        return true;
+    }
+
+    mir::Fd udmabuf_device{open("/dev/udmabuf", O_RDWR | O_CLOEXEC)};
+    if (udmabuf_device == mir::Fd::invalid)
+    {
+        mir::log_info("udmabuf unavailable (%s); wl_shm buffers will be copied", strerror(errno));
+        return false;
+    }
+
+    auto const importer = new Importer{{}, nullptr, std::move(udmabuf_device)};
+    importer->destruction_listener.notify = &on_display_destroyed;
+    wl_display_add_destroy_listener(display, &importer->destruction_listener);
+    importer->logger = wl_display_add_protocol_logger(display, &track_shm_requests, importer);
+
+    mir::log_info("Importing sealed memfd wl_shm buffers through udmabuf");
+    return true;
+}
+
+auto shm_udmabuf::import_for(wl_resource* buffer) -> std::shared_ptr<Import>
+{
+    auto const client = wl_resource_get_client(buffer);
+    auto const shm_buffer = wl_shm_buffer_get(buffer);
+    auto const pools = existing_pools_for(client);
+    if (!shm_buffer || !pools)
+    {
+        return {};
+    }
+
+    return pools->import_for(
+        wl_resource_get_id(buffer),
+        BufferPlacement{
+            0,
+            wl_shm_buffer_get_width(shm_buffer),
+            wl_shm_buffer_get_height(shm_buffer),
+            wl_shm_buffer_get_stride(shm_buffer),
+            wl_shm_buffer_get_format(shm_buffer)});
+}
@@ -0,0 +1,146 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_GRAPHICS_COMMON_SHM_UDMABUF_H_
+#define MIR_GRAPHICS_COMMON_SHM_UDMABUF_H_
+
+#include "mir/fd.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+struct wl_display;
+struct wl_resource;
+
+namespace mir
+{
+namespace graphics
+{
+namespace common
+{
+/**
+ * Zero-copy import of wl_shm buffers through the kernel's udmabuf driver
+ *
+ * udmabuf turns a range of a sealed memfd into a dmabuf, which can then be
+ * imported into GL as an EGLImage rather than copied into a texture.
+ *
+ * libwayland does not expose the file descriptor behind a wl_shm_pool, so
+ * a protocol logger (which runs before each request is dispatched) keeps a
+ * duplicate of every suitably sealed memfd passed to wl_shm.create_pool, and
+ * records where each wl_shm_pool.create_buffer places its buffer.
+ */
+namespace shm_udmabuf
+{
+/// Where a wl_shm_pool.create_buffer request put a buffer
+struct BufferPlacement
+{
+    int32_t offset;
+    int32_t width;
+    int32_t height;
+    int32_t stride;
+    uint32_t format;
+};
+
+/**
+ * The udmabuf aliasing one wl_buffer
+ *
+ * The dmabuf is only created when first asked for, so that the ioctl runs
+ * on whichever thread uploads the buffer rather than on the Wayland thread.
+ * It is then reused each time the client commits the same wl_buffer.
+ */
+class Import
+{
+public:
+    Import(Fd udmabuf_device, Fd pool, BufferPlacement const& placement, size_t size);
+
+    /**
+     * The dmabuf, creating it on the first call
+     *
+     * \note    This may be called on any thread
+     * \return  An invalid Fd if the kernel refused to create it
+     */
+    auto dmabuf() -> Fd;
+
+    auto placement() const -> BufferPlacement const&;
+
+private:
+    Fd const udmabuf_device;
+    Fd const pool;
+    BufferPlacement const placement_;
+    size_t const size;
+
+    std::once_flag created;
+    Fd dmabuf_;
+};
+
+/**
+ * The wl_shm pools and buffers of one client, keyed by object id
+ *
+ * \note This is not threadsafe; it is only used on the Wayland thread
+ */
+class ClientPools
+{
+public:
+    explicit ClientPools(Fd udmabuf_device);
+
+    /// Track \a pool if \a fd is a memfd that udmabuf will accept
+    void pool_created(uint32_t pool, int fd);
+    /// Buffers created from the pool keep their own reference to it
+    void pool_destroyed(uint32_t pool);
+
+    void buffer_created(uint32_t buffer, uint32_t pool, BufferPlacement const& placement);
+    void buffer_destroyed(uint32_t buffer);
+
+    /**
+     * The import for \a buffer
+     *
+     * \param buffer  [in] The wl_buffer id
+     * \param actual  [in] The buffer's geometry, as libwayland sees it
+     * \return        null unless \a buffer's pool and placement are suitable,
+     *                and match \a actual
+     */
+    auto import_for(uint32_t buffer, BufferPlacement const& actual) const -> std::shared_ptr<Import>;
+
+private:
+    Fd const udmabuf_device;
+    std::unordered_map<uint32_t, Fd> pools;
+    std::unordered_map<uint32_t, std::shared_ptr<Import>> buffers;
+};
+
+/**
+ * Start tracking wl_shm pools on \a display
+ *
+ * \note    This must be called on the Wayland thread
+ * \return  false if the kernel doesn't support udmabuf
+ */
+auto install(wl_display* display) -> bool;
+
+/**
+ * The import for the wl_shm \a buffer
+ *
+ * \note    This must be called on the Wayland thread
+ * \return  null if udmabuf import isn't installed on \a buffer's display,
+ *          or if the buffer's pool or placement isn't suitable
+ */
+auto import_for(wl_resource* buffer) -> std::shared_ptr<Import>;
+}
+}
+}
+}
+
+#endif // MIR_GRAPHICS_COMMON_SHM_UDMABUF_H_
@@ -111,7 +111,19 @@ struct mie::LibInputDevice::ContactExtension
 };
 
 mie::LibInputDevice::LibInputDevice(std::shared_ptr<mi::InputReport> const& report, LibInputDevicePtr dev)
-    : contact_extension{std::make_unique<ContactExtension>()}, report{report}, pointer_pos{0, 0}, button_state{0}
+    : LibInputDevice{report, std::move(dev), false}
+{
+}
+
+mie::LibInputDevice::LibInputDevice(
+    std::shared_ptr<mi::InputReport> const& report,
+    LibInputDevicePtr dev,
+    bool coalesce_motion)
+    : contact_extension{std::make_unique<ContactExtension>()},
+      report{report},
+      pointer_pos{0, 0},
+      button_state{0},
+      coalesce_motion{coalesce_motion}
 {
     add_device_of_group(std::move(dev));
 }
@@ -132,6 +144,7 @@ void mie::LibInputDevice::start(InputSink* sink, EventBuilder* builder)
 
 void mie::LibInputDevice::stop()
 {
+    pending_motion.reset();
     sink = nullptr;
     builder = nullptr;
 }
@@ -143,16 +156,28 @@ void mie::LibInputDevice::process_event(libinput_event* event)
 
     try
     {
-        switch(libinput_event_get_type(event))
+        auto const type = libinput_event_get_type(event);
+
+        // Anything other than motion must not overtake the motion that preceded it
+        if (type != LIBINPUT_EVENT_POINTER_MOTION && type != LIBINPUT_EVENT_POINTER_MOTION_ABSOLUTE)
+            send_pending_motion();
+
+        switch(type)
         {
         case LIBINPUT_EVENT_KEYBOARD_KEY:
             sink->handle_input(convert_event(libinput_event_get_keyboard_event(event)));
             break;
         case LIBINPUT_EVENT_POINTER_MOTION:
-            sink->handle_input(convert_motion_event(libinput_event_get_pointer_event(event)));
+            if (coalesce_motion)
+                coalesce_motion_event(libinput_event_get_pointer_event(event));
+            else
+                sink->handle_input(convert_motion_event(libinput_event_get_pointer_event(event)));
             break;
         case LIBINPUT_EVENT_POINTER_MOTION_ABSOLUTE:
-            sink->handle_input(convert_absolute_motion_event(libinput_event_get_pointer_event(event)));
+            if (coalesce_motion)
+                coalesce_absolute_motion_event(libinput_event_get_pointer_event(event));
+            else
+                sink->handle_input(convert_absolute_motion_event(libinput_event_get_pointer_event(event)));
             break;
         case LIBINPUT_EVENT_POINTER_BUTTON:
             sink->handle_input(convert_button_event(libinput_event_get_pointer_event(event)));
@@ -263,6 +288,92 @@ mir::EventUPtr mie::LibInputDevice::convert_absolute_motion_event(libinput_event
                                   movement.dx.as_int(), movement.dy.as_int());
 }
 
+void mie::LibInputDevice::coalesce_motion_event(libinput_event_pointer* pointer)
+{
+    std::chrono::nanoseconds const time = std::chrono::microseconds(libinput_event_pointer_get_time_usec(pointer));
+
+    report->received_event_from_kernel(time.count(), EV_REL, 0, 0);
+
+    if (pending_motion && pending_motion->absolute)
+        send_pending_motion();
+
+    if (!pending_motion)
+        pending_motion = PendingMotion{time, false, 0.0f, 0.0f, 0.0f, 0.0f};
+
+    pending_motion->time = time;
+    pending_motion->dx += libinput_event_pointer_get_dx(pointer);
+    pending_motion->dy += libinput_event_pointer_get_dy(pointer);
+}
+
+void mie::LibInputDevice::coalesce_absolute_motion_event(libinput_event_pointer* pointer)
+{
+    std::chrono::nanoseconds const time = std::chrono::microseconds(libinput_event_pointer_get_time_usec(pointer));
+    auto const screen = sink->bounding_rectangle();
+    uint32_t const width = screen.size.width.as_int();
+    uint32_t const height = screen.size.height.as_int();
+    auto abs_x = libinput_event_pointer_get_absolute_x_transformed(pointer, width);
+    auto abs_y = libinput_event_pointer_get_absolute_y_transformed(pointer, height);
+
+    report->received_event_from_kernel(time.count(), EV_ABS, 0, 0);
+
+    if (pending_motion && !pending_motion->absolute)
+        send_pending_motion();
+
+    if (!pending_motion)
+        pending_motion = PendingMotion{time, true, 0.0f, 0.0f, 0.0f, 0.0f};
+
+    auto const old_pointer_pos = pointer_pos;
+    pointer_pos = mir::geometry::Point{abs_x, abs_y};
+    auto const movement = pointer_pos - old_pointer_pos;
+
+    pending_motion->time = time;
+    pending_motion->x = abs_x;
+    pending_motion->y = abs_y;
+    pending_motion->dx += movement.dx.as_int();
+    pending_motion->dy += movement.dy.as_int();
+}
+
+void mie::LibInputDevice::flush_pending_motion()
+{
+    try
+    {
+        send_pending_motion();
+    }
+    catch(std::exception const& error)
+    {
+        mir::log_error("Failure sending merged pointer motion: " + boost::diagnostic_information(error));
+    }
+}
+
+void mie::LibInputDevice::send_pending_motion()
+{
+    if (!pending_motion)
+        return;
+
+    auto const motion = *pending_motion;
+    pending_motion.reset();
+
+    if (!sink)
+        return;
+
+    auto const action = mir_pointer_action_motion;
+    auto const hscroll_value = 0.0f;
+    auto const vscroll_value = 0.0f;
+
+    // The merged event carries the timestamp of the most recent sample, which is when the
+    // device was last at the reported position
+    if (motion.absolute)
+    {
+        sink->handle_input(builder->pointer_event(motion.time, action, button_state, motion.x, motion.y,
+                                                  hscroll_value, vscroll_value, motion.dx, motion.dy));
+    }
+    else
+    {
+        sink->handle_input(builder->pointer_event(motion.time, action, button_state,
+                                                  hscroll_value, vscroll_value, motion.dx, motion.dy));
+    }
+}
+
 mir::EventUPtr mie::LibInputDevice::convert_axis_event(libinput_event_pointer* pointer)
 {
     std::chrono::nanoseconds const time = std::chrono::microseconds(libinput_event_pointer_get_time_usec(pointer));
@@ -28,8 +28,10 @@
 #include "mir/input/touchscreen_settings.h"
 #include "mir/geometry/point.h"
 
+#include <chrono>
 #include <vector>
 #include <map>
+#include <optional>
 
 struct libinput_event;
 struct libinput_event_keyboard;
@@ -52,6 +54,9 @@ class LibInputDevice : public input::InputDevice
 {
 public:
     LibInputDevice(std::shared_ptr<InputReport> const& report, LibInputDevicePtr dev);
+    /// When \a coalesce_motion is set consecutive pointer motion is merged into a single event that is
+    /// sent before the next non-motion event or on flush_pending_motion()
+    LibInputDevice(std::shared_ptr<InputReport> const& report, LibInputDevicePtr dev, bool coalesce_motion);
     ~LibInputDevice();
     void start(InputSink* sink, EventBuilder* builder) override;
     void stop() override;
@@ -64,6 +69,8 @@ public:
     void apply_settings(TouchscreenSettings const&) override;
 
     void process_event(libinput_event* event);
+    /// Sends any merged motion now. Like process_event(), this logs failures rather than throwing
+    void flush_pending_motion();
     ::libinput_device* device() const;
     ::libinput_device_group* group();
     void add_device_of_group(LibInputDevicePtr ptr);
@@ -73,6 +80,9 @@ private:
     EventUPtr convert_motion_event(libinput_event_pointer* pointer);
     EventUPtr convert_absolute_motion_event(libinput_event_pointer* pointer);
     EventUPtr convert_axis_event(libinput_event_pointer* pointer);
+    void coalesce_motion_event(libinput_event_pointer* pointer);
+    void coalesce_absolute_motion_event(libinput_event_pointer* pointer);
+    void send_pending_motion();
     EventUPtr convert_touch_frame(libinput_event_touch* touch);
     void handle_touch_down(libinput_event_touch* touch);
     void handle_touch_up(libinput_event_touch* touch);
@@ -105,6 +115,16 @@ private:
     };
     std::map<MirTouchId,ContactData> last_seen_properties;
 
+    struct PendingMotion
+    {
+        std::chrono::nanoseconds time;
+        bool absolute;
+        float x, y;     // only meaningful for absolute motion
+        float dx, dy;   // accumulated over the merged events
+    };
+    bool const coalesce_motion;
+    std::optional<PendingMotion> pending_motion;
+
     void update_contact_data(ContactData &data, MirTouchAction action, libinput_event_touch* touch);
 };
 }
@@ -130,11 +130,13 @@ mie::Platform::Platform(
         std::shared_ptr<InputDeviceRegistry> const& registry,
         std::shared_ptr<InputReport> const& report,
         std::unique_ptr<udev::Context>&& udev_context,
-        std::shared_ptr<ConsoleServices> const& console) :
+        std::shared_ptr<ConsoleServices> const& console,
+        bool coalesce_pointer_motion) :
     report(report),
     udev_context(std::move(udev_context)),
     input_device_registry(registry),
     console{console},
+    coalesce_pointer_motion{coalesce_pointer_motion},
     platform_dispatchable{std::make_shared<md::MultiplexingDispatchable>()}
 {
 }
@@ -392,6 +394,9 @@ void mie::Platform::process_input_events()
         return EventType(libinput_get_event(lilib), libinput_event_destroy);
     };
 
+    // The device whose events were dispatched last, and so the only one that can have merged motion pending
+    std::shared_ptr<LibInputDevice> last_device;
+
     while(auto ev = next_event())
     {
         auto type = libinput_event_get_type(ev.get());
@@ -409,9 +414,20 @@ void mie::Platform::process_input_events()
         {
             auto dev = find_device(device);
             if (dev != end(devices))
-                (*dev)->process_event(ev.get());
+            {
+                // Another device's event must not overtake the motion that preceded it
+                if (last_device && last_device != *dev)
+                    last_device->flush_pending_motion();
+
+                last_device = *dev;
+                last_device->process_event(ev.get());
+            }
         }
     }
+
+    // Motion read in this batch is as up to date as it gets until the next wakeup
+    for (auto const& dev : devices)
+        dev->flush_pending_motion();
 }
 
 void mie::Platform::pause_for_config()
@@ -438,7 +454,7 @@ void mie::Platform::device_added(libinput_device* dev)
 
     try
     {
-        devices.emplace_back(std::make_shared<mie::LibInputDevice>(report, move(device_ptr)));
+        devices.emplace_back(std::make_shared<mie::LibInputDevice>(report, move(device_ptr), coalesce_pointer_motion));
 
         input_device_registry->add_device(devices.back());
 
@@ -37,6 +37,8 @@ namespace mie = mi::evdev;
 
 namespace
 {
+char const* const coalesce_motion_option_name{"coalesce-pointer-motion"};
+
 mir::ModuleProperties const description = {
     "mir:evdev-input",
     MIR_VERSION_MAJOR,
@@ -104,7 +106,7 @@ bool can_open_input_devices(mir::ConsoleServices& console)
 }
 
 mir::UniqueModulePtr<mi::Platform> create_input_platform(
-    mo::Option const& /*options*/,
+    mo::Option const& options,
     std::shared_ptr<mir::EmergencyCleanupRegistry> const& /*emergency_cleanup_registry*/,
     std::shared_ptr<mi::InputDeviceRegistry> const& input_device_registry,
     std::shared_ptr<mir::ConsoleServices> const& console,
@@ -115,14 +117,18 @@ mir::UniqueModulePtr<mi::Platform> create_input_platform(
         input_device_registry,
         report,
         std::make_unique<mu::Context>(),
-        console);
+        console,
+        options.get(coalesce_motion_option_name, false));
 }
 
 void add_input_platform_options(
-    boost::program_options::options_description& /*config*/)
+    boost::program_options::options_description& config)
 {
     mir::assert_entry_point_signature<mi::AddPlatformOptions>(&add_input_platform_options);
-    // no options to add yet
+    config.add_options()
+        (coalesce_motion_option_name,
+         boost::program_options::value<bool>()->default_value(false),
+         "[platform-specific] merge pointer motion read from a device in one batch into a single event.");
 }
 
 mi::PlatformPriority probe_input_platform(
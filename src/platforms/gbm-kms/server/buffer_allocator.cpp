@@ -33,6 +33,7 @@
 #include "mir/renderer/gl/context_source.h"
 #include "mir/graphics/egl_wayland_allocator.h"
 #include "buffer_from_wl_shm.h"
+#include "shm_udmabuf.h"
 #include "mir/executor.h"
 
 #include <boost/throw_exception.hpp>
@@ -94,11 +95,12 @@ std::unique_ptr<mir::renderer::gl::Context> context_for_output(mg::Display const
 }
 }
 
-mgg::BufferAllocator::BufferAllocator(mg::Display const& output)
+mgg::BufferAllocator::BufferAllocator(mg::Display const& output, bool import_shm_through_udmabuf)
     : ctx{context_for_output(output)},
       egl_delegate{
           std::make_shared<mgc::EGLContextExecutor>(context_for_output(output))},
-      egl_extensions(std::make_shared<mg::EGLExtensions>())
+      egl_extensions(std::make_shared<mg::EGLExtensions>()),
+      import_shm_through_udmabuf{import_shm_through_udmabuf}
 {
 }
 
@@ -172,6 +174,8 @@ void mgg::BufferAllocator::bind_display(wl_display* display, std::shared_ptr<Exe
                     dpy,
                     egl_extensions,
                     modifier_ext,
+                    wayland_executor,
+                    egl_delegate,
                 },
                 [wayland_executor](LinuxDmaBufUnstable* global)
                 {
@@ -204,6 +208,12 @@ void mgg::BufferAllocator::bind_display(wl_display* display, std::shared_ptr<Exe
             "Detailed error: ");
     }
 
+    // Opt-in, as this keeps a duplicate of every sealed memfd clients create wl_shm pools from
+    if (import_shm_through_udmabuf)
+    {
+        mg::common::shm_udmabuf::install(display);
+    }
+
     this->wayland_executor = std::move(wayland_executor);
 }
 
@@ -225,19 +235,19 @@ std::shared_ptr<mg::Buffer> mgg::BufferAllocator::buffer_from_resource(
     std::function<void()>&& on_consumed,
     std::function<void()>&& on_release)
 {
-    auto context_guard = mir::raii::paired_calls(
-        [this]() { ctx->make_current(); },
-        [this]() { ctx->release_current(); });
-
+    // linux-dmabuf buffers are imported on the EGL delegate thread, so don't need our context
     if (auto dmabuf = dmabuf_extension->buffer_from_resource(
         buffer,
-        ctx,
         std::function<void()>{on_consumed},
-        std::function<void()>{on_release},
-        wayland_executor))
+        std::function<void()>{on_release}))
     {
         return dmabuf;
     }
+
+    auto context_guard = mir::raii::paired_calls(
+        [this]() { ctx->make_current(); },
+        [this]() { ctx->release_current(); });
+
     return mg::wayland::buffer_from_resource(
         buffer,
         std::move(on_consumed),
@@ -256,5 +266,6 @@ auto mgg::BufferAllocator::buffer_from_shm(
         buffer,
         std::move(wayland_executor),
         egl_delegate,
+        egl_extensions,
         std::move(on_consumed));
 }
@@ -67,7 +67,8 @@ class BufferAllocator:
     public graphics::GraphicBufferAllocator
 {
 public:
-    explicit BufferAllocator(Display const& output);
+    /// \a import_shm_through_udmabuf turns wl_shm buffers from sealed memfd pools into dmabufs rather than copying them
+    BufferAllocator(Display const& output, bool import_shm_through_udmabuf = false);
 
     std::shared_ptr<Buffer> alloc_software_buffer(geometry::Size size, MirPixelFormat) override;
     std::vector<MirPixelFormat> supported_pixel_formats() override;
@@ -88,6 +89,7 @@ private:
     std::shared_ptr<Executor> wayland_executor;
     std::unique_ptr<LinuxDmaBufUnstable, std::function<void(LinuxDmaBufUnstable*)>> dmabuf_extension;
     std::shared_ptr<EGLExtensions> const egl_extensions;
+    bool const import_shm_through_udmabuf;
     bool egl_display_bound{false};
 };
 
@@ -28,6 +28,7 @@
 
 #include <boost/exception/errinfo_errno.hpp>
 
+#include <algorithm>
 #include <stdexcept>
 #include <vector>
 
@@ -155,16 +156,19 @@ mgg::Cursor::Cursor(
         current_configuration(current_configuration)
 {
     // Generate the buffers for the initial configuration.
-    current_configuration->with_current_configuration_do(
-        [this](KMSDisplayConfiguration const& kms_conf)
-        {
-            kms_conf.for_each_output(
-                [this, &kms_conf](auto const& output)
-                {
-                    // I'm not sure why g++ needs the explicit "this->" but it does - alan_g
-                    this->buffer_for_output(*kms_conf.get_output_for(output.id));
-                });
-        });
+    {
+        std::lock_guard<std::mutex> lg(guard);
+        current_configuration->with_current_configuration_do(
+            [this, &lg](KMSDisplayConfiguration const& kms_conf)
+            {
+                kms_conf.for_each_output(
+                    [this, &lg, &kms_conf](auto const& output)
+                    {
+                        // I'm not sure why g++ needs the explicit "this->" but it does - alan_g
+                        this->buffer_for_output(lg, *kms_conf.get_output_for(output.id));
+                    });
+            });
+    }
 
     hide();
     if (last_set_failed)
@@ -190,25 +194,44 @@ void mgg::Cursor::write_buffer_data_locked(
     }
 }
 
-void mgg::Cursor::pad_and_write_image_data_locked(
-    std::lock_guard<std::mutex> const& lg,
-    GBMBOWrapper& buffer)
+auto mgg::Cursor::transformed_image_locked(
+    std::lock_guard<std::mutex> const&,
+    MirOrientation orientation,
+    uint32_t buffer_stride,
+    uint32_t buffer_height) -> std::vector<uint8_t> const&
 {
-    auto const orientation = buffer.orientation();
+    for (auto const& image : transformed_images)
+    {
+        if (image.orientation == orientation &&
+            image.buffer_stride == buffer_stride &&
+            image.buffer_height == buffer_height)
+        {
+            return image.data;
+        }
+    }
+
     bool const sideways = orientation == mir_orientation_left || orientation == mir_orientation_right;
 
     auto const min_width  = sideways ? min_buffer_width : min_buffer_height;
     auto const min_height = sideways ? min_buffer_height : min_buffer_width;
 
+    // An image that exactly fills the buffer (typical of animated cursors) is written as it is
+    if (orientation == mir_orientation_normal &&
+        size.width.as_uint32_t() <= min_width &&
+        size.height.as_uint32_t() <= min_height &&
+        size.width.as_uint32_t() * 4 == buffer_stride &&
+        size.height.as_uint32_t() == buffer_height)
+    {
+        return argb8888;
+    }
+
     auto const image_width = std::min(min_width, size.width.as_uint32_t());
     auto const image_height = std::min(min_height, size.height.as_uint32_t());
     auto const image_stride = size.width.as_uint32_t() * 4;
 
-    auto const buffer_stride = std::max(min_width*4, gbm_bo_get_stride(buffer));  // in bytes
-    auto const buffer_height = std::max(min_height, gbm_bo_get_height(buffer));
     size_t const padded_size = buffer_stride * buffer_height;
 
-    auto padded = std::unique_ptr<uint8_t[]>(new uint8_t[padded_size]);
+    std::vector<uint8_t> padded(padded_size);
     size_t rhs_padding = buffer_stride - 4*image_width;
 
     auto const filler = 0; // 0x3f; is useful to make buffer visible for debugging
@@ -272,24 +295,56 @@ void mgg::Cursor::pad_and_write_image_data_locked(
         break;
     }
 
-    write_buffer_data_locked(lg, buffer, &padded[0], padded_size);
+    transformed_images.push_back(TransformedImage{orientation, buffer_stride, buffer_height, std::move(padded)});
+    return transformed_images.back().data;
+}
+
+void mgg::Cursor::pad_and_write_image_data_locked(
+    std::lock_guard<std::mutex> const& lg,
+    GBMBOWrapper& buffer)
+{
+    auto const orientation = buffer.orientation();
+    bool const sideways = orientation == mir_orientation_left || orientation == mir_orientation_right;
+
+    auto const min_width  = sideways ? min_buffer_width : min_buffer_height;
+    auto const min_height = sideways ? min_buffer_height : min_buffer_width;
+
+    auto const buffer_stride = std::max(min_width*4, gbm_bo_get_stride(buffer));  // in bytes
+    auto const buffer_height = std::max(min_height, gbm_bo_get_height(buffer));
+
+    auto const& padded = transformed_image_locked(lg, orientation, buffer_stride, buffer_height);
+
+    write_buffer_data_locked(lg, buffer, padded.data(), padded.size());
 }
 
 void mgg::Cursor::show(CursorImage const& cursor_image)
 {
     std::lock_guard<std::mutex> lg(guard);
 
-    size = cursor_image.size();
+    auto const new_size = cursor_image.size();
+    auto const new_data = static_cast<uint8_t const*>(cursor_image.as_argb_8888());
+    size_t const new_data_size = new_size.width.as_uint32_t() * new_size.height.as_uint32_t() * 4;
 
-    argb8888.resize(size.width.as_uint32_t() * size.height.as_uint32_t() * 4);
-    memcpy(argb8888.data(), cursor_image.as_argb_8888(), argb8888.size());
+    bool const image_unchanged =
+        new_size == size &&
+        cursor_image.hotspot() == hotspot &&
+        std::equal(argb8888.begin(), argb8888.end(), new_data, new_data + new_data_size);
 
-    hotspot = cursor_image.hotspot();
+    // The buffers already hold this image, so there's nothing to transform or upload
+    if (!image_unchanged)
     {
-        auto locked_buffers = buffers.lock();
-        for (auto& tuple : *locked_buffers)
+        size = new_size;
+
+        argb8888.assign(new_data, new_data + new_data_size);
+
+        hotspot = cursor_image.hotspot();
+        transformed_images.clear();
         {
-            pad_and_write_image_data_locked(lg, std::get<2>(tuple));
+            auto locked_buffers = buffers.lock();
+            for (auto& tuple : *locked_buffers)
+            {
+                pad_and_write_image_data_locked(lg, std::get<2>(tuple));
+            }
         }
     }
 
@@ -405,7 +460,7 @@ void mgg::Cursor::place_cursor_at_locked(
             // work on radeon and intel. There also seems to be precedent in weston for
             // implementing hotspot in this fashion.
             output.move_cursor(position_on_output - hotspot_displacement);
-            auto& buffer = buffer_for_output(output);
+            auto& buffer = buffer_for_output(lg, output);
 
             auto const changed_orientation = buffer.change_orientation(orientation);
 
@@ -430,7 +485,9 @@ void mgg::Cursor::place_cursor_at_locked(
     last_set_failed = !set_on_all_outputs;
 }
 
-mgg::Cursor::GBMBOWrapper& mgg::Cursor::buffer_for_output(KMSOutput const& output)
+mgg::Cursor::GBMBOWrapper& mgg::Cursor::buffer_for_output(
+    std::lock_guard<std::mutex> const& lg,
+    KMSOutput const& output)
 {
     auto const drm_fd = output.drm_fd();
     auto const id = output.id();
@@ -446,13 +503,38 @@ mgg::Cursor::GBMBOWrapper& mgg::Cursor::buffer_for_output(KMSOutput const& outpu
     locked_buffers->push_back(image_buffer{id, drm_fd, GBMBOWrapper{drm_fd, mir_orientation_normal}});
 
     GBMBOWrapper& bo = std::get<2>(locked_buffers->back());
+    bool min_buffer_size_changed{false};
     if (gbm_bo_get_width(bo) < min_buffer_width)
     {
         min_buffer_width = gbm_bo_get_width(bo);
+        min_buffer_size_changed = true;
     }
     if (gbm_bo_get_height(bo) < min_buffer_height)
     {
         min_buffer_height = gbm_bo_get_height(bo);
+        min_buffer_size_changed = true;
+    }
+
+    // show() only writes the buffers that exist at the time, so bring this one up to date
+    if (!argb8888.empty())
+    {
+        if (min_buffer_size_changed)
+        {
+            // The image is cropped to the smallest buffer, so every buffer needs it again
+            transformed_images.clear();
+            for (auto& tuple : *locked_buffers)
+            {
+                pad_and_write_image_data_locked(lg, std::get<2>(tuple));
+            }
+        }
+        else
+        {
+            pad_and_write_image_data_locked(lg, bo);
+        }
+    }
+    else if (min_buffer_size_changed)
+    {
+        transformed_images.clear();
     }
 
     return bo;
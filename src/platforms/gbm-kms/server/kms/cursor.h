@@ -97,9 +97,14 @@ private:
     void pad_and_write_image_data_locked(
         std::lock_guard<std::mutex> const&,
         GBMBOWrapper& buffer);
+    auto transformed_image_locked(
+        std::lock_guard<std::mutex> const&,
+        MirOrientation orientation,
+        uint32_t buffer_stride,
+        uint32_t buffer_height) -> std::vector<uint8_t> const&;
     void clear(std::lock_guard<std::mutex> const&);
 
-    GBMBOWrapper& buffer_for_output(KMSOutput const& output);
+    GBMBOWrapper& buffer_for_output(std::lock_guard<std::mutex> const&, KMSOutput const& output);
     
     std::mutex guard;
 
@@ -109,6 +114,17 @@ private:
     geometry::Size size;
     std::vector<uint8_t> argb8888;
 
+    // The current image padded and rotated to suit a buffer, prepared once per
+    // image and shared by every output with the same orientation and buffer layout
+    struct TransformedImage
+    {
+        MirOrientation orientation;
+        uint32_t buffer_stride;
+        uint32_t buffer_height;
+        std::vector<uint8_t> data;
+    };
+    std::vector<TransformedImage> transformed_images;
+
     bool visible;
     bool last_set_failed;
 
@@ -502,6 +502,7 @@ void mgg::Display::configure_locked(
                     auto const mode_index = kms_conf.get_kms_mode_index(conf_output.id,
                                                                   conf_output.current_mode_index);
                     kms_output->configure(conf_output.top_left - bounding_rect.top_left, mode_index);
+                    kms_output->allow_adaptive_sync(conf_output.adaptive_sync);
                     if (!comp)
                     {
                         kms_output->set_power_mode(conf_output.power_mode);
@@ -525,40 +526,10 @@ void mgg::Display::configure_locked(
             }
             else
             {
-                uint32_t const width  = current_mode_resolution.width.as_uint32_t();
-                uint32_t const height = current_mode_resolution.height.as_uint32_t();
-
                 for (auto const& group : kms_output_groups)
                 {
-                    /*
-                     * In a hybrid setup a scanout surface needs to be allocated differently if it
-                     * needs to be able to be shared across GPUs. This likely reduces performance.
-                     *
-                     * As a first cut, assume every scanout buffer in a hybrid setup might need
-                     * to be shared.
-                     */
-                    auto surface = gbm->create_scanout_surface(width, height, drm.size() != 1);
-                    auto const raw_surface = surface.get();
-
-                    auto db = std::make_unique<DisplayBuffer>(
-                        bypass_option,
-                        listener,
-                        group,
-                        GBMOutputSurface{
-                            group.front()->drm_fd(),
-                            std::move(surface),
-                            width, height,
-                            helpers::EGLHelper{
-                                *gl_config,
-                                *gbm,
-                                raw_surface,
-                                shared_egl.context()
-                            }
-                        },
-                        bounding_rect,
-                        transformation);
-
-                    display_buffers_new.push_back(std::move(db));
+                    display_buffers_new.push_back(
+                        create_display_buffer(group, current_mode_resolution, bounding_rect, transformation));
                 }
             }
         });
@@ -568,8 +539,279 @@ void mgg::Display::configure_locked(
 
     /* Store applied configuration */
     current_display_configuration = kms_conf;
+    ++configuration_generation;
 
     if (!comp)
         /* Clear connected but unused outputs */
         clear_connected_unused_outputs();
 }
+
+auto mgg::Display::create_display_buffer(
+    std::vector<std::shared_ptr<KMSOutput>> const& outputs,
+    geom::Size const& mode_resolution,
+    geom::Rectangle const& bounding_rect,
+    glm::mat2 const& transformation) -> std::unique_ptr<DisplayBuffer>
+{
+    uint32_t const width  = mode_resolution.width.as_uint32_t();
+    uint32_t const height = mode_resolution.height.as_uint32_t();
+
+    /*
+     * In a hybrid setup a scanout surface needs to be allocated differently if it
+     * needs to be able to be shared across GPUs. This likely reduces performance.
+     *
+     * As a first cut, assume every scanout buffer in a hybrid setup might need
+     * to be shared.
+     */
+    auto surface = gbm->create_scanout_surface(width, height, drm.size() != 1);
+    auto const raw_surface = surface.get();
+
+    return std::make_unique<DisplayBuffer>(
+        bypass_option,
+        listener,
+        outputs,
+        GBMOutputSurface{
+            outputs.front()->drm_fd(),
+            std::move(surface),
+            width, height,
+            helpers::EGLHelper{
+                *gl_config,
+                *gbm,
+                raw_surface,
+                shared_egl.context()
+            }
+        },
+        bounding_rect,
+        transformation);
+}
+
+bool mgg::Display::apply_keeping_unchanged_sync_groups(
+    mg::DisplayConfiguration const& conf,
+    std::function<void(mg::DisplaySyncGroup&)> const& before_removal)
+{
+    if (!conf.valid())
+    {
+        BOOST_THROW_EXCEPTION(
+            std::logic_error("Invalid or inconsistent display configuration"));
+    }
+
+    auto const& kms_conf = dynamic_cast<RealKMSDisplayConfiguration const&>(conf);
+
+    struct NewDisplayBuffer
+    {
+        std::vector<std::shared_ptr<KMSOutput>> outputs;
+        std::vector<DisplayConfigurationOutput> conf_outputs;
+        geom::Size mode_resolution;
+        geom::Rectangle bounding_rect;
+        glm::mat2 transformation;
+        DisplayBuffer* keep;
+        std::unique_ptr<DisplayBuffer> kept;
+        std::unique_ptr<DisplayBuffer> created;
+    };
+
+    std::vector<NewDisplayBuffer> planned;
+    std::vector<DisplayBuffer*> removed;
+    uint64_t planned_for_generation;
+
+    {
+        std::lock_guard<decltype(configuration_mutex)> lock{configuration_mutex};
+
+        // Nothing to gain here: configure() would keep all the DisplayBuffers anyway
+        if (compatible(current_display_configuration, kms_conf))
+            return false;
+
+        auto const output_unchanged = [this](DisplayConfigurationOutput const& conf_output)
+            {
+                bool unchanged{false};
+                current_display_configuration.for_each_output(
+                    [&](DisplayConfigurationOutput const& current_output)
+                    {
+                        if (current_output.id == conf_output.id)
+                            unchanged = (current_output == conf_output);
+                    });
+                return unchanged;
+            };
+
+        /* Work out the DisplayBuffers the new configuration needs, as configure_locked() would */
+        OverlappingOutputGrouping grouping{kms_conf};
+
+        grouping.for_each_group(
+            [&](OverlappingOutputGroup const& group)
+            {
+                auto const first = planned.size();
+                bool group_unchanged{true};
+                glm::mat2 transformation;
+                geom::Size current_mode_resolution;
+
+                group.for_each_output(
+                    [&](DisplayConfigurationOutput const& conf_output)
+                    {
+                        auto kms_output = current_display_configuration.get_output_for(conf_output.id);
+                        group_unchanged &= output_unchanged(conf_output);
+
+                        auto const matching_drm_device = std::find_if(
+                            planned.begin() + first, planned.end(),
+                            [&](NewDisplayBuffer const& candidate)
+                            {
+                                return candidate.outputs.front()->drm_fd() == kms_output->drm_fd();
+                            });
+
+                        if (matching_drm_device != planned.end())
+                        {
+                            matching_drm_device->outputs.push_back(std::move(kms_output));
+                            matching_drm_device->conf_outputs.push_back(conf_output);
+                        }
+                        else
+                        {
+                            planned.push_back({{std::move(kms_output)}, {conf_output}, {}, {}, {}, nullptr, {}, {}});
+                        }
+
+                        transformation = conf_output.transformation();
+                        if (conf_output.current_mode_index < conf_output.modes.size())
+                            current_mode_resolution = conf_output.modes[conf_output.current_mode_index].size;
+                    });
+
+                for (auto i = first; i != planned.size(); ++i)
+                {
+                    auto& db = planned[i];
+
+                    db.bounding_rect = group.bounding_rectangle();
+                    db.transformation = transformation;
+                    db.mode_resolution = current_mode_resolution;
+
+                    if (group_unchanged)
+                    {
+                        auto const existing = std::find_if(
+                            display_buffers.begin(), display_buffers.end(),
+                            [&](std::unique_ptr<DisplayBuffer> const& candidate)
+                            {
+                                return candidate && candidate->drives(db.outputs);
+                            });
+
+                        if (existing != display_buffers.end())
+                            db.keep = existing->get();
+                    }
+                }
+            });
+
+        if (std::none_of(planned.begin(), planned.end(), [](auto const& db) { return db.keep != nullptr; }))
+            return false;
+
+        planned_for_generation = configuration_generation;
+        for (auto const& db : display_buffers)
+        {
+            bool const kept = std::any_of(
+                planned.begin(), planned.end(),
+                [&db](NewDisplayBuffer const& candidate) { return candidate.keep == db.get(); });
+
+            if (!kept)
+                removed.push_back(db.get());
+        }
+    }
+
+    /* The compositor waits for its threads to finish with the groups, and they may need
+     * configuration_mutex (e.g. for_each_display_sync_group()) to get there */
+    for (auto const db : removed)
+        before_removal(*db);
+
+    {
+        std::lock_guard<decltype(configuration_mutex)> lock{configuration_mutex};
+
+        /* If the configuration was changed meanwhile the plan is stale, and nothing has been
+         * destroyed yet, so a full configure() can still recover */
+        if (configuration_generation != planned_for_generation)
+            return false;
+
+        for (auto& db : planned)
+        {
+            if (db.keep)
+            {
+                auto const existing = std::find_if(
+                    display_buffers.begin(), display_buffers.end(),
+                    [&db](std::unique_ptr<DisplayBuffer> const& candidate) { return candidate.get() == db.keep; });
+                db.kept = std::move(*existing);
+            }
+        }
+
+        /* Everything still in display_buffers is going away */
+        for (auto& db : display_buffers)
+        {
+            if (db)
+                db->wait_for_page_flip();
+        }
+
+        /* Reset the state of outputs not driven by a kept DisplayBuffer */
+        kms_conf.for_each_output(
+            [&](DisplayConfigurationOutput const& conf_output)
+            {
+                auto kms_output = current_display_configuration.get_output_for(conf_output.id);
+                bool const kept = std::any_of(
+                    planned.begin(), planned.end(),
+                    [&](NewDisplayBuffer const& db)
+                    {
+                        return db.kept &&
+                            std::find(db.outputs.begin(), db.outputs.end(), kms_output) != db.outputs.end();
+                    });
+
+                if (!kept)
+                {
+                    kms_output->clear_cursor();
+                    kms_output->reset();
+                }
+            });
+
+        std::vector<std::unique_ptr<DisplayBuffer>> display_buffers_new;
+
+        try
+        {
+            for (auto& db : planned)
+            {
+                if (db.kept)
+                    continue;
+
+                for (auto i = 0u; i != db.outputs.size(); ++i)
+                {
+                    auto const& conf_output = db.conf_outputs[i];
+                    auto const& kms_output = db.outputs[i];
+                    auto const mode_index =
+                        kms_conf.get_kms_mode_index(conf_output.id, conf_output.current_mode_index);
+
+                    kms_output->configure(conf_output.top_left - db.bounding_rect.top_left, mode_index);
+                    kms_output->allow_adaptive_sync(conf_output.adaptive_sync);
+                    kms_output->set_power_mode(conf_output.power_mode);
+                    kms_output->set_gamma(conf_output.gamma);
+                }
+
+                db.created = create_display_buffer(
+                    db.outputs, db.mode_resolution, db.bounding_rect, db.transformation);
+            }
+        }
+        catch (...)
+        {
+            /* Leave display_buffers whole, so that a full configure() can recover */
+            for (auto& db : planned)
+            {
+                if (db.kept)
+                    display_buffers.push_back(std::move(db.kept));
+            }
+            display_buffers.erase(
+                std::remove(display_buffers.begin(), display_buffers.end(), nullptr),
+                display_buffers.end());
+            throw;
+        }
+
+        for (auto& db : planned)
+            display_buffers_new.push_back(db.kept ? std::move(db.kept) : std::move(db.created));
+
+        display_buffers = std::move(display_buffers_new);
+
+        /* Store applied configuration */
+        current_display_configuration = kms_conf;
+        ++configuration_generation;
+
+        /* Clear connected but unused outputs */
+        clear_connected_unused_outputs();
+    }
+
+    if (auto c = cursor.lock()) c->resume();
+    return true;
+}
@@ -27,6 +27,8 @@
 #include "egl_helper.h"
 #include "platform_common.h"
 
+#include <glm/glm.hpp>
+
 #include <atomic>
 #include <mutex>
 #include <vector>
@@ -37,6 +39,7 @@ class ConsoleServices;
 namespace geometry
 {
 struct Rectangle;
+struct Size;
 }
 namespace graphics
 {
@@ -79,6 +82,9 @@ public:
     std::unique_ptr<DisplayConfiguration> configuration() const override;
     bool apply_if_configuration_preserves_display_buffers(DisplayConfiguration const& conf) override;
     void configure(DisplayConfiguration const& conf) override;
+    bool apply_keeping_unchanged_sync_groups(
+        DisplayConfiguration const& conf,
+        std::function<void(graphics::DisplaySyncGroup&)> const& before_removal) override;
 
     void register_configuration_change_handler(
         EventHandlerRegister& handlers,
@@ -113,10 +119,18 @@ private:
     std::shared_ptr<KMSOutputContainer> const output_container;
     mutable RealKMSDisplayConfiguration current_display_configuration;
     mutable std::atomic<bool> dirty_configuration;
+    /// Bumped whenever a configuration is applied, so work planned before dropping
+    /// configuration_mutex can tell whether it is out of date
+    uint64_t configuration_generation{0};
 
     void configure_locked(
         RealKMSDisplayConfiguration const& conf,
         std::lock_guard<decltype(configuration_mutex)> const&);
+    auto create_display_buffer(
+        std::vector<std::shared_ptr<KMSOutput>> const& outputs,
+        geometry::Size const& mode_resolution,
+        geometry::Rectangle const& bounding_rect,
+        glm::mat2 const& transformation) -> std::unique_ptr<DisplayBuffer>;
 
     BypassOption bypass_option;
     std::weak_ptr<Cursor> cursor;
@@ -526,11 +526,15 @@ void mgg::DisplayBuffer::set_transformation(glm::mat2 const& t, geometry::Rectan
 bool mgg::DisplayBuffer::overlay(RenderableList const& renderable_list)
 {
     glm::mat2 static const no_transformation(1);
+    mgg::BypassMatch bypass_match(area);
+    auto bypass_it = std::find_if(renderable_list.rbegin(), renderable_list.rend(), bypass_match);
+
+    // A single opaque surface covers the display, whether or not we can bypass it
+    fullscreen_frame = (bypass_it != renderable_list.rend());
+
     if (transform == no_transformation &&
        (bypass_option == mgg::BypassOption::allowed))
     {
-        mgg::BypassMatch bypass_match(area);
-        auto bypass_it = std::find_if(renderable_list.rbegin(), renderable_list.rend(), bypass_match);
         if (bypass_it != renderable_list.rend())
         {
             auto bypass_buffer = (*bypass_it)->buffer();
@@ -608,6 +612,16 @@ void mgg::DisplayBuffer::post()
     }
 
     scheduled_fb = std::move(bufobj);
+
+    /*
+     * Fullscreen clients (typically games and video) pace their own frames,
+     * so where the output supports it let the display refresh as soon as
+     * each of their frames is flipped rather than on a fixed cadence.
+     * Clone groups don't use adaptive sync as their outputs would disagree
+     * about when to refresh.
+     */
+    bool const adaptive_sync = outputs.size() == 1 && outputs.front()->set_adaptive_sync(fullscreen_frame);
+
     /*
      * Try to schedule a page flip as first preference to avoid tearing.
      * [will complete in a background thread]
@@ -675,8 +689,12 @@ void mgg::DisplayBuffer::post()
     bypass_buf = nullptr;
     bypass_bufobj = nullptr;
 
+    /*
+     * With adaptive sync there's no fixed cadence to wait for: the next flip
+     * will be shown as soon as the next frame is ready.
+     */
     recommend_sleep = 0ms;
-    if (outputs.size() == 1)
+    if (outputs.size() == 1 && !adaptive_sync)
     {
         auto const& output = outputs.front();
         auto const min_frame_interval = 1000ms / output->max_refresh_rate();
@@ -705,6 +723,11 @@ bool mgg::DisplayBuffer::schedule_page_flip(FBHandle const& bufobj)
     return page_flips_pending;
 }
 
+bool mgg::DisplayBuffer::drives(std::vector<std::shared_ptr<KMSOutput>> const& outputs) const
+{
+    return this->outputs == outputs;
+}
+
 void mgg::DisplayBuffer::wait_for_page_flip()
 {
     if (page_flips_pending)
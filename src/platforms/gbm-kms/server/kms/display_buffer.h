@@ -125,6 +125,7 @@ public:
     void set_transformation(glm::mat2 const& t, geometry::Rectangle const& a);
     void schedule_set_crtc();
     void wait_for_page_flip();
+    bool drives(std::vector<std::shared_ptr<KMSOutput>> const& outputs) const;
 
 private:
     bool schedule_page_flip(FBHandle const& bufobj);
@@ -157,6 +158,7 @@ private:
     glm::mat2 transform;
     std::atomic<bool> needs_set_crtc;
     std::chrono::milliseconds recommend_sleep{0};
+    bool fullscreen_frame{false};
     bool page_flips_pending;
 };
 
@@ -65,6 +65,23 @@ public:
      */
     virtual int max_refresh_rate() const = 0;
 
+    /**
+     * Whether the display configuration permits variable refresh on this output.
+     *
+     * Adaptive sync is only engaged (by set_adaptive_sync()) while it is allowed.
+     */
+    virtual void allow_adaptive_sync(bool allowed) = 0;
+    /**
+     * Engage or disengage variable refresh on this output's CRTC.
+     *
+     * While engaged the display refreshes as soon as each page flip arrives
+     * (up to max_refresh_rate()) rather than on a fixed cadence.
+     *
+     * \return  True if variable refresh is now engaged; false if \a active
+     *          is false, or if it's not allowed or not supported by the hardware.
+     */
+    virtual bool set_adaptive_sync(bool active) = 0;
+
     virtual bool set_crtc(FBHandle const& fb) = 0;
     virtual void clear_crtc() = 0;
     virtual bool schedule_page_flip(FBHandle const& fb) = 0;
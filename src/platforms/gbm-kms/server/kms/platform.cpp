@@ -62,10 +62,15 @@ mgg::Platform::Platform(std::shared_ptr<DisplayReport> const& listener,
 {
 }
 
+mgg::RenderingPlatform::RenderingPlatform(bool import_shm_through_udmabuf)
+    : import_shm_through_udmabuf{import_shm_through_udmabuf}
+{
+}
+
 mir::UniqueModulePtr<mg::GraphicBufferAllocator> mgg::RenderingPlatform::create_buffer_allocator(
     mg::Display const& output)
 {
-    return make_module_ptr<mgg::BufferAllocator>(output);
+    return make_module_ptr<mgg::BufferAllocator>(output, import_shm_through_udmabuf);
 }
 
 mir::UniqueModulePtr<mg::Display> mgg::Platform::create_display(
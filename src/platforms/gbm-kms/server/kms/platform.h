@@ -63,8 +63,14 @@ private:
 
 class RenderingPlatform : public graphics::RenderingPlatform
 {
+public:
+    explicit RenderingPlatform(bool import_shm_through_udmabuf);
+
     auto create_buffer_allocator(
         graphics::Display const& output) -> UniqueModulePtr<graphics::GraphicBufferAllocator> override;
+
+private:
+    bool const import_shm_through_udmabuf;
 };
 
 }
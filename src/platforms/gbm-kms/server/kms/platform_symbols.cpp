@@ -51,6 +51,7 @@ namespace mo = mir::options;
 namespace
 {
 char const* bypass_option_name{"bypass"};
+char const* shm_udmabuf_option_name{"shm-udmabuf"};
 char const* host_socket{"host-socket"};
 
 }
@@ -80,12 +81,12 @@ mir::UniqueModulePtr<mg::DisplayPlatform> create_display_platform(
 }
 
 auto create_rendering_platform(
-    mo::Option const&,
+    mo::Option const& options,
     mir::EmergencyCleanupRegistry&) -> mir::UniqueModulePtr<mg::RenderingPlatform>
 {
     mir::assert_entry_point_signature<mg::CreateRenderPlatform>(&create_rendering_platform);
 
-    return mir::make_module_ptr<mgg::RenderingPlatform>();
+    return mir::make_module_ptr<mgg::RenderingPlatform>(options.get<bool>(shm_udmabuf_option_name));
 }
 
 void add_graphics_platform_options(boost::program_options::options_description& config)
@@ -94,7 +95,11 @@ void add_graphics_platform_options(boost::program_options::options_description&
     config.add_options()
         (bypass_option_name,
          boost::program_options::value<bool>()->default_value(false),
-         "[platform-specific] utilize the bypass optimization for fullscreen surfaces.");
+         "[platform-specific] utilize the bypass optimization for fullscreen surfaces.")
+        (shm_udmabuf_option_name,
+         boost::program_options::value<bool>()->default_value(false),
+         "[platform-specific] import wl_shm buffers from sealed memfd pools through /dev/udmabuf instead of copying "
+         "them. Keeps each such pool's memory pinned until its last buffer is destroyed.");
     mgg::Quirks::add_quirks_option(config);
 }
 
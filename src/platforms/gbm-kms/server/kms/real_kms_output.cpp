@@ -58,6 +58,21 @@ private:
     uint32_t const fb_id;
 };
 
+namespace
+{
+bool connector_is_vrr_capable(int drm_fd, uint32_t connector_id)
+{
+    try
+    {
+        mgk::ObjectProperties connector_props{drm_fd, connector_id, DRM_MODE_OBJECT_CONNECTOR};
+        return connector_props.has_property("vrr_capable") && connector_props["vrr_capable"];
+    }
+    catch (std::exception const&)
+    {
+        return false;
+    }
+}
+}
 
 mgg::RealKMSOutput::RealKMSOutput(
     int drm_fd,
@@ -71,7 +86,10 @@ mgg::RealKMSOutput::RealKMSOutput(
       saved_crtc(),
       using_saved_crtc{true},
       has_cursor_{false},
-      power_mode(mir_power_mode_on)
+      power_mode(mir_power_mode_on),
+      vrr_capable{false},
+      adaptive_sync_allowed{false},
+      vrr_enabled_crtc_id{0}
 {
     reset();
 
@@ -89,6 +107,7 @@ mgg::RealKMSOutput::RealKMSOutput(
 
 mgg::RealKMSOutput::~RealKMSOutput()
 {
+    disengage_adaptive_sync();
     restore_saved_crtc();
 }
 
@@ -126,7 +145,10 @@ void mgg::RealKMSOutput::reset()
         }
     }
 
+    vrr_capable = connector_is_vrr_capable(drm_fd_, connector->connector_id);
+
     /* Discard previously current crtc */
+    disengage_adaptive_sync();
     current_crtc = nullptr;
 }
 
@@ -145,6 +167,77 @@ int mgg::RealKMSOutput::max_refresh_rate() const
     return current_mode.vrefresh;
 }
 
+void mgg::RealKMSOutput::allow_adaptive_sync(bool allowed)
+{
+    adaptive_sync_allowed = allowed;
+}
+
+bool mgg::RealKMSOutput::set_adaptive_sync(bool active)
+{
+    bool const engage = active && adaptive_sync_allowed && vrr_capable && current_crtc;
+    uint32_t const crtc_id = engage ? current_crtc->crtc_id : 0;
+
+    if (crtc_id == vrr_enabled_crtc_id)
+        return engage;
+
+    disengage_adaptive_sync();
+
+    if (engage)
+    {
+        if (set_vrr_enabled(crtc_id, true))
+        {
+            vrr_enabled_crtc_id = crtc_id;
+        }
+        else
+        {
+            // Don't retry every frame; reset() or refresh_hardware_state() will re-probe
+            vrr_capable = false;
+        }
+    }
+
+    return vrr_enabled_crtc_id != 0;
+}
+
+bool mgg::RealKMSOutput::set_vrr_enabled(uint32_t crtc_id, bool enabled)
+{
+    try
+    {
+        mgk::ObjectProperties crtc_props{drm_fd_, crtc_id, DRM_MODE_OBJECT_CRTC};
+        if (!crtc_props.has_property("VRR_ENABLED"))
+        {
+            mir::log_info("Output %s is adaptive sync capable, but its CRTC has no VRR_ENABLED property",
+                          mgk::connector_name(connector).c_str());
+            return false;
+        }
+
+        if (auto const result = drmModeObjectSetProperty(
+                drm_fd_, crtc_id, DRM_MODE_OBJECT_CRTC, crtc_props.id_for("VRR_ENABLED"), enabled))
+        {
+            mir::log_warning("Failed to %s adaptive sync on output %s: %s",
+                             enabled ? "enable" : "disable",
+                             mgk::connector_name(connector).c_str(),
+                             strerror(-result));
+            return false;
+        }
+    }
+    catch (std::exception const& e)
+    {
+        mir::log_warning("Failed to query CRTC properties for adaptive sync: %s", e.what());
+        return false;
+    }
+
+    return true;
+}
+
+void mgg::RealKMSOutput::disengage_adaptive_sync()
+{
+    if (vrr_enabled_crtc_id)
+    {
+        set_vrr_enabled(vrr_enabled_crtc_id, false);
+        vrr_enabled_crtc_id = 0;
+    }
+}
+
 void mgg::RealKMSOutput::configure(geom::Displacement offset, size_t kms_mode_index)
 {
     fb_offset = offset;
@@ -191,6 +284,8 @@ void mgg::RealKMSOutput::clear_crtc()
         return;
     }
 
+    disengage_adaptive_sync();
+
     auto result = drmModeSetCrtc(drm_fd_, current_crtc->crtc_id,
                                  0, 0, 0, nullptr, 0, nullptr);
     if (result)
@@ -389,6 +484,7 @@ void mgg::RealKMSOutput::set_gamma(mg::GammaCurves const& gamma)
 void mgg::RealKMSOutput::refresh_hardware_state()
 {
     connector = kms::get_connector(drm_fd_, connector->connector_id);
+    vrr_capable = connector_is_vrr_capable(drm_fd_, connector->connector_id);
     current_crtc = nullptr;
 
     if (connector->encoder_id)
@@ -543,6 +639,7 @@ void mgg::RealKMSOutput::update_from_hardware_state(
         kms_connector_type_to_output_type(connector->connector_type)};
     geom::Size physical_size{connector->mmWidth, connector->mmHeight};
     bool connected{connector->connection == DRM_MODE_CONNECTED};
+    bool const adaptive_sync_capable{connected && vrr_capable};
     uint32_t const invalid_mode_index = std::numeric_limits<uint32_t>::max();
     uint32_t current_mode_index{invalid_mode_index};
     uint32_t preferred_mode_index{invalid_mode_index};
@@ -612,6 +709,13 @@ void mgg::RealKMSOutput::update_from_hardware_state(
     output.subpixel_arrangement = kms_subpixel_to_mir_subpixel(connector->subpixel);
     output.gamma = gamma;
     output.edid = edid;
+
+    if (output.adaptive_sync_capable != adaptive_sync_capable)
+    {
+        // Use adaptive sync wherever it's newly available, unless later configured otherwise
+        output.adaptive_sync = adaptive_sync_capable;
+    }
+    output.adaptive_sync_capable = adaptive_sync_capable;
 }
 
 namespace
@@ -23,6 +23,7 @@
 #include "kms_output.h"
 #include "kms-utils/drm_mode_resources.h"
 
+#include <atomic>
 #include <memory>
 #include <mutex>
 
@@ -50,6 +51,8 @@ public:
     void configure(geometry::Displacement fb_offset, size_t kms_mode_index) override;
     geometry::Size size() const override;
     int max_refresh_rate() const override;
+    void allow_adaptive_sync(bool allowed) override;
+    bool set_adaptive_sync(bool active) override;
 
     bool set_crtc(FBHandle const& fb) override;
     void clear_crtc() override;
@@ -78,6 +81,8 @@ public:
 private:
     bool ensure_crtc();
     void restore_saved_crtc();
+    bool set_vrr_enabled(uint32_t crtc_id, bool enabled);
+    void disengage_adaptive_sync();
 
     int const drm_fd_;
     std::shared_ptr<PageFlipper> const page_flipper;
@@ -108,6 +113,10 @@ private:
     MirPowerMode power_mode;
     int dpms_enum_id;
 
+    bool vrr_capable;
+    std::atomic<bool> adaptive_sync_allowed;
+    uint32_t vrr_enabled_crtc_id;   ///< The CRTC we have set VRR_ENABLED on, or 0
+
     std::mutex power_mutex;
 
     AtomicFrame last_frame_;
@@ -164,6 +164,8 @@ void mgx::BufferAllocator::bind_display(wl_display* display, std::shared_ptr<Exe
                     dpy,
                     egl_extensions,
                     modifier_ext,
+                    wayland_executor,
+                    egl_delegate,
                 },
                 [wayland_executor](LinuxDmaBufUnstable* global)
                 {
@@ -211,19 +213,19 @@ std::shared_ptr<mg::Buffer> mgx::BufferAllocator::buffer_from_resource(
     std::function<void()>&& on_consumed,
     std::function<void()>&& on_release)
 {
-    auto context_guard = mir::raii::paired_calls(
-        [this]() { ctx->make_current(); },
-        [this]() { ctx->release_current(); });
-
+    // linux-dmabuf buffers are imported on the EGL delegate thread, so don't need our context
     if (auto dmabuf = dmabuf_extension->buffer_from_resource(
         buffer,
-        ctx,
         std::function<void()>{on_consumed},
-        std::function<void()>{on_release},
-        wayland_executor))
+        std::function<void()>{on_release}))
     {
         return dmabuf;
     }
+
+    auto context_guard = mir::raii::paired_calls(
+        [this]() { ctx->make_current(); },
+        [this]() { ctx->release_current(); });
+
     return mg::wayland::buffer_from_resource(
         buffer,
         std::move(on_consumed),
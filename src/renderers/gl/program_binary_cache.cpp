@@ -0,0 +1,193 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "program_binary_cache.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace mrg = mir::renderer::gl;
+
+namespace
+{
+char const file_prefix[] = "gl-program-";
+}
+
+size_t const mrg::ProgramBinaryCache::default_max_size{8*1024*1024};
+
+mrg::ProgramBinaryCache::ProgramBinaryCache(std::string directory, size_t max_size) :
+    directory{std::move(directory)},
+    max_size{max_size}
+{
+}
+
+auto mrg::ProgramBinaryCache::default_directory() -> std::string
+{
+    if (getenv("MIR_DISABLE_GL_PROGRAM_CACHE"))
+        return {};
+
+    if (auto const xdg_cache_home = getenv("XDG_CACHE_HOME"))
+        return std::string{xdg_cache_home} + "/mir";
+
+    if (auto const home = getenv("HOME"))
+        return std::string{home} + "/.cache/mir";
+
+    return {};
+}
+
+auto mrg::ProgramBinaryCache::find(std::string const& key) -> std::shared_ptr<Binary const>
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto const cached = binaries.find(key);
+    if (cached != binaries.end())
+        return cached->second;
+
+    if (directory.empty())
+        return nullptr;
+
+    auto const file = file_for(key);
+    std::ifstream in{file, std::ios::binary};
+    uint32_t key_size{0};
+    if (!in.read(reinterpret_cast<char*>(&key_size), sizeof key_size) || key_size != key.size())
+        return nullptr;
+
+    std::string stored_key(key_size, '\0');
+    auto binary = std::make_shared<Binary>();
+    if (!in.read(&stored_key[0], key_size) || stored_key != key ||
+        !in.read(reinterpret_cast<char*>(&binary->format), sizeof binary->format))
+        return nullptr;
+
+    binary->data.assign(std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{});
+    if (binary->data.empty())
+        return nullptr;
+
+    // Mark it as recently used, so trim_directory() evicts something else
+    utimensat(AT_FDCWD, file.c_str(), nullptr, 0);
+
+    return binaries[key] = std::move(binary);
+}
+
+void mrg::ProgramBinaryCache::store(std::string const& key, Binary&& binary)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (!directory.empty() && ensure_directory_exists())
+    {
+        // Write to a temporary file and rename it so that a concurrent reader never sees a partial file
+        auto const file = file_for(key);
+        auto const temp_file = file + "." + std::to_string(getpid());
+        bool written{false};
+        {
+            std::ofstream out{temp_file, std::ios::binary | std::ios::trunc};
+            uint32_t const key_size = key.size();
+            out.write(reinterpret_cast<char const*>(&key_size), sizeof key_size);
+            out.write(key.data(), key.size());
+            out.write(reinterpret_cast<char const*>(&binary.format), sizeof binary.format);
+            out.write(binary.data.data(), binary.data.size());
+
+            // A full or read-only disk must not leave a truncated binary in place of a good one
+            if (out)
+            {
+                out.close();
+                written = !out.fail();
+            }
+        }
+
+        if (!written || rename(temp_file.c_str(), file.c_str()) != 0)
+            unlink(temp_file.c_str());
+        else
+            trim_directory(file);
+    }
+
+    // Anyone still holding the binary this replaces keeps their copy
+    binaries[key] = std::make_shared<Binary const>(std::move(binary));
+}
+
+auto mrg::ProgramBinaryCache::ensure_directory_exists() const -> bool
+{
+    auto const parent = directory.substr(0, directory.rfind('/'));
+    mkdir(parent.c_str(), 0700);
+    return mkdir(directory.c_str(), 0700) == 0 || errno == EEXIST;
+}
+
+auto mrg::ProgramBinaryCache::file_for(std::string const& key) const -> std::string
+{
+    std::stringstream name;
+    name << directory << "/" << file_prefix << std::hex << std::hash<std::string>{}(key);
+    return name.str();
+}
+
+void mrg::ProgramBinaryCache::trim_directory(std::string const& keep) const
+{
+    struct Entry
+    {
+        std::string path;
+        timespec last_used;
+        off_t size;
+    };
+
+    std::vector<Entry> entries;
+    off_t total_size{0};
+
+    auto const dir = opendir(directory.c_str());
+    if (!dir)
+        return;
+
+    while (auto const entry = readdir(dir))
+    {
+        std::string const name{entry->d_name};
+        // Skip anything that isn't ours, and other processes' temporary files
+        if (name.compare(0, sizeof file_prefix - 1, file_prefix) != 0 || name.find('.') != std::string::npos)
+            continue;
+
+        auto const path = directory + "/" + name;
+        struct stat file_stat;
+        if (stat(path.c_str(), &file_stat) != 0)
+            continue;
+
+        total_size += file_stat.st_size;
+        if (path != keep)
+            entries.push_back({path, file_stat.st_mtim, file_stat.st_size});
+    }
+    closedir(dir);
+
+    std::sort(entries.begin(), entries.end(), [](Entry const& a, Entry const& b)
+        {
+            return a.last_used.tv_sec != b.last_used.tv_sec ?
+                a.last_used.tv_sec < b.last_used.tv_sec :
+                a.last_used.tv_nsec < b.last_used.tv_nsec;
+        });
+
+    for (auto const& entry : entries)
+    {
+        if (total_size <= static_cast<off_t>(max_size))
+            break;
+
+        if (unlink(entry.path.c_str()) == 0)
+            total_size -= entry.size;
+    }
+}
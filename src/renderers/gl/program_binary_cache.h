@@ -0,0 +1,76 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
+#define MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
+
+#include <GLES2/gl2.h>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace renderer
+{
+namespace gl
+{
+/// Linked program binaries (from GL_OES_get_program_binary) shared by all renderers in the
+/// process and persisted in a directory, so that new renderers (e.g. on hotplug) and later
+/// runs of the server can skip compiling and linking shaders.
+///
+/// Binaries are keyed by the GL vendor, renderer and version strings and the shader sources,
+/// and the driver is free to reject one (e.g. after an update) in which case we just recompile.
+class ProgramBinaryCache
+{
+public:
+    struct Binary
+    {
+        GLenum format;
+        std::vector<char> data;
+    };
+
+    /// Persists binaries in \a directory (or nowhere, if it is empty), keeping the files
+    /// there to at most \a max_size bytes by deleting the least recently used
+    ProgramBinaryCache(std::string directory, size_t max_size);
+
+    /// $XDG_CACHE_HOME/mir (or ~/.cache/mir), or nowhere if MIR_DISABLE_GL_PROGRAM_CACHE is set
+    static auto default_directory() -> std::string;
+    static size_t const default_max_size;
+
+    /// The binary for \a key, or null if there is none
+    auto find(std::string const& key) -> std::shared_ptr<Binary const>;
+    void store(std::string const& key, Binary&& binary);
+
+private:
+    auto ensure_directory_exists() const -> bool;
+    auto file_for(std::string const& key) const -> std::string;
+    void trim_directory(std::string const& keep) const;
+
+    std::string const directory;
+    size_t const max_size;
+    std::mutex mutex;
+    std::unordered_map<std::string, std::shared_ptr<Binary const>> binaries;
+};
+}
+}
+}
+
+#endif // MIR_RENDERER_GL_PROGRAM_BINARY_CACHE_H_
@@ -19,6 +19,7 @@
 #define MIR_LOG_COMPONENT "GLRenderer"
 
 #include "renderer.h"
+#include "program_binary_cache.h"
 #include "mir/compositor/buffer_stream.h"
 #include "mir/graphics/renderable.h"
 #include "mir/graphics/buffer.h"
@@ -35,10 +36,13 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <EGL/egl.h>
+#include <GLES2/gl2ext.h>
 
 #include <boost/throw_exception.hpp>
 #include <stdexcept>
 #include <cmath>
+#include <cstddef>
+#include <cstring>
 #include <sstream>
 #include <mutex>
 
@@ -132,6 +136,20 @@ public:
     mir::renderer::gl::Renderer::Program opaque, alpha;
 };
 
+auto program_binary_cache() -> mrg::ProgramBinaryCache&
+{
+    static mrg::ProgramBinaryCache cache{
+        mrg::ProgramBinaryCache::default_directory(),
+        mrg::ProgramBinaryCache::default_max_size};
+    return cache;
+}
+
+auto gl_string(GLenum name) -> std::string
+{
+    auto const value = reinterpret_cast<char const*>(glGetString(name));
+    return value ? value : "";
+}
+
 const GLchar* const vertex_shader_src =
 {
     "attribute vec3 position;\n"
@@ -155,8 +173,26 @@ class mrg::Renderer::ProgramFactory : public mir::graphics::gl::ProgramFactory
 public:
     // NOTE: This must be called with a current GL context
     ProgramFactory()
-        : vertex_shader{compile_shader(GL_VERTEX_SHADER, vertex_shader_src)}
     {
+        GLint binary_formats{0};
+        auto const extensions = gl_string(GL_EXTENSIONS);
+
+        if (strstr(extensions.c_str(), "GL_OES_get_program_binary"))
+        {
+            glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS_OES, &binary_formats);
+            get_program_binary = reinterpret_cast<PFNGLGETPROGRAMBINARYOESPROC>(
+                eglGetProcAddress("glGetProgramBinaryOES"));
+            program_binary = reinterpret_cast<PFNGLPROGRAMBINARYOESPROC>(
+                eglGetProcAddress("glProgramBinaryOES"));
+        }
+
+        if (binary_formats <= 0 || !get_program_binary || !program_binary)
+        {
+            get_program_binary = nullptr;
+            program_binary = nullptr;
+        }
+
+        driver_id = gl_string(GL_VENDOR) + "\n" + gl_string(GL_RENDERER) + "\n" + gl_string(GL_VERSION) + "\n";
     }
 
     mir::graphics::gl::Program&
@@ -215,22 +251,64 @@ public:
         // GL shader compilation is *not* threadsafe, and requires external synchronisation
         std::lock_guard<std::mutex> lock{compilation_mutex};
 
-        ShaderHandle const opaque_shader{
-            compile_shader(GL_FRAGMENT_SHADER, opaque_fragment.str().c_str())};
-        ShaderHandle const alpha_shader{
-            compile_shader(GL_FRAGMENT_SHADER, alpha_fragment.str().c_str())};
-
         programs.emplace_back(id, std::make_unique<::Program>(
-            link_shader(vertex_shader, opaque_shader),
-            link_shader(vertex_shader, alpha_shader)));
+            cached_or_linked_program(opaque_fragment.str()),
+            cached_or_linked_program(alpha_fragment.str())));
 
         return *programs.back().second;
-
-        // We delete opaque_shader and alpha_shader here. This is fine; it only marks them
-        // for deletion. GL will only delete them once the GL Program they're linked in is destroyed.
     }
 
 private:
+    ProgramHandle cached_or_linked_program(std::string const& fragment_src)
+    {
+        std::string const key = driver_id + vertex_shader_src + fragment_src;
+
+        if (program_binary)
+        {
+            if (auto const binary = program_binary_cache().find(key))
+            {
+                ProgramHandle program{glCreateProgram()};
+                program_binary(program, binary->format, binary->data.data(), binary->data.size());
+
+                GLint ok;
+                glGetProgramiv(program, GL_LINK_STATUS, &ok);
+                if (ok)
+                    return program;
+
+                mir::log_debug("Cached GL program binary rejected by driver, recompiling");
+            }
+        }
+
+        if (!vertex_shader)
+            vertex_shader = std::make_unique<ShaderHandle>(compile_shader(GL_VERTEX_SHADER, vertex_shader_src));
+
+        // We delete fragment_shader on return. This is fine; it only marks it for deletion.
+        // GL will only delete it once the GL Program it's linked in is destroyed.
+        ShaderHandle const fragment_shader{compile_shader(GL_FRAGMENT_SHADER, fragment_src.c_str())};
+        auto program = link_shader(*vertex_shader, fragment_shader);
+
+        if (get_program_binary)
+        {
+            GLint length{0};
+            glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH_OES, &length);
+
+            if (length > 0)
+            {
+                mrg::ProgramBinaryCache::Binary binary{0, std::vector<char>(length)};
+                GLsizei written{0};
+                get_program_binary(program, length, &written, &binary.format, binary.data.data());
+
+                if (written > 0)
+                {
+                    binary.data.resize(written);
+                    program_binary_cache().store(key, std::move(binary));
+                }
+            }
+        }
+
+        return program;
+    }
+
     static GLuint compile_shader(GLenum type, GLchar const* src)
     {
         GLuint id = glCreateShader(type);
@@ -278,7 +356,11 @@ private:
         return program;
     }
 
-    ShaderHandle const vertex_shader;
+    // Only compiled when a program isn't available from the ProgramBinaryCache
+    std::unique_ptr<ShaderHandle> vertex_shader;
+    std::string driver_id;
+    PFNGLGETPROGRAMBINARYOESPROC get_program_binary{nullptr};
+    PFNGLPROGRAMBINARYOESPROC program_binary{nullptr};
     std::vector<std::pair<void const*, std::unique_ptr<::Program>>> programs;
     // GL requires us to synchronise multi-threaded access to the shader APIs.
     std::mutex compilation_mutex;
@@ -365,6 +447,8 @@ mrg::Renderer::Renderer(graphics::DisplayBuffer& display_buffer)
 mrg::Renderer::~Renderer()
 {
     render_target.ensure_current();
+    if (vertex_buffer)
+        glDeleteBuffers(1, &vertex_buffer);
 }
 
 void mrg::Renderer::tessellate(std::vector<mgl::Primitive>& primitives,
@@ -383,35 +467,173 @@ void mrg::Renderer::render(mg::RenderableList const& renderables) const
     glClear(GL_COLOR_BUFFER_BIT);
 
     ++frameno;
+
+    // Anything may have touched the GL state since the last frame
+    draw_state = DrawState{};
+
+    upload_frame(renderables);
+
     for (auto const& r : renderables)
     {
         draw(*r);
     }
 
+    unbind_attribs();
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+    set_scissor({});
+
     render_target.swap_buffers();
 
     while (auto const gl_error = glGetError())
         mir::log_debug("GL error: %d", gl_error);
 }
 
-void mrg::Renderer::draw(mg::Renderable const& renderable) const
+void mrg::Renderer::upload_frame(mg::RenderableList const& renderables) const
+{
+    frame_vertices.clear();
+    frame_ranges.clear();
+    frame_renderables.clear();
+    next_frame_renderable = 0;
+
+    for (auto const& r : renderables)
+    {
+        primitives.clear();
+        tessellate(primitives, *r);
+
+        auto const begin = frame_ranges.size();
+        for (auto const& p : primitives)
+        {
+            frame_ranges.push_back({p.type, static_cast<GLint>(frame_vertices.size()), p.nvertices});
+            frame_vertices.insert(frame_vertices.end(), p.vertices, p.vertices + p.nvertices);
+        }
+        frame_renderables.push_back({r.get(), begin, frame_ranges.size()});
+    }
+
+    if (!vertex_buffer)
+        glGenBuffers(1, &vertex_buffer);
+
+    // Without a buffer object we still draw from frame_vertices, just as client-side arrays
+    if (vertex_buffer && !frame_vertices.empty())
+    {
+        glBindBuffer(GL_ARRAY_BUFFER, vertex_buffer);
+        glBufferData(GL_ARRAY_BUFFER, frame_vertices.size() * sizeof(mgl::Vertex),
+                     frame_vertices.data(), GL_STREAM_DRAW);
+    }
+}
+
+void mrg::Renderer::bind_attribs(Program const& prog, GLuint buffer, mgl::Vertex const* base) const
+{
+    if (draw_state.attribs_bound_for == &prog &&
+        draw_state.attribs_buffer == buffer &&
+        draw_state.attribs_base == base)
+    {
+        return;
+    }
+
+    unbind_attribs();
+
+    glBindBuffer(GL_ARRAY_BUFFER, buffer);
+    glEnableVertexAttribArray(prog.position_attr);
+    glEnableVertexAttribArray(prog.texcoord_attr);
+
+    auto const base_address = reinterpret_cast<char const*>(base);
+    glVertexAttribPointer(prog.position_attr, 3, GL_FLOAT,
+                          GL_FALSE, sizeof(mgl::Vertex),
+                          base_address + offsetof(mgl::Vertex, position));
+    glVertexAttribPointer(prog.texcoord_attr, 2, GL_FLOAT,
+                          GL_FALSE, sizeof(mgl::Vertex),
+                          base_address + offsetof(mgl::Vertex, texcoord));
+
+    draw_state.attribs_bound_for = &prog;
+    draw_state.attribs_buffer = buffer;
+    draw_state.attribs_base = base;
+}
+
+void mrg::Renderer::unbind_attribs() const
 {
-    auto const clip_area = renderable.clip_area();
-    if (clip_area)
+    if (auto const prog = draw_state.attribs_bound_for)
+    {
+        glDisableVertexAttribArray(prog->texcoord_attr);
+        glDisableVertexAttribArray(prog->position_attr);
+        draw_state.attribs_bound_for = nullptr;
+    }
+}
+
+void mrg::Renderer::set_blend(bool enable, BlendFunc const& func) const
+{
+    if (!enable)
+    {
+        if (!draw_state.blend_known || draw_state.blend_enabled)
+            glDisable(GL_BLEND);
+    }
+    else
+    {
+        if (!draw_state.blend_known || !draw_state.blend_enabled)
+            glEnable(GL_BLEND);
+
+        auto const& current = draw_state.blend_func;
+        if (!draw_state.blend_func_known ||
+            current.src_rgb != func.src_rgb || current.dst_rgb != func.dst_rgb ||
+            current.src_alpha != func.src_alpha || current.dst_alpha != func.dst_alpha)
+        {
+            glBlendFuncSeparate(func.src_rgb,   func.dst_rgb,
+                                func.src_alpha, func.dst_alpha);
+            draw_state.blend_func = func;
+            draw_state.blend_func_known = true;
+        }
+    }
+
+    draw_state.blend_known = true;
+    draw_state.blend_enabled = enable;
+}
+
+void mrg::Renderer::set_scissor(std::experimental::optional<geom::Rectangle> const& clip_area) const
+{
+    if (!clip_area)
+    {
+        if (draw_state.scissor_enabled)
+        {
+            glDisable(GL_SCISSOR_TEST);
+            draw_state.scissor_enabled = false;
+        }
+        return;
+    }
+
+    if (draw_state.scissor_enabled && draw_state.scissor == clip_area.value())
+        return;
+
+    if (!draw_state.scissor_enabled)
     {
         glEnable(GL_SCISSOR_TEST);
-        glScissor(
-            clip_area.value().top_left.x.as_int() -
-                viewport.top_left.x.as_int(),
-            viewport.top_left.y.as_int() +
-                viewport.size.height.as_int() -
-                clip_area.value().top_left.y.as_int() -
-                clip_area.value().size.height.as_int(),
-            clip_area.value().size.width.as_int(), 
-            clip_area.value().size.height.as_int()
-        );
+        draw_state.scissor_enabled = true;
     }
 
+    glScissor(
+        clip_area.value().top_left.x.as_int() -
+            viewport.top_left.x.as_int(),
+        viewport.top_left.y.as_int() +
+            viewport.size.height.as_int() -
+            clip_area.value().top_left.y.as_int() -
+            clip_area.value().size.height.as_int(),
+        clip_area.value().size.width.as_int(), 
+        clip_area.value().size.height.as_int()
+    );
+    draw_state.scissor = clip_area.value();
+}
+
+void mrg::Renderer::draw(mg::Renderable const& renderable) const
+{
+    // render() has normally tessellated and uploaded this renderable already;
+    // anything else (a subclass drawing extra renderables) uses client-side arrays
+    TessellatedRenderable const* tessellated = nullptr;
+    if (next_frame_renderable < frame_renderables.size() &&
+        frame_renderables[next_frame_renderable].renderable == &renderable)
+    {
+        tessellated = &frame_renderables[next_frame_renderable++];
+    }
+
+    set_scissor(renderable.clip_area());
+
     auto const texture = std::dynamic_pointer_cast<mg::gl::Texture>(renderable.buffer());
     if (!texture)
     {
@@ -430,7 +652,11 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
                 return family.opaque;
         }(renderable.alpha() < 1.0f);
 
-    glUseProgram(prog.id);
+    if (draw_state.program != &prog)
+    {
+        glUseProgram(prog.id);
+        draw_state.program = &prog;
+    }
     if (prog.last_used_frameno != frameno)
     {   // Avoid reloading the screen-global uniforms on every renderable
         // TODO: We actually only need to bind these *once*, right? Not once per frame?
@@ -476,83 +702,77 @@ void mrg::Renderer::draw(mg::Renderable const& renderable) const
     if (prog.alpha_uniform >= 0)
         glUniform1f(prog.alpha_uniform, renderable.alpha());
 
-    glEnableVertexAttribArray(prog.position_attr);
-    glEnableVertexAttribArray(prog.texcoord_attr);
+    std::vector<VertexRange> own_ranges;
+    std::vector<mgl::Vertex> own_vertices;
+    VertexRange const* ranges_begin;
+    VertexRange const* ranges_end;
 
-    primitives.clear();
-    tessellate(primitives, renderable);
+    if (tessellated)
+    {
+        ranges_begin = frame_ranges.data() + tessellated->begin;
+        ranges_end = frame_ranges.data() + tessellated->end;
 
-    // if we fail to load the texture, we need to carry on (part of lp:1629275)
-    try
+        if (vertex_buffer)
+            bind_attribs(prog, vertex_buffer, nullptr);
+        else
+            bind_attribs(prog, 0, frame_vertices.data());
+    }
+    else
     {
-        typedef struct  // Represents parameters of glBlendFuncSeparate()
+        primitives.clear();
+        tessellate(primitives, renderable);
+        for (auto const& p : primitives)
         {
-            GLenum src_rgb, dst_rgb, src_alpha, dst_alpha;
-        } BlendSeparate;
+            own_ranges.push_back({p.type, static_cast<GLint>(own_vertices.size()), p.nvertices});
+            own_vertices.insert(own_vertices.end(), p.vertices, p.vertices + p.nvertices);
+        }
+        ranges_begin = own_ranges.data();
+        ranges_end = own_ranges.data() + own_ranges.size();
 
-        BlendSeparate client_blend;
+        bind_attribs(prog, 0, own_vertices.data());
+    }
 
+    // if we fail to load the texture, we need to carry on (part of lp:1629275)
+    try
+    {
         // These renderable method names could be better (see LP: #1236224)
         if (renderable.shaped())  // Client is RGBA:
         {
-            client_blend = {GL_ONE, GL_ONE_MINUS_SRC_ALPHA,
-                            GL_ONE, GL_ONE_MINUS_SRC_ALPHA};
+            set_blend(true, {GL_ONE, GL_ONE_MINUS_SRC_ALPHA,
+                             GL_ONE, GL_ONE_MINUS_SRC_ALPHA});
         }
         else if (renderable.alpha() == 1.0f)  // RGBX and no window translucency:
         {
-            client_blend = {GL_ONE,  GL_ZERO,
-                            GL_ZERO, GL_ONE};  // Avoid using src_alpha!
+            set_blend(false, {GL_ONE,  GL_ZERO,
+                              GL_ZERO, GL_ONE});  // Avoid using src_alpha!
         }
         else
         {   // Client is RGBX but we also have window translucency.
             // The texture alpha channel is possibly uninitialized so we must be
             // careful and avoid using SRC_ALPHA (LP: #1423462).
-            client_blend = {GL_ONE,  GL_ONE_MINUS_CONSTANT_ALPHA,
-                            GL_ZERO, GL_ONE};
+            set_blend(true, {GL_ONE,  GL_ONE_MINUS_CONSTANT_ALPHA,
+                             GL_ZERO, GL_ONE});
             glBlendColor(0.0f, 0.0f, 0.0f, renderable.alpha());
         }
 
-        for (auto const& p : primitives)
-        {
-            BlendSeparate blend;
-
-            blend = client_blend;
-            texture->bind();
-
-            glVertexAttribPointer(prog.position_attr, 3, GL_FLOAT,
-                                  GL_FALSE, sizeof(mgl::Vertex),
-                                  &p.vertices[0].position);
-            glVertexAttribPointer(prog.texcoord_attr, 2, GL_FLOAT,
-                                  GL_FALSE, sizeof(mgl::Vertex),
-                                  &p.vertices[0].texcoord);
-
-            if (blend.dst_rgb == GL_ZERO)
-            {
-                glDisable(GL_BLEND);
-            }
-            else
-            {
-                glEnable(GL_BLEND);
-                glBlendFuncSeparate(blend.src_rgb,   blend.dst_rgb,
-                                    blend.src_alpha, blend.dst_alpha);
-            }
+        texture->bind();
 
-            glDrawArrays(p.type, 0, p.nvertices);
-
-            // We're done with the texture for now
-            texture->add_syncpoint();
+        for (auto range = ranges_begin; range != ranges_end; ++range)
+        {
+            glDrawArrays(range->type, range->first, range->count);
         }
+
+        // We're done with the texture for now
+        texture->add_syncpoint();
     }
     catch (std::exception const& ex)
     {
         report_exception();
     }
 
-    glDisableVertexAttribArray(prog.texcoord_attr);
-    glDisableVertexAttribArray(prog.position_attr);
-    if (renderable.clip_area())
-    {
-        glDisable(GL_SCISSOR_TEST);
+    if (!own_vertices.empty())
+    {   // Don't leave attribute pointers into own_vertices behind
+        unbind_attribs();
     }
 }
 
@@ -125,6 +125,52 @@ private:
     glm::mat4 screen_to_gl_coords;
     glm::mat4 display_transform;
     std::vector<mir::gl::Primitive> mutable primitives;
+
+    /* The whole frame is tessellated up front and uploaded to vertex_buffer
+     * in one go; draw() then only has to issue glDrawArrays() on ranges of it.
+     */
+    struct VertexRange
+    {
+        GLenum type;
+        GLint first;
+        GLsizei count;
+    };
+    struct TessellatedRenderable
+    {
+        graphics::Renderable const* renderable;
+        size_t begin, end;      // indices into frame_ranges
+    };
+    std::vector<mir::gl::Vertex> mutable frame_vertices;
+    std::vector<VertexRange> mutable frame_ranges;
+    std::vector<TessellatedRenderable> mutable frame_renderables;
+    size_t mutable next_frame_renderable = 0;
+    GLuint mutable vertex_buffer = 0;
+
+    /* GL state as last set by draw(), so redundant changes can be skipped */
+    struct BlendFunc
+    {
+        GLenum src_rgb, dst_rgb, src_alpha, dst_alpha;
+    };
+    struct DrawState
+    {
+        Program const* program = nullptr;
+        Program const* attribs_bound_for = nullptr;
+        GLuint attribs_buffer = 0;
+        mir::gl::Vertex const* attribs_base = nullptr;
+        bool blend_known = false;
+        bool blend_enabled = false;
+        bool blend_func_known = false;
+        BlendFunc blend_func{GL_ONE, GL_ZERO, GL_ONE, GL_ZERO};
+        bool scissor_enabled = false;
+        geometry::Rectangle scissor;
+    };
+    DrawState mutable draw_state;
+
+    void upload_frame(graphics::RenderableList const& renderables) const;
+    void bind_attribs(Program const& prog, GLuint buffer, mir::gl::Vertex const* base) const;
+    void unbind_attribs() const;
+    void set_blend(bool enable, BlendFunc const& func) const;
+    void set_scissor(std::experimental::optional<geometry::Rectangle> const& clip_area) const;
 };
 
 }
@@ -37,10 +37,12 @@ namespace mg = mir::graphics;
 mc::DefaultDisplayBufferCompositor::DefaultDisplayBufferCompositor(
     mg::DisplayBuffer& display_buffer,
     std::shared_ptr<mir::renderer::Renderer> const& renderer,
-    std::shared_ptr<mc::CompositorReport> const& report) :
+    std::shared_ptr<mc::CompositorReport> const& report,
+    std::shared_ptr<mc::InputLatencyReport> const& latency_report) :
     display_buffer(display_buffer),
     renderer(renderer),
-    report(report)
+    report(report),
+    latency_report(latency_report)
 {
 }
 
@@ -75,6 +77,7 @@ void mc::DefaultDisplayBufferCompositor::composite(mc::SceneElementSequence&& sc
     if (display_buffer.overlay(renderable_list))
     {
         report->renderables_in_frame(this, renderable_list);
+        latency_report->renderables_in_frame(&display_buffer, renderable_list);
         renderer->suspend();
     }
     else
@@ -84,6 +87,7 @@ void mc::DefaultDisplayBufferCompositor::composite(mc::SceneElementSequence&& sc
         renderer->render(renderable_list);
 
         report->renderables_in_frame(this, renderable_list);
+        latency_report->renderables_in_frame(&display_buffer, renderable_list);
         report->rendered_frame(this);
 
         /*
@@ -21,6 +21,7 @@
 
 #include "mir/compositor/display_buffer_compositor.h"
 #include "mir/compositor/compositor_report.h"
+#include "mir/compositor/input_latency_report.h"
 #include <memory>
 
 namespace mir
@@ -44,7 +45,8 @@ public:
     DefaultDisplayBufferCompositor(
         graphics::DisplayBuffer& display_buffer,
         std::shared_ptr<renderer::Renderer> const& renderer,
-        std::shared_ptr<CompositorReport> const& report);
+        std::shared_ptr<CompositorReport> const& report,
+        std::shared_ptr<InputLatencyReport> const& latency_report);
 
     void composite(SceneElementSequence&& scene_sequence) override;
 
@@ -52,6 +54,7 @@ private:
     graphics::DisplayBuffer& display_buffer;
     std::shared_ptr<renderer::Renderer> const renderer;
     std::shared_ptr<CompositorReport> const report;
+    std::shared_ptr<InputLatencyReport> const latency_report;
 };
 
 }
@@ -21,6 +21,7 @@
 
 #include "mir/compositor/display_buffer_compositor_factory.h"
 #include "mir/compositor/compositor_report.h"
+#include "mir/compositor/input_latency_report.h"
 
 namespace mir
 {
@@ -37,13 +38,15 @@ class DefaultDisplayBufferCompositorFactory : public DisplayBufferCompositorFact
 public:
     DefaultDisplayBufferCompositorFactory(
         std::shared_ptr<renderer::RendererFactory> const& renderer_factory,
-        std::shared_ptr<CompositorReport> const& report);
+        std::shared_ptr<CompositorReport> const& report,
+        std::shared_ptr<InputLatencyReport> const& latency_report);
 
     std::unique_ptr<DisplayBufferCompositor> create_compositor_for(graphics::DisplayBuffer& display_buffer);
 
 private:
     std::shared_ptr<renderer::RendererFactory> const renderer_factory;
     std::shared_ptr<CompositorReport> const report;
+    std::shared_ptr<InputLatencyReport> const latency_report;
 };
 
 }
@@ -24,6 +24,7 @@
 #include "mir/compositor/display_listener.h"
 #include "mir/compositor/scene.h"
 #include "mir/compositor/compositor_report.h"
+#include "mir/compositor/input_latency_report.h"
 #include "mir/scene/legacy_scene_change_notification.h"
 #include "mir/scene/surface_observer.h"
 #include "mir/scene/surface.h"
@@ -57,7 +58,8 @@ public:
         std::shared_ptr<mc::Scene> const& scene,
         std::shared_ptr<DisplayListener> const& display_listener,
         std::chrono::milliseconds fixed_composite_delay,
-        std::shared_ptr<CompositorReport> const& report) :
+        std::shared_ptr<CompositorReport> const& report,
+        std::shared_ptr<InputLatencyReport> const& latency_report) :
         compositor_factory{db_compositor_factory},
         group(group),
         scene(scene),
@@ -66,6 +68,7 @@ public:
         force_sleep{fixed_composite_delay},
         display_listener{display_listener},
         report{report},
+        latency_report{latency_report},
         started_future{started.get_future()}
     {
     }
@@ -142,6 +145,9 @@ public:
                     }
                     group.post();
 
+                    for (auto& tuple : compositors)
+                        latency_report->frame_posted(std::get<0>(tuple));
+
                     /*
                      * "Predictive bypass" optimization: If the last frame was
                      * bypassed/overlayed or you simply have a fast GPU, it is
@@ -222,6 +228,11 @@ public:
         run_cv.notify_one();
     }
 
+    bool composites_to(mg::DisplaySyncGroup const& other) const
+    {
+        return &group == &other;
+    }
+
     void wait_until_started()
     {
         if (started_future.wait_for(10s) != std::future_status::ready)
@@ -241,6 +252,7 @@ private:
     std::condition_variable run_cv;
     std::shared_ptr<DisplayListener> const display_listener;
     std::shared_ptr<CompositorReport> const report;
+    std::shared_ptr<InputLatencyReport> const latency_report;
     std::promise<void> started;
     std::future<void> started_future;
     bool not_posted_yet = true;
@@ -255,6 +267,7 @@ mc::MultiThreadedCompositor::MultiThreadedCompositor(
     std::shared_ptr<DisplayBufferCompositorFactory> const& db_compositor_factory,
     std::shared_ptr<DisplayListener> const& display_listener,
     std::shared_ptr<CompositorReport> const& compositor_report,
+    std::shared_ptr<InputLatencyReport> const& latency_report,
     std::chrono::milliseconds fixed_composite_delay,
     bool compose_on_start)
     : display{display},
@@ -262,6 +275,7 @@ mc::MultiThreadedCompositor::MultiThreadedCompositor(
       display_buffer_compositor_factory{db_compositor_factory},
       display_listener{display_listener},
       report{compositor_report},
+      latency_report{latency_report},
       state{CompositorState::stopped},
       fixed_composite_delay{fixed_composite_delay},
       compose_on_start{compose_on_start},
@@ -286,6 +300,7 @@ mc::MultiThreadedCompositor::~MultiThreadedCompositor()
 void mc::MultiThreadedCompositor::schedule_compositing(int num)
 {
     report->scheduled();
+    std::lock_guard<std::mutex> lock{threads_mutex};
     for (auto& f : thread_functors)
         f->schedule_compositing(num);
 }
@@ -293,17 +308,20 @@ void mc::MultiThreadedCompositor::schedule_compositing(int num)
 void mc::MultiThreadedCompositor::schedule_compositing(int num, geometry::Rectangle const& damage) const
 {
     report->scheduled();
+    std::lock_guard<std::mutex> lock{threads_mutex};
     for (auto& f : thread_functors)
         f->schedule_compositing(num, damage);
 }
 
 void mc::MultiThreadedCompositor::start()
 {
-    auto stopped = CompositorState::stopped;
+    std::lock_guard<std::mutex> lock{state_mutex};
 
-    if (!state.compare_exchange_strong(stopped, CompositorState::starting))
+    if (state != CompositorState::stopped)
         return;
 
+    state = CompositorState::starting;
+
     report->started();
 
     /* To cleanup state if any code below throws */
@@ -327,11 +345,13 @@ void mc::MultiThreadedCompositor::start()
 
 void mc::MultiThreadedCompositor::stop()
 {
-    auto started = CompositorState::started;
+    std::lock_guard<std::mutex> lock{state_mutex};
 
-    if (!state.compare_exchange_strong(started, CompositorState::stopping))
+    if (state != CompositorState::started)
         return;
 
+    state = CompositorState::stopping;
+
     /* To cleanup state if any code below throws */
     auto cleanup_if_unwinding = on_unwind([this]
         {
@@ -352,33 +372,96 @@ void mc::MultiThreadedCompositor::stop()
     state = CompositorState::stopped;
 }
 
-void mc::MultiThreadedCompositor::create_compositing_threads()
+void mc::MultiThreadedCompositor::stop_compositing_to(mg::DisplaySyncGroup const& group)
 {
-    /* Start the display buffer compositing threads */
-    display->for_each_display_sync_group([this](mg::DisplaySyncGroup& group)
+    std::lock_guard<std::mutex> state_lock{state_mutex};
+
+    if (state != CompositorState::started)
+        return;
+
+    std::unique_ptr<CompositingFunctor> functor;
+    std::future<void> future;
     {
-        auto thread_functor = std::make_unique<mc::CompositingFunctor>(
-            display_buffer_compositor_factory, group, scene, display_listener,
-            fixed_composite_delay, report);
+        std::lock_guard<std::mutex> lock{threads_mutex};
 
-        futures.push_back(thread_pool.run(std::ref(*thread_functor), &group));
-        thread_functors.push_back(std::move(thread_functor));
-    });
+        auto const i = std::find_if(
+            thread_functors.begin(), thread_functors.end(),
+            [&group](auto const& functor) { return functor->composites_to(group); });
+
+        if (i == thread_functors.end())
+            return;
+
+        auto const index = i - thread_functors.begin();
+        functor = std::move(*i);
+        future = std::move(futures[index]);
+        thread_functors.erase(i);
+        futures.erase(futures.begin() + index);
+    }
+
+    functor->stop();
+    future.wait();
+}
 
-    thread_pool.shrink();
+void mc::MultiThreadedCompositor::start_compositing_to_new_groups()
+{
+    std::lock_guard<std::mutex> lock{state_mutex};
 
-    for (auto& functor : thread_functors)
+    if (state != CompositorState::started)
+        return;
+
+    for (auto const functor : create_compositing_threads())
+        functor->schedule_compositing(1);
+}
+
+auto mc::MultiThreadedCompositor::create_compositing_threads() -> std::vector<CompositingFunctor*>
+{
+    std::vector<CompositingFunctor*> created;
+
+    {
+        std::lock_guard<std::mutex> lock{threads_mutex};
+
+        /* Start the display buffer compositing threads of groups we're not already compositing to */
+        display->for_each_display_sync_group([this, &created](mg::DisplaySyncGroup& group)
+        {
+            auto const already_composited = std::any_of(
+                thread_functors.begin(), thread_functors.end(),
+                [&group](auto const& functor) { return functor->composites_to(group); });
+
+            if (already_composited)
+                return;
+
+            auto thread_functor = std::make_unique<mc::CompositingFunctor>(
+                display_buffer_compositor_factory, group, scene, display_listener,
+                fixed_composite_delay, report, latency_report);
+
+            futures.push_back(thread_pool.run(std::ref(*thread_functor), &group));
+            created.push_back(thread_functor.get());
+            thread_functors.push_back(std::move(thread_functor));
+        });
+
+        thread_pool.shrink();
+    }
+
+    for (auto const functor : created)
         functor->wait_until_started();
+
+    return created;
 }
 
 void mc::MultiThreadedCompositor::destroy_compositing_threads()
 {
-    for (auto& f : thread_functors)
+    decltype(thread_functors) functors;
+    decltype(futures) threads;
+    {
+        std::lock_guard<std::mutex> lock{threads_mutex};
+        std::swap(functors, thread_functors);
+        std::swap(threads, futures);
+    }
+
+    // Don't hold threads_mutex while waiting: the compositing threads may schedule compositing
+    for (auto& f : functors)
         f->stop();
 
-    for (auto& f : futures)
+    for (auto& f : threads)
         f.wait();
-
-    thread_functors.clear();
-    futures.clear();
 }
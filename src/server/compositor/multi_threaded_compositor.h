@@ -35,6 +35,7 @@ namespace geometry { struct Rectangle; }
 namespace graphics
 {
 class Display;
+class DisplaySyncGroup;
 }
 namespace scene
 {
@@ -49,6 +50,7 @@ class DisplayListener;
 class CompositingFunctor;
 class Scene;
 class CompositorReport;
+class InputLatencyReport;
 
 enum class CompositorState
 {
@@ -67,15 +69,19 @@ public:
         std::shared_ptr<DisplayBufferCompositorFactory> const& db_compositor_factory,
         std::shared_ptr<DisplayListener> const& display_listener,
         std::shared_ptr<CompositorReport> const& compositor_report,
+        std::shared_ptr<InputLatencyReport> const& latency_report,
         std::chrono::milliseconds fixed_composite_delay,  // -1 = automatic
         bool compose_on_start);
     ~MultiThreadedCompositor();
 
     void start();
     void stop();
+    void stop_compositing_to(graphics::DisplaySyncGroup const& group) override;
+    void start_compositing_to_new_groups() override;
 
 private:
-    void create_compositing_threads();
+    /// Returns the functors of the threads that were created
+    auto create_compositing_threads() -> std::vector<CompositingFunctor*>;
     void destroy_compositing_threads();
 
     std::shared_ptr<graphics::Display> const display;
@@ -83,11 +89,16 @@ private:
     std::shared_ptr<DisplayBufferCompositorFactory> const display_buffer_compositor_factory;
     std::shared_ptr<DisplayListener> const display_listener;
     std::shared_ptr<CompositorReport> const report;
+    std::shared_ptr<InputLatencyReport> const latency_report;
 
+    /// Guards thread_functors and futures against being changed while compositing is scheduled
+    mutable std::mutex threads_mutex;
     std::vector<std::unique_ptr<CompositingFunctor>> thread_functors;
     std::vector<std::future<void>> futures;
 
-    std::atomic<CompositorState> state;
+    /// Serialises starting and stopping compositing, whether to all groups or to some of them
+    std::mutex state_mutex;
+    CompositorState state;
     std::chrono::milliseconds fixed_composite_delay;
     bool compose_on_start;
 
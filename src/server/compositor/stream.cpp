@@ -21,7 +21,9 @@
 #include "queueing_schedule.h"
 #include "dropping_schedule.h"
 #include "mir/graphics/buffer.h"
+#include "mir/graphics/prepared_in_background.h"
 #include <boost/throw_exception.hpp>
+#include <optional>
 
 namespace mc = mir::compositor;
 namespace geom = mir::geometry;
@@ -34,6 +36,34 @@ enum class mc::Stream::ScheduleMode {
     Dropping
 };
 
+class mc::Stream::Lifetime
+{
+public:
+    explicit Lifetime(Stream* stream)
+        : stream{stream}
+    {
+    }
+
+    void buffer_prepared(mg::Buffer const* prepared)
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        if (stream)
+        {
+            stream->buffer_prepared(prepared);
+        }
+    }
+
+    void end()
+    {
+        std::lock_guard<decltype(mutex)> lock{mutex};
+        stream = nullptr;
+    }
+
+private:
+    std::mutex mutex;
+    Stream* stream;
+};
+
 mc::Stream::Stream(
     geom::Size size, MirPixelFormat pf) :
     schedule_mode(ScheduleMode::Queueing),
@@ -42,30 +72,103 @@ mc::Stream::Stream(
     latest_buffer_size(size),
     pf(pf),
     first_frame_posted(false),
+    lifetime(std::make_shared<Lifetime>(this)),
     frame_callback{[](auto){}}
 {
 }
 
-mc::Stream::~Stream() = default;
+mc::Stream::~Stream()
+{
+    lifetime->end();
+}
 
 void mc::Stream::submit_buffer(std::shared_ptr<mg::Buffer> const& buffer)
 {
     if (!buffer)
         BOOST_THROW_EXCEPTION(std::invalid_argument("cannot submit null buffer"));
 
+    auto const prepared_in_background = std::dynamic_pointer_cast<mg::PreparedInBackground>(buffer);
+    bool posted{false};
+    decltype(preparing) superseded; // Released once the mutex is
+
     {
         std::lock_guard<decltype(mutex)> lk(mutex);
         pf = buffer->pixel_format();
         latest_buffer_size = buffer->size();
-        schedule->schedule(buffer);
-        first_frame_posted = true;
+
+        if (schedule_mode == ScheduleMode::Dropping)
+        {
+            // Buffers that have been superseded needn't be prepared, let alone drawn
+            superseded.swap(preparing);
+        }
+
+        if (!prepared_in_background && preparing.empty())
+        {
+            schedule->schedule(buffer);
+            first_frame_posted = true;
+            posted = true;
+        }
+        else
+        {
+            preparing.emplace_back(buffer, !prepared_in_background);
+        }
+    }
+
+    if (prepared_in_background)
+    {
+        // This may call back immediately, so mustn't be called with the mutex held
+        prepared_in_background->when_ready(
+            [lifetime = std::weak_ptr<Lifetime>{lifetime}, prepared = buffer.get()]()
+            {
+                if (auto const live = lifetime.lock())
+                {
+                    live->buffer_prepared(prepared);
+                }
+            });
+    }
+
+    if (posted)
+    {
+        post_frame(buffer->size());
+    }
+}
+
+void mc::Stream::buffer_prepared(mg::Buffer const* prepared)
+{
+    std::optional<geom::Size> posted_size;
+
+    {
+        std::lock_guard<decltype(mutex)> lk(mutex);
+        for (auto& [buffer, ready] : preparing)
+        {
+            if (buffer.get() == prepared)
+            {
+                ready = true;
+            }
+        }
+
+        while (!preparing.empty() && preparing.front().second)
+        {
+            auto const& buffer = preparing.front().first;
+            schedule->schedule(buffer);
+            first_frame_posted = true;
+            posted_size = buffer->size();
+            preparing.pop_front();
+        }
     }
+
+    if (posted_size)
     {
-        std::lock_guard<decltype(callback_mutex)> lock{callback_mutex};
-        frame_callback(buffer->size());
+        post_frame(posted_size.value());
     }
 }
 
+void mc::Stream::post_frame(geom::Size const& size)
+{
+    std::lock_guard<decltype(callback_mutex)> lock{callback_mutex};
+    frame_callback(size);
+}
+
 void mc::Stream::with_most_recent_buffer_do(std::function<void(mg::Buffer&)> const& fn)
 {
     std::lock_guard<decltype(mutex)> lk(mutex);
@@ -26,6 +26,7 @@
 #include "mir/lockable_callback.h"
 #include "mir/geometry/size.h"
 #include "multi_monitor_arbiter.h"
+#include <deque>
 #include <mutex>
 #include <memory>
 #include <set>
@@ -59,7 +60,10 @@ public:
 
 private:
     enum class ScheduleMode;
+    class Lifetime;
     void transition_schedule(std::shared_ptr<Schedule>&& new_schedule, std::lock_guard<std::mutex> const&);
+    void buffer_prepared(graphics::Buffer const* prepared);
+    void post_frame(geometry::Size const& size);
 
     std::mutex mutable mutex;
     ScheduleMode schedule_mode;
@@ -70,6 +74,13 @@ private:
     MirPixelFormat pf;
     std::atomic<bool> first_frame_posted;
 
+    // Buffers still being prepared to draw (see graphics::PreparedInBackground), oldest first, with
+    // whether each is now ready. They're held back until they and every buffer before them are ready,
+    // so the compositor never waits for them and keeps drawing the previous buffer in the meantime.
+    std::deque<std::pair<std::shared_ptr<graphics::Buffer>, bool>> preparing;
+    // Lets preparation finish after the stream has gone
+    std::shared_ptr<Lifetime> const lifetime;
+
     std::mutex callback_mutex;
     std::function<void(geometry::Size const&)> frame_callback;
 };
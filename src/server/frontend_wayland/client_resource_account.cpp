@@ -0,0 +1,102 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "client_resource_account.h"
+
+#include "mir/time/clock.h"
+
+#include <algorithm>
+
+namespace mf = mir::frontend;
+
+mf::ClientResourceAccount::ClientResourceAccount(
+    ClientResourceLimits const& limits,
+    std::shared_ptr<time::Clock> const& clock,
+    LimitExceeded&& limit_exceeded)
+    : limits{limits},
+      clock{clock},
+      limit_exceeded{std::move(limit_exceeded)},
+      commit_window_start{clock->now()}
+{
+}
+
+void mf::ClientResourceAccount::surface_created()
+{
+    usage_.surfaces++;
+    check_limit("surfaces", usage_.surfaces, limits.surfaces);
+}
+
+void mf::ClientResourceAccount::surface_destroyed()
+{
+    if (usage_.surfaces > 0)
+    {
+        usage_.surfaces--;
+    }
+}
+
+void mf::ClientResourceAccount::frame_callback_requested()
+{
+    usage_.pending_frame_callbacks++;
+    check_limit("pending frame callbacks", usage_.pending_frame_callbacks, limits.pending_frame_callbacks);
+}
+
+void mf::ClientResourceAccount::frame_callback_done()
+{
+    if (usage_.pending_frame_callbacks > 0)
+    {
+        usage_.pending_frame_callbacks--;
+    }
+}
+
+void mf::ClientResourceAccount::surface_committed()
+{
+    auto const now = clock->now();
+    if (now - commit_window_start >= std::chrono::seconds{1})
+    {
+        commit_window_start = now;
+        usage_.commits_per_second = 0;
+    }
+    usage_.commits_per_second++;
+    check_limit("commits per second", usage_.commits_per_second, limits.commits_per_second);
+}
+
+void mf::ClientResourceAccount::buffer_memory_changed(size_t old_bytes, size_t new_bytes)
+{
+    usage_.buffer_memory -= std::min(old_bytes, usage_.buffer_memory);
+    usage_.buffer_memory += new_bytes;
+    if (new_bytes > old_bytes)
+    {
+        check_limit("bytes of buffers", usage_.buffer_memory, limits.buffer_memory);
+    }
+}
+
+void mf::ClientResourceAccount::requests_dispatched(size_t requests, std::chrono::nanoseconds thread_time)
+{
+    usage_.requests += requests;
+    usage_.wayland_thread_time += thread_time;
+}
+
+void mf::ClientResourceAccount::check_limit(char const* resource, size_t value, size_t limit)
+{
+    if (limit == 0 || value <= limit || exceeded_)
+    {
+        return;
+    }
+
+    exceeded_ = true;
+    limit_exceeded(resource, value, limit);
+}
@@ -0,0 +1,95 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_FRONTEND_CLIENT_RESOURCE_ACCOUNT_H_
+#define MIR_FRONTEND_CLIENT_RESOURCE_ACCOUNT_H_
+
+#include "mir/time/types.h"
+
+#include <memory>
+#include <functional>
+#include <chrono>
+#include <cstddef>
+
+namespace mir
+{
+namespace time
+{
+class Clock;
+}
+namespace frontend
+{
+/// What a single client may build up in the compositor. Zero means unlimited.
+struct ClientResourceLimits
+{
+    size_t surfaces{0};
+    size_t pending_frame_callbacks{0};
+    size_t commits_per_second{0};
+    size_t buffer_memory{0}; ///< In bytes, of the buffers currently attached to the client's surfaces
+};
+
+/// What a single client has built up in the compositor
+struct ClientResourceUsage
+{
+    size_t surfaces{0};
+    size_t pending_frame_callbacks{0};
+    size_t commits_per_second{0}; ///< Commits so far in the current one second window
+    size_t buffer_memory{0}; ///< In bytes, estimated for buffers that aren't shared memory
+    size_t requests{0}; ///< Dispatched since the client connected
+    std::chrono::nanoseconds wayland_thread_time{0}; ///< CPU time spent dispatching the requests (approximate)
+};
+
+/// Keeps a client's ClientResourceUsage and checks it against its ClientResourceLimits. Not threadsafe, WlClient only
+/// uses it on the Wayland thread.
+class ClientResourceAccount
+{
+public:
+    /// Called with the resource, its new value and its limit the first time any limit is exceeded
+    using LimitExceeded = std::function<void(char const* resource, size_t value, size_t limit)>;
+
+    ClientResourceAccount(
+        ClientResourceLimits const& limits,
+        std::shared_ptr<time::Clock> const& clock,
+        LimitExceeded&& limit_exceeded);
+
+    void surface_created();
+    void surface_destroyed();
+    void frame_callback_requested();
+    void frame_callback_done();
+    void surface_committed();
+    void buffer_memory_changed(size_t old_bytes, size_t new_bytes);
+    void requests_dispatched(size_t requests, std::chrono::nanoseconds thread_time);
+
+    auto usage() const -> ClientResourceUsage const& { return usage_; }
+
+    /// If any limit has been exceeded
+    auto exceeded() const -> bool { return exceeded_; }
+
+private:
+    void check_limit(char const* resource, size_t value, size_t limit);
+
+    ClientResourceLimits const limits;
+    std::shared_ptr<time::Clock> const clock;
+    LimitExceeded const limit_exceeded;
+    ClientResourceUsage usage_;
+    time::Timestamp commit_window_start;
+    bool exceeded_{false};
+};
+}
+}
+
+#endif // MIR_FRONTEND_CLIENT_RESOURCE_ACCOUNT_H_
@@ -0,0 +1,153 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "cursor_image_cache.h"
+
+#include "mir/graphics/buffer.h"
+#include "mir/graphics/cursor_image.h"
+#include "mir/renderer/sw/pixel_source.h"
+#include "mir/scene/surface.h"
+
+#include <boost/throw_exception.hpp>
+#include <string.h> // memcpy
+#include <stdexcept>
+#include <string_view>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace geom = mir::geometry;
+namespace mrs = mir::renderer::software;
+
+class mf::CursorImageCache::Image : public mg::CursorImage
+{
+public:
+    Image(mrs::Mapping<unsigned char const>& mapping, geom::Displacement const& hotspot)
+        : size_{mapping.size()},
+          len{mapping.len()},
+          data{std::make_unique<unsigned char[]>(mapping.len())},
+          hotspot_{hotspot}
+    {
+        ::memcpy(data.get(), mapping.data(), mapping.len());
+    }
+
+    auto as_argb_8888() const -> void const* override
+    {
+        return data.get();
+    }
+
+    auto size() const -> geom::Size override
+    {
+        return size_;
+    }
+
+    auto hotspot() const -> geom::Displacement override
+    {
+        return hotspot_;
+    }
+
+    /// Guards against hash collisions
+    auto shows(mrs::Mapping<unsigned char const>& mapping, geom::Displacement const& hotspot) const -> bool
+    {
+        return mapping.size() == size_ &&
+            mapping.len() == len &&
+            hotspot == hotspot_ &&
+            ::memcmp(mapping.data(), data.get(), len) == 0;
+    }
+
+private:
+    geom::Size const size_;
+    size_t const len;
+    std::unique_ptr<unsigned char[]> const data;
+    geom::Displacement const hotspot_;
+};
+
+namespace
+{
+auto hash_of(mrs::Mapping<unsigned char const>& mapping, geom::Displacement const& hotspot) -> size_t
+{
+    auto const pixels = std::hash<std::string_view>{}(
+        std::string_view{reinterpret_cast<char const*>(mapping.data()), mapping.len()});
+    return pixels ^
+        std::hash<int>{}(mapping.size().width.as_int()) * 31 ^
+        std::hash<int>{}(hotspot.dx.as_int()) * 127 ^
+        std::hash<int>{}(hotspot.dy.as_int()) * 8191;
+}
+
+auto buffer_to_mapping_if_possible(std::shared_ptr<mg::Buffer> const& buffer)
+    -> std::unique_ptr<mrs::Mapping<unsigned char const>>
+{
+    auto const mappable_buffer = mrs::as_read_mappable_buffer(buffer);
+    if (!mappable_buffer)
+    {
+        BOOST_THROW_EXCEPTION(
+            std::runtime_error{
+                "Attempt to create cursor from non-CPU-readable buffer. Rendering will be incomplete"});
+    }
+    return mappable_buffer->map_readable();
+}
+}
+
+mf::CursorImageCache::CursorImageCache()
+    : CursorImageCache{&hash_of}
+{
+}
+
+mf::CursorImageCache::CursorImageCache(Hash hash)
+    : hash{std::move(hash)}
+{
+}
+
+mf::CursorImageCache::~CursorImageCache() = default;
+
+auto mf::CursorImageCache::image_of(std::shared_ptr<mg::Buffer> const& buffer, geom::Displacement const& hotspot)
+    -> std::shared_ptr<mg::CursorImage>
+{
+    auto const mapping = buffer_to_mapping_if_possible(buffer);
+    auto const key = hash(*mapping, hotspot);
+
+    auto const cached = images.find(key);
+    if (cached != images.end())
+    {
+        auto const image = cached->second.lock();
+        if (image && image->shows(*mapping, hotspot))
+        {
+            return image;
+        }
+    }
+
+    for (auto i = images.begin(); i != images.end(); )
+    {
+        i = i->second.expired() ? images.erase(i) : std::next(i);
+    }
+
+    auto const image = std::make_shared<Image>(*mapping, hotspot);
+    images[key] = image;
+    return image;
+}
+
+void mf::CursorImageCache::apply_to(
+    scene::Surface& surface,
+    std::shared_ptr<mg::Buffer> const& buffer,
+    geom::Displacement const& hotspot)
+{
+    auto const image = image_of(buffer, hotspot);
+
+    if (surface.cursor_image() != image)
+    {
+        surface.set_cursor_image(image);
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_FRONTEND_CURSOR_IMAGE_CACHE_H_
+#define MIR_FRONTEND_CURSOR_IMAGE_CACHE_H_
+
+#include "mir/geometry/displacement.h"
+
+#include <functional>
+#include <memory>
+#include <unordered_map>
+
+namespace mir
+{
+namespace graphics
+{
+class Buffer;
+class CursorImage;
+}
+namespace renderer
+{
+namespace software
+{
+template<typename T>
+class Mapping;
+}
+}
+namespace scene
+{
+class Surface;
+}
+namespace frontend
+{
+/// The cursor images a client has recently set, so re-setting one (as toolkits do on most pointer enters) reuses
+/// the existing image rather than creating, and uploading, a new one
+class CursorImageCache
+{
+public:
+    using Hash = std::function<size_t(
+        renderer::software::Mapping<unsigned char const>& pixels,
+        geometry::Displacement const& hotspot)>;
+
+    CursorImageCache();
+
+    /// Only useful for tests, which need to force hash collisions
+    explicit CursorImageCache(Hash hash);
+
+    ~CursorImageCache();
+
+    /// An image of \a buffer's content, shared with any live image with identical content and hotspot
+    /// \throws std::runtime_error if \a buffer can't be read by the CPU
+    auto image_of(std::shared_ptr<graphics::Buffer> const& buffer, geometry::Displacement const& hotspot)
+        -> std::shared_ptr<graphics::CursorImage>;
+
+    /// Shows \a buffer as \a surface's cursor, leaving \a surface alone if it already shows the same image
+    void apply_to(
+        scene::Surface& surface,
+        std::shared_ptr<graphics::Buffer> const& buffer,
+        geometry::Displacement const& hotspot);
+
+private:
+    class Image;
+
+    Hash const hash;
+    std::unordered_map<size_t, std::weak_ptr<Image>> images;
+};
+}
+}
+
+#endif // MIR_FRONTEND_CURSOR_IMAGE_CACHE_H_
@@ -0,0 +1,95 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "frame_callback_schedule.h"
+
+#include <mir/executor.h>
+
+#include <algorithm>
+
+namespace mf = mir::frontend;
+
+mf::FrameCallbackSchedule::FrameCallbackSchedule(
+    std::shared_ptr<Executor> const& frame_callback_executor,
+    std::shared_ptr<Executor> const& occluded_frame_callback_executor,
+    std::function<bool()>&& callbacks_pending,
+    std::function<void()>&& send_callbacks)
+    : frame_callback_executor{frame_callback_executor},
+      occluded_frame_callback_executor{occluded_frame_callback_executor},
+      callbacks_pending{std::move(callbacks_pending)},
+      send_callbacks{std::move(send_callbacks)}
+{
+}
+
+void mf::FrameCallbackSchedule::committed_without_buffer()
+{
+    schedule();
+}
+
+void mf::FrameCallbackSchedule::committed_buffer()
+{
+    if (occluded_)
+    {
+        // Nothing will consume the buffer while the surface can't be seen
+        schedule();
+    }
+}
+
+void mf::FrameCallbackSchedule::set_occluded(bool occluded)
+{
+    for (auto const child: children)
+    {
+        child->set_occluded(occluded);
+    }
+
+    if (occluded_ == occluded)
+    {
+        return;
+    }
+    occluded_ = occluded;
+
+    /* Callbacks waiting on a buffer the compositor isn't going to consume (or held back
+     * entirely) are sent on the schedule that applies from now on.
+     */
+    if (callbacks_pending())
+    {
+        schedule();
+    }
+}
+
+void mf::FrameCallbackSchedule::add_child(FrameCallbackSchedule* child)
+{
+    children.push_back(child);
+    child->set_occluded(occluded_);
+}
+
+void mf::FrameCallbackSchedule::remove_child(FrameCallbackSchedule* child)
+{
+    children.erase(std::remove(begin(children), end(children), child), end(children));
+}
+
+void mf::FrameCallbackSchedule::schedule()
+{
+    if (!occluded_)
+    {
+        frame_callback_executor->spawn(std::function<void()>{send_callbacks});
+    }
+    else if (occluded_frame_callback_executor)
+    {
+        occluded_frame_callback_executor->spawn(std::function<void()>{send_callbacks});
+    }
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_FRONTEND_FRAME_CALLBACK_SCHEDULE_H_
+#define MIR_FRONTEND_FRAME_CALLBACK_SCHEDULE_H_
+
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace mir
+{
+class Executor;
+
+namespace frontend
+{
+/// Decides when the frame callbacks of a surface without a buffer the compositor will consume are sent. Surfaces no
+/// output shows get theirs on the slower occluded schedule, and subsurfaces follow their parent. Should only be used on
+/// the Wayland thread.
+class FrameCallbackSchedule
+{
+public:
+    /// \a send_callbacks is spawned on one of the executors to send the surface's pending callbacks (if
+    /// \a callbacks_pending). A null \a occluded_frame_callback_executor holds the callbacks of occluded surfaces until
+    /// they are shown again.
+    FrameCallbackSchedule(
+        std::shared_ptr<Executor> const& frame_callback_executor,
+        std::shared_ptr<Executor> const& occluded_frame_callback_executor,
+        std::function<bool()>&& callbacks_pending,
+        std::function<void()>&& send_callbacks);
+
+    /// There's no buffer to send the callbacks when it is consumed
+    void committed_without_buffer();
+
+    /// The callbacks are normally sent once the buffer is consumed, which won't happen while the surface is occluded
+    void committed_buffer();
+
+    /// Also applies to all children. Pending callbacks are rescheduled when this changes.
+    void set_occluded(bool occluded);
+    auto occluded() const -> bool { return occluded_; }
+
+    /// The child takes the occlusion of this schedule until removed
+    /// @{
+    void add_child(FrameCallbackSchedule* child);
+    void remove_child(FrameCallbackSchedule* child);
+    /// @}
+
+private:
+    void schedule();
+
+    std::shared_ptr<Executor> const frame_callback_executor;
+    std::shared_ptr<Executor> const occluded_frame_callback_executor;
+    std::function<bool()> const callbacks_pending;
+    std::function<void()> const send_callbacks;
+    std::vector<FrameCallbackSchedule*> children;
+    bool occluded_{false};
+};
+}
+}
+
+#endif // MIR_FRONTEND_FRAME_CALLBACK_SCHEDULE_H_
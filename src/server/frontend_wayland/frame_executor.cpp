@@ -27,7 +27,7 @@ namespace mf = mir::frontend;
 
 namespace
 {
-auto const delay = std::chrono::milliseconds{16};
+auto const frame_delay = std::chrono::milliseconds{16};
 }
 
 struct mf::FrameExecutor::Callbacks
@@ -37,7 +37,13 @@ struct mf::FrameExecutor::Callbacks
 };
 
 mf::FrameExecutor::FrameExecutor(time::AlarmFactory& alarm_factory)
-    : callbacks{std::make_shared<Callbacks>()},
+    : FrameExecutor{alarm_factory, frame_delay}
+{
+}
+
+mf::FrameExecutor::FrameExecutor(time::AlarmFactory& alarm_factory, std::chrono::milliseconds delay)
+    : delay{delay},
+      callbacks{std::make_shared<Callbacks>()},
       alarm{alarm_factory.create_alarm([weak_callbacks = std::weak_ptr<Callbacks>{callbacks}]()
           {
               fire_callbacks(weak_callbacks);
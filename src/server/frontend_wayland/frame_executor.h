@@ -21,6 +21,7 @@
 
 #include <mir/executor.h>
 
+#include <chrono>
 #include <memory>
 
 namespace mir
@@ -39,6 +40,8 @@ class FrameExecutor : public Executor
 {
 public:
     explicit FrameExecutor(time::AlarmFactory& alarm_factory);
+    /// Runs callbacks \a delay after the first is queued, rather than after a typical frame time
+    FrameExecutor(time::AlarmFactory& alarm_factory, std::chrono::milliseconds delay);
 
     // This can be called from any thread. Given callback is run on the main loop thread. The wayland executor is NOT
     // automatically used.
@@ -47,6 +50,7 @@ public:
 private:
     struct Callbacks;
 
+    std::chrono::milliseconds const delay;
     std::shared_ptr<Callbacks> const callbacks; // shared_ptr so it can potentially outlive this object
     std::unique_ptr<time::Alarm> const alarm;
 
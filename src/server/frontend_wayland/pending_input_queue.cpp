@@ -0,0 +1,43 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "pending_input_queue.h"
+
+namespace mf = mir::frontend;
+
+auto mf::PendingInputQueue::push(EventUPtr&& event) -> bool
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    bool const was_empty = pending.empty();
+    pending.push_back(std::move(event));
+    return was_empty;
+}
+
+void mf::PendingInputQueue::drain(std::function<void(MirEvent const* event)> const& handle)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        std::swap(pending, draining);
+    }
+
+    for (auto const& event : draining)
+    {
+        handle(event.get());
+    }
+
+    draining.clear();
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_FRONTEND_PENDING_INPUT_QUEUE_H_
+#define MIR_FRONTEND_PENDING_INPUT_QUEUE_H_
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+struct MirEvent;
+
+namespace mir
+{
+namespace frontend
+{
+/// Collects input consumed on any thread so it can be sent to the client in batches on the Wayland thread, costing
+/// one wake of the Wayland thread (and one client flush) per burst rather than per event
+class PendingInputQueue
+{
+public:
+    using EventUPtr = std::unique_ptr<MirEvent, void(*)(MirEvent*)>;
+
+    /// Queues \a event, returns true if the queue was empty and so the caller needs to arrange for drain() to be
+    /// called. Otherwise a drain() is already due and will pick this event up.
+    auto push(EventUPtr&& event) -> bool;
+
+    /// Passes each event queued so far to \a handle in order. Events pushed while this is running are left for the
+    /// next drain(). Should only be called from one thread at a time.
+    void drain(std::function<void(MirEvent const* event)> const& handle);
+
+private:
+    std::mutex mutex;
+    /// Input pushed since the last drain() started, protected by mutex
+    std::vector<EventUPtr> pending;
+    /// Only used by drain(), kept so its capacity is reused between batches
+    std::vector<EventUPtr> draining;
+};
+}
+}
+
+#endif // MIR_FRONTEND_PENDING_INPUT_QUEUE_H_
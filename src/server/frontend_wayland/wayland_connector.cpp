@@ -100,11 +100,15 @@ public:
         struct wl_display* display,
         std::shared_ptr<mir::Executor> const& wayland_executor,
         std::shared_ptr<mir::Executor> const& frame_callback_executor,
-        std::shared_ptr<mg::GraphicBufferAllocator> const& allocator)
+        std::shared_ptr<mir::Executor> const& occluded_frame_callback_executor,
+        std::shared_ptr<mg::GraphicBufferAllocator> const& allocator,
+        std::shared_ptr<mc::InputLatencyReport> const& latency_report)
         : Global(display, Version<4>()),
           allocator{allocator},
           wayland_executor{wayland_executor},
-          frame_callback_executor{frame_callback_executor}
+          frame_callback_executor{frame_callback_executor},
+          occluded_frame_callback_executor{occluded_frame_callback_executor},
+          latency_report{latency_report}
     {
     }
 
@@ -114,6 +118,8 @@ private:
     std::shared_ptr<mg::GraphicBufferAllocator> const allocator;
     std::shared_ptr<mir::Executor> const wayland_executor;
     std::shared_ptr<mir::Executor> const frame_callback_executor;
+    std::shared_ptr<mir::Executor> const occluded_frame_callback_executor;
+    std::shared_ptr<mc::InputLatencyReport> const latency_report;
     std::map<std::pair<wl_client*, uint32_t>, std::vector<std::function<void(WlSurface*)>>> surface_callbacks;
 
     class Instance : wayland::Compositor
@@ -157,7 +163,9 @@ void WlCompositor::Instance::create_surface(wl_resource* new_surface)
         new_surface,
         compositor->wayland_executor,
         compositor->frame_callback_executor,
-        compositor->allocator};
+        compositor->occluded_frame_callback_executor,
+        compositor->allocator,
+        compositor->latency_report};
     auto const key = std::make_pair(wl_resource_get_client(new_surface), wl_resource_get_id(new_surface));
     auto const callbacks = compositor->surface_callbacks.find(key);
     if (callbacks != compositor->surface_callbacks.end())
@@ -498,6 +506,7 @@ mf::WaylandConnector::WaylandConnector(
     std::shared_ptr<mi::Seat> const& seat,
     std::shared_ptr<mi::InputDeviceRegistry> const& input_device_registry,
     std::shared_ptr<mg::GraphicBufferAllocator> const& allocator,
+    std::shared_ptr<mc::InputLatencyReport> const& latency_report,
     std::shared_ptr<mf::SessionAuthorizer> const& session_authorizer,
     std::shared_ptr<SurfaceStack> const& surface_stack,
     std::shared_ptr<ms::Clipboard> const& clipboard,
@@ -506,7 +515,9 @@ mf::WaylandConnector::WaylandConnector(
     bool arw_socket,
     std::unique_ptr<WaylandExtensions> extensions_,
     WaylandProtocolExtensionFilter const& extension_filter,
-    bool enable_key_repeat)
+    bool enable_key_repeat,
+    std::chrono::milliseconds occluded_frame_interval,
+    ClientResourceLimits const& client_resource_limits)
     : display{wl_display_create(), &cleanup_display},
       pause_signal{eventfd(0, EFD_CLOEXEC | EFD_SEMAPHORE)},
       executor{std::make_shared<WaylandExecutor>(wl_display_get_event_loop(display.get()))},
@@ -548,7 +559,10 @@ mf::WaylandConnector::WaylandConnector(
         display.get(),
         executor,
         std::make_shared<FrameExecutor>(*main_loop),
-        this->allocator);
+        occluded_frame_interval.count() > 0 ?
+            std::make_shared<FrameExecutor>(*main_loop, occluded_frame_interval) : nullptr,
+        this->allocator,
+        latency_report);
     subcompositor_global = std::make_unique<mf::WlSubcompositor>(display.get());
     seat_global = std::make_unique<mf::WlSeat>(display.get(), clock, input_hub, seat, enable_key_repeat);
     output_manager = std::make_unique<mf::OutputManager>(
@@ -602,7 +616,14 @@ mf::WaylandConnector::WaylandConnector(
 
     auto wayland_loop = wl_display_get_event_loop(display.get());
 
-    WlClient::setup_new_client_handler(display.get(), shell, session_authorizer, [this](WlClient& client)
+    WlClient::setup_new_client_handler(
+        display.get(),
+        shell,
+        session_authorizer,
+        client_resource_limits,
+        clock,
+        executor,
+        [this](WlClient& client)
         {
             int const fd = wl_client_get_fd(client.raw_client());
             auto const handler_iter = connect_handlers.find(fd);
@@ -24,6 +24,7 @@
 #include "mir/optional_value.h"
 
 #include <wayland-server-core.h>
+#include <chrono>
 #include <unordered_map>
 #include <thread>
 #include <vector>
@@ -43,6 +44,10 @@ namespace graphics
 {
 class GraphicBufferAllocator;
 }
+namespace compositor
+{
+class InputLatencyReport;
+}
 namespace geometry
 {
 struct Size;
@@ -71,6 +76,8 @@ class SessionAuthorizer;
 class WlDataDeviceManager;
 class WlSurface;
 class SurfaceStack;
+class WaylandExecutor;
+struct ClientResourceLimits;
 
 class WaylandExtensions
 {
@@ -122,6 +129,7 @@ public:
         std::shared_ptr<input::Seat> const& seat,
         std::shared_ptr<input::InputDeviceRegistry> const& input_device_registry,
         std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
+        std::shared_ptr<compositor::InputLatencyReport> const& latency_report,
         std::shared_ptr<SessionAuthorizer> const& session_authorizer,
         std::shared_ptr<SurfaceStack> const& surface_stack,
         std::shared_ptr<scene::Clipboard> const& clipboard,
@@ -130,7 +138,9 @@ public:
         bool arw_socket,
         std::unique_ptr<WaylandExtensions> extensions,
         WaylandProtocolExtensionFilter const& extension_filter,
-        bool enable_key_repeat);
+        bool enable_key_repeat,
+        std::chrono::milliseconds occluded_frame_interval,
+        ClientResourceLimits const& client_resource_limits);
 
     ~WaylandConnector() override;
 
@@ -163,7 +173,7 @@ private:
     std::unique_ptr<WlSeat> seat_global;
     std::unique_ptr<OutputManager> output_manager;
     std::unique_ptr<WlDataDeviceManager> data_device_manager_global;
-    std::shared_ptr<Executor> const executor;
+    std::shared_ptr<WaylandExecutor> const executor;
     std::shared_ptr<graphics::GraphicBufferAllocator> const allocator;
     std::shared_ptr<shell::Shell> const shell;
     std::unique_ptr<WaylandExtensions> const extensions;
@@ -20,6 +20,7 @@
 #include "mir/frontend/wayland.h"
 
 #include "wayland_connector.h"
+#include "wl_client.h"
 #include "xdg_shell_v6.h"
 #include "xdg_shell_stable.h"
 #include "layer_shell_v1.h"
@@ -267,6 +268,17 @@ std::shared_ptr<mf::Connector>
                 the_display_configuration_observer_registrar());
 
             auto const enable_repeat = options->get<bool>(options::enable_key_repeat_opt);
+            auto const occluded_frame_interval =
+                std::chrono::milliseconds{options->get<int>(options::occluded_frame_interval_opt)};
+            mf::ClientResourceLimits client_resource_limits;
+            client_resource_limits.surfaces =
+                options->get<int>(options::client_max_surfaces_opt);
+            client_resource_limits.pending_frame_callbacks =
+                options->get<int>(options::client_max_frame_callbacks_opt);
+            client_resource_limits.commits_per_second =
+                options->get<int>(options::client_max_commit_rate_opt);
+            client_resource_limits.buffer_memory =
+                size_t(options->get<int>(options::client_max_buffer_memory_opt)) * 1024 * 1024;
 
             return std::make_shared<mf::WaylandConnector>(
                 the_shell(),
@@ -276,6 +288,7 @@ std::shared_ptr<mf::Connector>
                 the_seat(),
                 the_input_device_registry(),
                 the_buffer_allocator(),
+                the_input_latency_report(),
                 the_session_authorizer(),
                 the_frontend_surface_stack(),
                 the_clipboard(),
@@ -287,7 +300,9 @@ std::shared_ptr<mf::Connector>
                     options->is_set(mo::x11_display_opt),
                     wayland_extension_hooks),
                 wayland_extension_filter,
-                enable_repeat);
+                enable_repeat,
+                occluded_frame_interval,
+                client_resource_limits);
         });
 }
 
@@ -130,6 +130,9 @@ public:
         return lock;
     }
 
+    /// Runs everything in the workqueue
+    void run_work();
+
     static int on_notify(int fd, uint32_t, void* data);
 private:
     static thread_local bool on_wayland_thread;
@@ -233,7 +236,14 @@ int mf::WaylandExecutor::State::on_notify(int fd, uint32_t, void* data)
             err);
     }
 
-    while (auto work = state->get_work())
+    state->run_work();
+
+    return 0;
+}
+
+void mf::WaylandExecutor::State::run_work()
+{
+    while (auto work = get_work())
     {
         try
         {
@@ -248,12 +258,10 @@ int mf::WaylandExecutor::State::on_notify(int fd, uint32_t, void* data)
                 "Exception processing Wayland event loop work item");
         }
     }
-    if (state->state != ExecutionState::Running)
+    if (state != ExecutionState::Running)
     {
-        EventLoopDestroyedHandler::remove_destruction_handler_for_loop(state->loop);
+        EventLoopDestroyedHandler::remove_destruction_handler_for_loop(loop);
     }
-
-    return 0;
 }
 
 
@@ -324,6 +332,11 @@ mf::WaylandExecutor::~WaylandExecutor()
     }
 }
 
+void mf::WaylandExecutor::run_pending_work()
+{
+    state->run_work();
+}
+
 void mf::WaylandExecutor::spawn (std::function<void()>&& work)
 {
     state->enqueue(std::move(work));
@@ -40,6 +40,11 @@ public:
 
     void spawn(std::function<void()>&& work) override;
 
+    /// Runs any spawned work that is waiting, rather than leaving it until the event loop reaches our source (which
+    /// may be behind requests from every busy client). Must be called on the Wayland thread between dispatches, for
+    /// example from an idle source, never while a request is being dispatched.
+    void run_pending_work();
+
     class State;
 private:
     std::shared_ptr<State> state;
@@ -70,6 +70,7 @@ void mf::WaylandInputDispatcher::handle_event(MirInputEvent const* event)
     if (mir_input_event_has_cookie(event))
     {
         timestamp = std::chrono::nanoseconds{mir_input_event_get_event_time(event)};
+        wl_surface.value().input_sent(timestamp);
     }
 
     switch (mir_input_event_get_type(event))
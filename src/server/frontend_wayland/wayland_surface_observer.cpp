@@ -68,6 +68,16 @@ void mf::WaylandSurfaceObserver::attrib_changed(ms::Surface const*, MirWindowAtt
             {
                 impl->current_state = static_cast<MirWindowState>(value);
                 window->handle_state_change(impl->current_state);
+                impl->update_occlusion(window);
+            });
+        break;
+
+    case mir_window_attrib_visibility:
+        run_on_wayland_thread_unless_window_destroyed(
+            [value](Impl* impl, WindowWlSurfaceRole* window)
+            {
+                impl->visibility = static_cast<MirWindowVisibility>(value);
+                impl->update_occlusion(window);
             });
         break;
 
@@ -75,6 +85,16 @@ void mf::WaylandSurfaceObserver::attrib_changed(ms::Surface const*, MirWindowAtt
     }
 }
 
+void mf::WaylandSurfaceObserver::hidden_set_to(ms::Surface const*, bool hide)
+{
+    run_on_wayland_thread_unless_window_destroyed(
+        [hide](Impl* impl, WindowWlSurfaceRole* window)
+        {
+            impl->hidden = hide;
+            impl->update_occlusion(window);
+        });
+}
+
 void mf::WaylandSurfaceObserver::content_resized_to(ms::Surface const*, geom::Size const& content_size)
 {
     run_on_wayland_thread_unless_window_destroyed(
@@ -111,14 +131,18 @@ void mf::WaylandSurfaceObserver::input_consumed(ms::Surface const*, MirEvent con
 {
     if (mir_event_get_type(event) == mir_event_type_input)
     {
-        std::shared_ptr<MirEvent> owned_event = mev::clone_event(*event);
-
-        run_on_wayland_thread_unless_window_destroyed(
-            [owned_event](Impl* impl, WindowWlSurfaceRole*)
-            {
-                auto const input_event = mir_event_get_input_event(owned_event.get());
-                impl->input_dispatcher->handle_event(input_event);
-            });
+        if (impl->pending_input.push(mev::clone_event(*event)))
+        {
+            run_on_wayland_thread_unless_window_destroyed(
+                [](Impl* impl, WindowWlSurfaceRole*)
+                {
+                    impl->pending_input.drain(
+                        [impl](MirEvent const* event)
+                        {
+                            impl->input_dispatcher->handle_event(mir_event_get_input_event(event));
+                        });
+                });
+        }
     }
 }
 
@@ -127,6 +151,22 @@ auto mf::WaylandSurfaceObserver::latest_timestamp() const -> std::chrono::nanose
     return impl->input_dispatcher->latest_timestamp();
 }
 
+void mf::WaylandSurfaceObserver::Impl::update_occlusion(WindowWlSurfaceRole* window)
+{
+    // Minimized and hidden windows aren't composited at all, so never get reported as occluded
+    bool const now_occluded =
+        visibility == mir_window_visibility_occluded ||
+        hidden ||
+        current_state == mir_window_state_minimized ||
+        current_state == mir_window_state_hidden;
+
+    if (now_occluded != occluded)
+    {
+        occluded = now_occluded;
+        window->set_occluded(occluded);
+    }
+}
+
 void mf::WaylandSurfaceObserver::run_on_wayland_thread_unless_window_destroyed(
     std::function<void(Impl* impl, WindowWlSurfaceRole* window)>&& work)
 {
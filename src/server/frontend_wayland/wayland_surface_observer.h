@@ -21,6 +21,7 @@
 #define MIR_FRONTEND_WAYLAND_SURFACE_OBSERVER_H_
 
 #include "wayland_input_dispatcher.h"
+#include "pending_input_queue.h"
 #include <mir/scene/null_surface_observer.h>
 
 #include <memory>
@@ -49,6 +50,7 @@ public:
     /// Overrides from scene::SurfaceObserver
     ///@{
     void attrib_changed(scene::Surface const*, MirWindowAttrib attrib, int value) override;
+    void hidden_set_to(scene::Surface const*, bool hide) override;
     void content_resized_to(scene::Surface const*, geometry::Size const& content_size) override;
     void client_surface_close_requested(scene::Surface const*) override;
     void placed_relative(scene::Surface const*, geometry::Rectangle const& placement) override;
@@ -93,6 +95,15 @@ private:
         geometry::Size window_size{};
         std::optional<geometry::Size> requested_size{};
         MirWindowState current_state{mir_window_state_unknown};
+        MirWindowVisibility visibility{mir_window_visibility_exposed};
+        bool hidden{false};
+        bool occluded{false};
+
+        /// Tells the window whether any output shows it, should only be called from the Wayland thread
+        void update_occlusion(WindowWlSurfaceRole* window);
+
+        /// Drained on the Wayland thread
+        PendingInputQueue pending_input;
     };
 
     void run_on_wayland_thread_unless_window_destroyed(
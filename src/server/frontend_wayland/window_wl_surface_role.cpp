@@ -185,6 +185,14 @@ void mf::WindowWlSurfaceRole::set_application_id(std::string const& application_
     }
 }
 
+void mf::WindowWlSurfaceRole::set_occluded(bool occluded)
+{
+    if (surface)
+    {
+        surface.value().set_occluded(occluded);
+    }
+}
+
 void mf::WindowWlSurfaceRole::initiate_interactive_move()
 {
     if (auto const scene_surface = weak_scene_surface.lock())
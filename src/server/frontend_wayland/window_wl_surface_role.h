@@ -95,6 +95,9 @@ public:
     void remove_state_now(MirWindowState state);
     void create_scene_surface();
 
+    /// Whether no output currently shows the window (it's occluded, minimized or hidden)
+    void set_occluded(bool occluded);
+
     /// Gets called after the surface has committed (so current_size() may return the committed buffer size) but before
     /// the Mir window is modified (so if a pending size is set or a spec is applied those changes will take effect)
     virtual void handle_commit() = 0;
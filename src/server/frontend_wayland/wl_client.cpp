@@ -19,13 +19,18 @@
 #include "wl_client.h"
 
 #include "null_event_sink.h"
+#include "wayland_executor.h"
+#include "wayland_frontend.tp.h"
 #include "mir/frontend/session_authorizer.h"
 #include "mir/frontend/session_credentials.h"
 #include "mir/shell/shell.h"
 #include "mir/scene/session.h"
+#include "mir/log.h"
 
 #include <wayland-server-core.h>
 
+#include <time.h>
+
 namespace mf = mir::frontend;
 namespace ms = mir::scene;
 namespace msh = mir::shell;
@@ -38,17 +43,28 @@ struct ConstructionCtx
     ConstructionCtx(
         std::shared_ptr<msh::Shell> const& shell,
         std::shared_ptr<mf::SessionAuthorizer> const& session_authorizer,
+        mf::ClientResourceLimits const& resource_limits,
+        std::shared_ptr<mir::time::Clock> const& clock,
+        std::shared_ptr<mf::WaylandExecutor> const& executor,
         std::function<void(mf::WlClient&)>&& client_created_callback)
         : shell{shell},
           session_authorizer{session_authorizer},
+          resource_limits{resource_limits},
+          clock{clock},
+          executor{executor},
           client_created_callback{std::make_unique<std::function<void(mf::WlClient&)>>(std::move(client_created_callback))}
     {
     }
 
     wl_listener client_construction_listener;
     wl_listener display_destruction_listener;
+    wl_protocol_logger* request_accounting{nullptr};
     std::shared_ptr<msh::Shell> const shell;
     std::shared_ptr<mf::SessionAuthorizer> const session_authorizer;
+    mf::ClientResourceLimits const resource_limits;
+    std::shared_ptr<mir::time::Clock> const clock;
+    /// Weak as the executor is destroyed before the display
+    std::weak_ptr<mf::WaylandExecutor> const executor;
     /// Needs to be a pointer so std::is_standard_layout passes
     std::unique_ptr<std::function<void(mf::WlClient&)>> const client_created_callback;
 };
@@ -84,9 +100,92 @@ void cleanup_construction_ctx(wl_listener* listener, void*)
 {
     ConstructionCtx* construction_context;
     construction_context = wl_container_of(listener, construction_context, display_destruction_listener);
+    wl_protocol_logger_destroy(construction_context->request_accounting);
     delete construction_context;
 }
 
+/*
+ * Request accounting:
+ *
+ * libwayland doesn't tell us when it starts and finishes dispatching a client's requests, but a protocol logger is
+ * called before each request is dispatched and as each event is sent. So the Wayland thread's CPU time is charged to a
+ * client from its first request until either a request or event for another client is seen or the event loop finishes
+ * dispatching (when its idle sources run). Events for the charged client are assumed to be part of handling its
+ * requests.
+ *
+ * The end of an iteration that dispatched requests is also where work spawned on the WaylandExecutor is run. Otherwise
+ * it waits for the event loop to reach the executor's source, which may be behind another round of requests from every
+ * busy client, delaying input and frame callbacks for everyone. (libwayland offers no safe point to stop dispatching a
+ * single client's requests part way through, so this is as close as we can get to capping them.)
+ */
+thread_local mf::WlClient* charged_client{nullptr};
+thread_local std::chrono::nanoseconds charge_start;
+thread_local size_t charged_requests{0};
+thread_local bool charge_end_scheduled{false};
+
+auto thread_cpu_time() -> std::chrono::nanoseconds
+{
+    timespec now;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &now);
+    return std::chrono::seconds{now.tv_sec} + std::chrono::nanoseconds{now.tv_nsec};
+}
+
+void end_charge()
+{
+    if (charged_client)
+    {
+        charged_client->requests_dispatched(charged_requests, thread_cpu_time() - charge_start);
+        charged_client = nullptr;
+    }
+}
+
+void end_dispatch_when_idle(void* data)
+{
+    auto const ctx = static_cast<ConstructionCtx*>(data);
+    charge_end_scheduled = false;
+    end_charge();
+
+    if (auto const executor = ctx->executor.lock())
+    {
+        executor->run_pending_work();
+    }
+}
+
+void account_protocol_message(void* data, wl_protocol_logger_type type, wl_protocol_logger_message const* message)
+{
+    auto const client = wl_resource_get_client(message->resource);
+
+    if (charged_client && charged_client->raw_client() == client)
+    {
+        if (type == WL_PROTOCOL_LOGGER_REQUEST)
+        {
+            charged_requests++;
+        }
+        return;
+    }
+
+    end_charge();
+
+    if (type == WL_PROTOCOL_LOGGER_REQUEST)
+    {
+        if (auto const wl_client = mf::WlClient::from(client))
+        {
+            charged_client = wl_client;
+            charged_requests = 1;
+            charge_start = thread_cpu_time();
+
+            if (!charge_end_scheduled)
+            {
+                charge_end_scheduled = true;
+                wl_event_loop_add_idle(
+                    wl_display_get_event_loop(wl_client_get_display(client)),
+                    &end_dispatch_when_idle,
+                    data);
+            }
+        }
+    }
+}
+
 void cleanup_client_ctx(wl_listener* listener, void* /*data*/)
 {
     auto const ctx = ClientCtx::from(listener);
@@ -101,9 +200,18 @@ void mf::WlClient::setup_new_client_handler(
     wl_display* display,
     std::shared_ptr<shell::Shell> const& shell,
     std::shared_ptr<SessionAuthorizer> const& session_authorizer,
+    ClientResourceLimits const& resource_limits,
+    std::shared_ptr<time::Clock> const& clock,
+    std::shared_ptr<WaylandExecutor> const& executor,
     std::function<void(WlClient&)>&& client_created_callback)
 {
-    auto context = new ConstructionCtx{shell, session_authorizer, std::move(client_created_callback)};
+    auto context = new ConstructionCtx{
+        shell,
+        session_authorizer,
+        resource_limits,
+        clock,
+        executor,
+        std::move(client_created_callback)};
 
     context->client_construction_listener.notify = &handle_client_created;
     wl_display_add_client_created_listener(display, &context->client_construction_listener);
@@ -111,6 +219,8 @@ void mf::WlClient::setup_new_client_handler(
     // This handles deleting the ConstructionCtx we just created when the display is destoryed
     context->display_destruction_listener.notify = &cleanup_construction_ctx;
     wl_display_add_destroy_listener(display, &context->display_destruction_listener);
+
+    context->request_accounting = wl_display_add_protocol_logger(display, &account_protocol_message, context);
 }
 
 auto mf::WlClient::from(wl_client* client) -> WlClient*
@@ -126,14 +236,105 @@ auto mf::WlClient::from(wl_client* client) -> WlClient*
 
 mf::WlClient::~WlClient()
 {
+    if (charged_client == this)
+    {
+        end_charge();
+    }
+
+    pid_t pid;
+    wl_client_get_credentials(client, &pid, nullptr, nullptr);
+    log_debug(
+        "Client with PID %d disconnected after %zu requests, dispatched in %lld ms of Wayland thread time",
+        pid,
+        resource_usage().requests,
+        static_cast<long long>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(resource_usage().wayland_thread_time).count()));
+
     shell->close_session(session);
 }
 
-mf::WlClient::WlClient(wl_client* client, std::shared_ptr<ms::Session> const& session, msh::Shell* shell)
+mf::WlClient::WlClient(
+    wl_client* client,
+    std::shared_ptr<ms::Session> const& session,
+    msh::Shell* shell,
+    ClientResourceLimits const& resource_limits,
+    std::shared_ptr<time::Clock> const& clock)
     : shell{shell},
       client{client},
-      session{session}
+      session{session},
+      resources{
+          resource_limits,
+          clock,
+          [this](char const* resource, size_t value, size_t limit) { limit_exceeded(resource, value, limit); }}
+{
+}
+
+void mf::WlClient::surface_created()
+{
+    resources.surface_created();
+}
+
+void mf::WlClient::surface_destroyed()
+{
+    resources.surface_destroyed();
+}
+
+void mf::WlClient::frame_callback_requested()
+{
+    resources.frame_callback_requested();
+}
+
+void mf::WlClient::frame_callback_done()
+{
+    resources.frame_callback_done();
+}
+
+void mf::WlClient::surface_committed()
+{
+    resources.surface_committed();
+}
+
+void mf::WlClient::buffer_memory_changed(size_t old_bytes, size_t new_bytes)
+{
+    resources.buffer_memory_changed(old_bytes, new_bytes);
+}
+
+void mf::WlClient::requests_dispatched(size_t requests, std::chrono::nanoseconds thread_time)
+{
+    resources.requests_dispatched(requests, thread_time);
+    tracepoint(mir_server_wayland, client_requests_dispatched, client, requests, thread_time.count());
+
+    auto const& usage = resource_usage();
+    tracepoint(
+        mir_server_wayland,
+        client_resource_usage,
+        client,
+        usage.surfaces,
+        usage.pending_frame_callbacks,
+        usage.commits_per_second,
+        usage.buffer_memory);
+}
+
+void mf::WlClient::limit_exceeded(char const* resource, size_t value, size_t limit)
 {
+    auto const& usage = resource_usage();
+
+    pid_t pid;
+    wl_client_get_credentials(client, &pid, nullptr, nullptr);
+    log_warning(
+        "Disconnecting client with PID %d: it has %zu %s, more than its limit of %zu "
+        "(usage: %zu surfaces, %zu pending frame callbacks, %zu commits in the last second, %zu bytes of buffers)",
+        pid,
+        value,
+        resource,
+        limit,
+        usage.surfaces,
+        usage.pending_frame_callbacks,
+        usage.commits_per_second,
+        usage.buffer_memory);
+
+    // The client is disconnected once the error is flushed
+    wl_client_post_no_memory(client);
 }
 
 void mf::WlClient::handle_client_created(wl_listener* listener, void* data)
@@ -161,7 +362,12 @@ void mf::WlClient::handle_client_created(wl_listener* listener, void* data)
 
     // Can't use std::make_unique because WlClient constructor is private
     auto wl_client = std::unique_ptr<mf::WlClient>{
-        new mf::WlClient{client, session, construction_context->shell.get()}};
+        new mf::WlClient{
+            client,
+            session,
+            construction_context->shell.get(),
+            construction_context->resource_limits,
+            construction_context->clock}};
     auto client_context = new ClientCtx{std::move(wl_client)};
     client_context->destroy_listener.notify = &cleanup_client_ctx;
     wl_client_add_destroy_listener(client, &client_context->destroy_listener);
@@ -25,7 +25,10 @@ struct wl_display;
 
 #include <memory>
 #include <functional>
+#include <chrono>
+#include <cstddef>
 
+#include "client_resource_account.h"
 #include "mir/wayland/wayland_base.h"
 
 namespace mir
@@ -38,10 +41,15 @@ namespace scene
 {
 class Session;
 }
+namespace time
+{
+class Clock;
+}
 
 namespace frontend
 {
 class SessionAuthorizer;
+class WaylandExecutor;
 
 class WlClient : public wayland::LifetimeTracker
 {
@@ -52,6 +60,9 @@ public:
         wl_display* display,
         std::shared_ptr<shell::Shell> const& shell,
         std::shared_ptr<SessionAuthorizer> const& session_authorizer,
+        ClientResourceLimits const& resource_limits,
+        std::shared_ptr<time::Clock> const& clock,
+        std::shared_ptr<WaylandExecutor> const& executor,
         std::function<void(WlClient&)>&& client_created_callback);
 
     static auto from(wl_client* client) -> WlClient*;
@@ -76,8 +87,31 @@ public:
     auto output_geometry_scale() -> float { return output_geometry_scale_; }
     /// @}
 
+    /// Resource accounting, should only be called on the Wayland thread. A client that goes over one of its limits is
+    /// sent a no_memory error, which disconnects it.
+    /// @{
+    void surface_created();
+    void surface_destroyed();
+    void frame_callback_requested();
+    void frame_callback_done();
+    void surface_committed();
+    void buffer_memory_changed(size_t old_bytes, size_t new_bytes);
+    void requests_dispatched(size_t requests, std::chrono::nanoseconds thread_time);
+    /// @}
+
+    /// What the client currently has, for monitoring
+    auto resource_usage() const -> ClientResourceUsage const& { return resources.usage(); }
+
 private:
-    WlClient(wl_client* client, std::shared_ptr<scene::Session> const& session, shell::Shell* shell);
+    WlClient(
+        wl_client* client,
+        std::shared_ptr<scene::Session> const& session,
+        shell::Shell* shell,
+        ClientResourceLimits const& resource_limits,
+        std::shared_ptr<time::Clock> const& clock);
+
+    /// Disconnects the client, called the first time it exceeds a limit
+    void limit_exceeded(char const* resource, size_t value, size_t limit);
 
     static void handle_client_created(wl_listener* listener, void* data);
 
@@ -87,6 +121,8 @@ private:
     std::shared_ptr<scene::Session> const session;
 
     float output_geometry_scale_{1};
+
+    ClientResourceAccount resources;
 };
 }
 }
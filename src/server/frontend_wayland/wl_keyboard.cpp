@@ -23,8 +23,8 @@
 #include "wl_seat.h"
 
 #include "mir/executor.h"
-#include "mir/anonymous_shm_file.h"
 #include "mir/input/keymap.h"
+#include "mir/input/compiled_keymap.h"
 #include "mir/input/xkb_mapper.h"
 #include "mir/log.h"
 #include "mir/fatal.h"
@@ -46,9 +46,7 @@ mf::WlKeyboard::WlKeyboard(
     bool enable_key_repeat)
     : Keyboard(new_resource, Version<6>()),
       current_keymap{nullptr}, // will be set later in the constructor by set_keymap()
-      compiled_keymap{nullptr, &xkb_keymap_unref},
       state{nullptr, &xkb_state_unref},
-      context{xkb_context_new(XKB_CONTEXT_NO_FLAGS), &xkb_context_unref},
       acquire_current_keyboard_state{acquire_current_keyboard_state}
 {
     /* The wayland::Keyboard constructor has already run, creating the keyboard
@@ -182,7 +180,7 @@ void mf::WlKeyboard::focussed(WlSurface& surface, bool should_be_focused)
 void mf::WlKeyboard::update_keyboard_state(std::vector<uint32_t> const& keyboard_state)
 {
     // Rebuild xkb state
-    state = decltype(state)(xkb_state_new(compiled_keymap.get()), &xkb_state_unref);
+    state = compiled_keymap->make_state();
     for (auto scancode : keyboard_state)
     {
         xkb_state_update_key(state.get(), scancode + 8, XKB_KEY_DOWN);
@@ -205,23 +203,14 @@ void mf::WlKeyboard::set_keymap(std::shared_ptr<mi::Keymap> const& new_keymap)
     }
 
     current_keymap = new_keymap;
-    compiled_keymap = new_keymap->make_unique_xkb_keymap(context.get());
+    compiled_keymap = mi::CompiledKeymap::of(new_keymap);
 
     // TODO: We might need to copy across the existing depressed keys?
-    state = decltype(state)(xkb_state_new(compiled_keymap.get()), &xkb_state_unref);
-
-    std::unique_ptr<char, void(*)(void*)> buffer{xkb_keymap_get_as_string(
-        compiled_keymap.get(),
-        XKB_KEYMAP_FORMAT_TEXT_V1),
-        free};
-    auto length = strlen(buffer.get());
-
-    mir::AnonymousShmFile shm_buffer{length};
-    memcpy(shm_buffer.base_ptr(), buffer.get(), length);
+    state = compiled_keymap->make_state();
 
     send_keymap_event(KeymapFormat::xkb_v1,
-                      Fd{IntOwnedFd{shm_buffer.fd()}},
-                      length);
+                      compiled_keymap->text_fd(),
+                      compiled_keymap->text_size());
 }
 
 void mf::WlKeyboard::update_modifier_state()
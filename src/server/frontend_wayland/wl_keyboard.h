@@ -28,9 +28,7 @@
 struct MirKeyboardEvent;
 
 // from <xkbcommon/xkbcommon.h>
-struct xkb_keymap;
 struct xkb_state;
-struct xkb_context;
 
 namespace mir
 {
@@ -40,6 +38,7 @@ class Executor;
 namespace input
 {
 class Keymap;
+class CompiledKeymap;
 }
 
 namespace frontend
@@ -67,9 +66,8 @@ private:
     void update_keyboard_state(std::vector<uint32_t> const& keyboard_state);
 
     std::shared_ptr<mir::input::Keymap> current_keymap;
-    std::unique_ptr<xkb_keymap, void (*)(xkb_keymap *)> compiled_keymap;
+    std::shared_ptr<mir::input::CompiledKeymap const> compiled_keymap;
     std::unique_ptr<xkb_state, void (*)(xkb_state *)> state;
-    std::unique_ptr<xkb_context, void (*)(xkb_context *)> const context;
 
     std::function<std::vector<uint32_t>()> const acquire_current_keyboard_state;
 
@@ -18,6 +18,7 @@
 
 #include "wl_pointer.h"
 
+#include "cursor_image_cache.h"
 #include "wayland_utils.h"
 #include "wl_surface.h"
 #include "wl_seat.h"
@@ -31,12 +32,10 @@
 #include "mir/geometry/displacement.h"
 #include "mir/graphics/cursor_image.h"
 #include "mir/graphics/buffer.h"
-#include "mir/renderer/sw/pixel_source.h"
 #include "mir/compositor/buffer_stream.h"
 
 #include <linux/input-event-codes.h>
 #include <boost/throw_exception.hpp>
-#include <string.h> // memcpy
 
 namespace mf = mir::frontend;
 namespace ms = mir::scene;
@@ -44,60 +43,9 @@ namespace geom = mir::geometry;
 namespace mw = mir::wayland;
 namespace mg = mir::graphics;
 namespace mc = mir::compositor;
-namespace mrs = mir::renderer::software;
 
 namespace
 {
-class BufferCursorImage : public mg::CursorImage
-{
-public:
-    BufferCursorImage(std::shared_ptr<mg::Buffer> buffer, geom::Displacement const& hotspot)
-        : BufferCursorImage(buffer_to_mapping_if_possible(buffer), hotspot)
-    {
-    }
-
-    auto as_argb_8888() const -> void const* override
-    {
-        return data.get();
-    }
-
-    auto size() const -> geom::Size override
-    {
-        return size_;
-    }
-
-    auto hotspot() const -> geom::Displacement override
-    {
-        return hotspot_;
-    }
-
-private:
-    BufferCursorImage(std::unique_ptr<mrs::Mapping<unsigned char const>> mapping, geom::Displacement const& hotspot)
-        : size_{mapping->size()},
-          data{std::make_unique<unsigned char[]>(mapping->len())},
-          hotspot_{hotspot}
-    {
-        ::memcpy(data.get(), mapping->data(), mapping->len());
-    }
-
-    static auto buffer_to_mapping_if_possible(std::shared_ptr<mg::Buffer> const& buffer)
-        -> std::unique_ptr<mrs::Mapping<unsigned char const>>
-    {
-        auto const mappable_buffer = mrs::as_read_mappable_buffer(buffer);
-        if (!mappable_buffer)
-        {
-            BOOST_THROW_EXCEPTION(
-                std::runtime_error{
-                    "Attempt to create cursor from non-CPU-readable buffer. Rendering will be incomplete"});
-        }
-        return mappable_buffer->map_readable();
-    }
-
-    geom::Size const size_;
-    std::unique_ptr<unsigned char[]> const data;
-    geom::Displacement const hotspot_;
-};
-
 static auto const button_mapping = {
     std::make_pair(mir_pointer_button_primary, BTN_LEFT),
     std::make_pair(mir_pointer_button_secondary, BTN_RIGHT),
@@ -141,6 +89,7 @@ struct NullCursor : mf::WlPointer::Cursor
 mf::WlPointer::WlPointer(wl_resource* new_resource)
     : Pointer(new_resource, Version<6>()),
       display{wl_client_get_display(client)},
+      cursor_images{std::make_unique<CursorImageCache>()},
       cursor{std::make_unique<NullCursor>()}
 {
 }
@@ -369,7 +318,8 @@ struct WlSurfaceCursor : mf::WlPointer::Cursor
     WlSurfaceCursor(
         mf::WlSurface* surface,
         geom::Displacement hotspot,
-        mf::CommitHandler* commit_handler);
+        mf::CommitHandler* commit_handler,
+        mf::CursorImageCache& cursor_images);
     ~WlSurfaceCursor();
 
     void apply_to(mf::WlSurface* surface) override;
@@ -382,6 +332,8 @@ private:
     mw::Weak<mf::WlSurface> const surface;
     std::shared_ptr<mc::BufferStream> const stream;
     CursorSurfaceRole surface_role;
+    mf::CursorImageCache& cursor_images;
+    std::shared_ptr<bool> const destroyed;
 
     std::weak_ptr<ms::Surface> surface_under_cursor;
     geom::Displacement hotspot;
@@ -417,7 +369,7 @@ void mf::WlPointer::set_cursor(
         if (!cursor->cursor_surface() || wl_surface != *cursor->cursor_surface())
         {
             cursor.reset(); // clean up old cursor before creating new one
-            cursor = std::make_unique<WlSurfaceCursor>(wl_surface, cursor_hotspot, commit_handler);
+            cursor = std::make_unique<WlSurfaceCursor>(wl_surface, cursor_hotspot, commit_handler, *cursor_images);
             if (surface_under_cursor)
                 cursor->apply_to(&surface_under_cursor.value());
         }
@@ -456,30 +408,41 @@ void mf::WlPointer::on_commit(WlSurface* surface)
         else
         {
             cursor.reset(); // clean up old cursor before creating new one
-            cursor = std::make_unique<WlSurfaceCursor>(surface, cursor_hotspot, commit_handler);
+            cursor = std::make_unique<WlSurfaceCursor>(surface, cursor_hotspot, commit_handler, *cursor_images);
             if (surface_under_cursor)
                 cursor->apply_to(&surface_under_cursor.value());
         }
     }
 }
 
-WlSurfaceCursor::WlSurfaceCursor(mf::WlSurface* surface, geom::Displacement hotspot, mf::CommitHandler* commit_handler)
+WlSurfaceCursor::WlSurfaceCursor(
+    mf::WlSurface* surface,
+    geom::Displacement hotspot,
+    mf::CommitHandler* commit_handler,
+    mf::CursorImageCache& cursor_images)
     : surface{surface},
       stream{surface->stream},
       surface_role{surface, commit_handler},
+      cursor_images{cursor_images},
+      destroyed{std::make_shared<bool>(false)},
       hotspot{hotspot}
 {
     surface->set_role(&surface_role);
 
+    // Frames can be posted from the thread that prepared the buffer, so apply them on the Wayland thread
     stream->set_frame_posted_callback(
-        [this](auto)
+        [this, executor = surface->executor(), destroyed = destroyed](auto)
         {
-            this->apply_latest_buffer();
+            executor->spawn(run_unless(destroyed, [this]()
+                {
+                    this->apply_latest_buffer();
+                }));
         });
 }
 
 WlSurfaceCursor::~WlSurfaceCursor()
 {
+    *destroyed = true;
     if (surface)
     {
         surface.value().clear_role();
@@ -526,10 +489,7 @@ void WlSurfaceCursor::apply_latest_buffer()
     {
         if (stream->has_submitted_buffer())
         {
-            auto const cursor_image = std::make_shared<BufferCursorImage>(
-                stream->lock_compositor_buffer(this),
-                hotspot);
-            surface->set_cursor_image(cursor_image);
+            cursor_images.apply_to(*surface, stream->lock_compositor_buffer(this), hotspot);
         }
         else
         {
@@ -44,6 +44,7 @@ class Executor;
 namespace frontend
 {
 class WlSurface;
+class CursorImageCache;
 
 class CommitHandler
 {
@@ -103,6 +104,7 @@ private:
     bool needs_frame{false};
     MirPointerButtons current_buttons{0};
     std::optional<std::pair<float, float>> current_position;
+    std::unique_ptr<CursorImageCache> const cursor_images; ///< Must outlive cursor
     std::unique_ptr<Cursor> cursor;
     wayland::Weak<wayland::RelativePointerV1> relative_pointer;
     geometry::Displacement cursor_hotspot;
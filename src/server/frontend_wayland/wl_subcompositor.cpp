@@ -127,6 +127,11 @@ void mf::WlSubsurface::parent_has_committed()
     }
 }
 
+auto mf::WlSubsurface::frame_callback_schedule() -> FrameCallbackSchedule&
+{
+    return surface->frame_callback_schedule();
+}
+
 auto mf::WlSubsurface::subsurface_at(geom::Point point) -> std::optional<WlSurface*>
 {
     return surface->subsurface_at(point);
@@ -64,6 +64,8 @@ public:
     auto scene_surface() const -> std::optional<std::shared_ptr<scene::Surface>> override;
 
     void parent_has_committed();
+    /// The schedule of the subsurface's surface, which follows the occlusion of its parent
+    auto frame_callback_schedule() -> FrameCallbackSchedule&;
 
     auto subsurface_at(geometry::Point point) -> std::optional<WlSurface*>;
 
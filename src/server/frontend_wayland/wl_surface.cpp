@@ -19,6 +19,7 @@
 #include "wl_surface.h"
 
 #include "wayland_utils.h"
+#include "wl_client.h"
 #include "wl_surface_role.h"
 #include "wl_subcompositor.h"
 #include "wl_region.h"
@@ -32,6 +33,7 @@
 #include "mir/scene/session.h"
 #include "mir/frontend/wayland.h"
 #include "mir/compositor/buffer_stream.h"
+#include "mir/compositor/input_latency_report.h"
 #include "mir/executor.h"
 #include "mir/graphics/graphic_buffer_allocator.h"
 #include "mir/scene/surface.h"
@@ -51,6 +53,19 @@ namespace msh = mir::shell;
 mf::WlSurfaceState::Callback::Callback(wl_resource* new_resource)
     : mw::Callback{new_resource, Version<1>()}
 {
+    if (auto const wl_client = WlClient::from(client))
+    {
+        wl_client->frame_callback_requested();
+    }
+}
+
+mf::WlSurfaceState::Callback::~Callback()
+{
+    // The WlClient is destroyed before the client's remaining resources
+    if (auto const wl_client = WlClient::from(client))
+    {
+        wl_client->frame_callback_done();
+    }
 }
 
 void mf::WlSurfaceState::update_from(WlSurfaceState const& source)
@@ -86,18 +101,30 @@ mf::WlSurface::WlSurface(
     wl_resource* new_resource,
     std::shared_ptr<Executor> const& wayland_executor,
     std::shared_ptr<Executor> const& frame_callback_executor,
-    std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator)
+    std::shared_ptr<Executor> const& occluded_frame_callback_executor,
+    std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
+    std::shared_ptr<compositor::InputLatencyReport> const& latency_report)
     : Surface(new_resource, Version<4>()),
         session{get_session(client)},
         stream{session->create_buffer_stream({{}, mir_pixel_format_invalid, graphics::BufferUsage::undefined})},
         allocator{allocator},
         wayland_executor{wayland_executor},
-        frame_callback_executor{frame_callback_executor},
+        latency_report{latency_report},
         null_role{this},
-        role{&null_role}
+        role{&null_role},
+        frame_schedule{
+            frame_callback_executor,
+            occluded_frame_callback_executor,
+            [this]() { return !frame_callbacks.empty(); },
+            frame_callback_sender()}
 {
     // wl_surface is specified to act in mailbox mode
     stream->allow_framedropping(true);
+
+    if (auto const wl_client = WlClient::from(client))
+    {
+        wl_client->surface_created();
+    }
 }
 
 mf::WlSurface::~WlSurface()
@@ -109,7 +136,15 @@ mf::WlSurface::~WlSurface()
     {
         // Destroy the buffer stream first, as surface_destroyed() may throw
         session->destroy_buffer_stream(stream);
+        latency_report->surface_destroyed(this);
         role->surface_destroyed();
+
+        // The WlClient is destroyed before the client's remaining resources
+        if (auto const wl_client = WlClient::from(client))
+        {
+            wl_client->buffer_memory_changed(buffer_memory, 0);
+            wl_client->surface_destroyed();
+        }
     }
     catch (...)
     {
@@ -176,10 +211,12 @@ void mf::WlSurface::add_subsurface(WlSubsurface* child)
     }
 
     children.push_back(child);
+    frame_schedule.add_child(&child->frame_callback_schedule());
 }
 
 void mf::WlSurface::remove_subsurface(WlSubsurface* child)
 {
+    frame_schedule.remove_child(&child->frame_callback_schedule());
     children.erase(
         std::remove(
             children.begin(),
@@ -251,6 +288,30 @@ void mf::WlSurface::send_frame_callbacks()
     frame_callbacks.clear();
 }
 
+auto mf::WlSurface::executor() const -> std::shared_ptr<Executor> const&
+{
+    return wayland_executor;
+}
+
+auto mf::WlSurface::frame_callback_sender() -> std::function<void()>
+{
+    return [executor = wayland_executor, weak_self = mw::make_weak(this)]()
+        {
+            executor->spawn([weak_self]()
+                {
+                    if (weak_self)
+                    {
+                        weak_self.value().send_frame_callbacks();
+                    }
+                });
+        };
+}
+
+void mf::WlSurface::set_occluded(bool occluded)
+{
+    frame_schedule.set_occluded(occluded);
+}
+
 void mf::WlSurface::attach(std::optional<wl_resource*> const& buffer, int32_t x, int32_t y)
 {
     if (x != 0 || y != 0)
@@ -352,16 +413,7 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
     if (state.scale)
         stream->set_scale(state.scale.value());
 
-    auto const executor_send_frame_callbacks = [executor = wayland_executor, weak_self = mw::make_weak(this)]()
-        {
-            executor->spawn([weak_self]()
-                {
-                    if (weak_self)
-                    {
-                        weak_self.value().send_frame_callbacks();
-                    }
-                });
-        };
+    auto const executor_send_frame_callbacks = frame_callback_sender();
 
     if (state.buffer)
     {
@@ -371,11 +423,13 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
         {
             // TODO: unmap surface, and unmap all subsurfaces
             buffer_size_ = std::nullopt;
+            set_buffer_memory(0);
             send_frame_callbacks();
         }
         else
         {
             std::shared_ptr<graphics::Buffer> mir_buffer;
+            std::optional<size_t> shm_bytes;
 
             if (auto const shm_buffer = wl_shm_buffer_get(buffer))
             {
@@ -393,6 +447,7 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
                     BOOST_THROW_EXCEPTION((
                                               std::runtime_error{"Buffer has invalid stride"}));
                 }
+                shm_bytes = static_cast<size_t>(stride) * wl_shm_buffer_get_height(shm_buffer);
                 mir_buffer = allocator->buffer_from_shm(
                     buffer,
                     wayland_executor,
@@ -425,8 +480,18 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
                     mir_buffer->id().as_value());
             }
 
+            if (unanswered_input)
+            {
+                latency_report->buffer_committed(this, mir_buffer->id(), unanswered_input.value());
+                unanswered_input = std::nullopt;
+            }
+
             stream->submit_buffer(mir_buffer);
+            frame_schedule.committed_buffer();
             auto const new_buffer_size = stream->stream_size();
+            // We can't look inside client-allocated buffers, so assume four bytes per pixel
+            set_buffer_memory(shm_bytes.value_or(
+                4 * size_t{new_buffer_size.width.as_uint32_t()} * new_buffer_size.height.as_uint32_t()));
 
             if (!input_shape && std::make_optional(new_buffer_size) != buffer_size_)
             {
@@ -438,7 +503,7 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
     }
     else
     {
-        frame_callback_executor->spawn(std::move(executor_send_frame_callbacks));
+        frame_schedule.committed_without_buffer();
     }
 
     for (WlSubsurface* child: children)
@@ -447,8 +512,22 @@ void mf::WlSurface::commit(WlSurfaceState const& state)
     }
 }
 
+void mf::WlSurface::set_buffer_memory(size_t bytes)
+{
+    if (auto const wl_client = WlClient::from(client))
+    {
+        wl_client->buffer_memory_changed(buffer_memory, bytes);
+    }
+    buffer_memory = bytes;
+}
+
 void mf::WlSurface::commit()
 {
+    if (auto const wl_client = WlClient::from(client))
+    {
+        wl_client->surface_committed();
+    }
+
     if (pending.offset && *pending.offset == offset_)
         pending.offset = std::nullopt;
 
@@ -488,6 +567,15 @@ auto mf::WlSurface::confine_pointer_state() const -> MirPointerConfinementState
     return mir_pointer_unconfined;
 }
 
+void mf::WlSurface::input_sent(std::chrono::nanoseconds timestamp)
+{
+    // Keep the earliest input the client hasn't yet responded to
+    if (!unanswered_input)
+    {
+        unanswered_input = timestamp;
+    }
+}
+
 mf::NullWlSurfaceRole::NullWlSurfaceRole(WlSurface* surface) :
     surface{surface}
 {
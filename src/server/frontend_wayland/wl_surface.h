@@ -22,6 +22,7 @@
 #include "wayland_wrapper.h"
 
 #include "wl_surface_role.h"
+#include "frame_callback_schedule.h"
 
 #include "mir/geometry/displacement.h"
 #include "mir/geometry/size.h"
@@ -29,6 +30,7 @@
 
 #include <vector>
 #include <map>
+#include <chrono>
 
 namespace mir
 {
@@ -53,6 +55,7 @@ class Rectangle;
 namespace compositor
 {
 class BufferStream;
+class InputLatencyReport;
 }
 namespace frontend
 {
@@ -65,6 +68,7 @@ struct WlSurfaceState
     {
     public:
         Callback(wl_resource* new_resource);
+        ~Callback();
     };
 
     // if you add variables, don't forget to update this
@@ -111,7 +115,9 @@ public:
     WlSurface(wl_resource* new_resource,
               std::shared_ptr<mir::Executor> const& wayland_executor,
               std::shared_ptr<mir::Executor> const& frame_callback_executor,
-              std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator);
+              std::shared_ptr<mir::Executor> const& occluded_frame_callback_executor,
+              std::shared_ptr<graphics::GraphicBufferAllocator> const& allocator,
+              std::shared_ptr<compositor::InputLatencyReport> const& latency_report);
 
     ~WlSurface();
 
@@ -136,15 +142,26 @@ public:
     void commit(WlSurfaceState const& state);
     auto confine_pointer_state() const -> MirPointerConfinementState;
 
+    /// Whether any output shows this surface; frame callbacks of surfaces nobody sees are throttled
+    void set_occluded(bool occluded);
+    auto frame_callback_schedule() -> FrameCallbackSchedule& { return frame_schedule; }
+
+    /// The client has been sent input with the given timestamp. The next buffer it commits is taken as
+    /// its response, for the purposes of the input latency report.
+    void input_sent(std::chrono::nanoseconds timestamp);
+
     std::shared_ptr<scene::Session> const session;
     std::shared_ptr<compositor::BufferStream> const stream;
 
     static WlSurface* from(wl_resource* resource);
 
+    /// The executor for work that must happen on the Wayland thread but is triggered elsewhere
+    auto executor() const -> std::shared_ptr<Executor> const&;
+
 private:
     std::shared_ptr<mir::graphics::GraphicBufferAllocator> const allocator;
     std::shared_ptr<mir::Executor> const wayland_executor;
-    std::shared_ptr<mir::Executor> const frame_callback_executor;
+    std::shared_ptr<compositor::InputLatencyReport> const latency_report;
 
     NullWlSurfaceRole null_role;
     WlSurfaceRole* role;
@@ -153,10 +170,18 @@ private:
     WlSurfaceState pending;
     geometry::Displacement offset_;
     std::optional<geometry::Size> buffer_size_;
+    size_t buffer_memory{0}; ///< Accounted against the client's limit
     std::vector<wayland::Weak<WlSurfaceState::Callback>> frame_callbacks;
     std::optional<std::vector<mir::geometry::Rectangle>> input_shape;
+    std::optional<std::chrono::nanoseconds> unanswered_input;
+
+    FrameCallbackSchedule frame_schedule;
 
     void send_frame_callbacks();
+    /// Updates the buffer memory accounted to the client for this surface
+    void set_buffer_memory(size_t bytes);
+    /// Work that, when run on an executor, sends the pending frame callbacks on the Wayland thread
+    auto frame_callback_sender() -> std::function<void()>;
 
     void attach(std::optional<wl_resource*> const& buffer, int32_t x, int32_t y) override;
     void damage(int32_t x, int32_t y, int32_t width, int32_t height) override;
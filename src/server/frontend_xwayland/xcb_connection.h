@@ -301,6 +301,8 @@ public:
     DECLARE_ATOM(_NET_WM_WINDOW_TYPE_DND);
     DECLARE_ATOM(_NET_WM_WINDOW_TYPE_NORMAL);
     DECLARE_ATOM(_NET_WM_MOVERESIZE);
+    DECLARE_ATOM(_NET_WM_SYNC_REQUEST);
+    DECLARE_ATOM(_NET_WM_SYNC_REQUEST_COUNTER);
     DECLARE_ATOM(_NET_SUPPORTING_WM_CHECK);
     DECLARE_ATOM(_NET_SUPPORTED);
     DECLARE_ATOM(_NET_ACTIVE_WINDOW);
@@ -0,0 +1,131 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "xwayland_clipboard_data_sender.h"
+
+#include "xwayland_log.h"
+
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mf = mir::frontend;
+namespace md = mir::dispatch;
+
+mf::XWaylandClipboardDataSender::XWaylandClipboardDataSender(
+    Fd const& destination_fd,
+    std::function<void(XWaylandClipboardDataSender const* sender, bool failed)> on_done)
+    : destination_fd{destination_fd},
+      on_done{std::move(on_done)}
+{
+    // A slow receiver must not block the X11 WM thread
+    auto const flags = fcntl(destination_fd, F_GETFL);
+    if (flags < 0 || fcntl(destination_fd, F_SETFL, flags | O_NONBLOCK) < 0)
+    {
+        mir::log_warning("failed to make clipboard receiver fd non-blocking: %s", strerror(errno));
+    }
+}
+
+auto mf::XWaylandClipboardDataSender::add_chunk(UniqueCPtr<xcb_get_property_reply_t>&& reply) -> bool
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    bool const was_idle = chunks.empty();
+    chunks.push_back(std::move(reply));
+    return was_idle;
+}
+
+auto mf::XWaylandClipboardDataSender::watch_fd() const -> Fd
+{
+    return destination_fd;
+}
+
+auto mf::XWaylandClipboardDataSender::dispatch(md::FdEvents events) -> bool
+{
+    bool failed{false};
+    bool keep_going{true};
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        if (events & md::FdEvent::error)
+        {
+            mir::log_error("failed to send X11 clipboard data: fd error");
+            failed = true;
+        }
+        else if (events & md::FdEvent::remote_closed)
+        {
+            mir::log_error("failed to send X11 clipboard data: fd closed");
+            failed = true;
+        }
+        else if (events & md::FdEvent::writable)
+        {
+            failed = !write_some(lock);
+        }
+
+        keep_going = !failed && !chunks.empty();
+        if (!keep_going)
+        {
+            chunks.clear();
+        }
+    }
+
+    if (!keep_going)
+    {
+        on_done(this, failed);
+    }
+    return keep_going;
+}
+
+auto mf::XWaylandClipboardDataSender::relevant_events() const -> md::FdEvents
+{
+    return md::FdEvent::writable;
+}
+
+auto mf::XWaylandClipboardDataSender::write_some(std::lock_guard<std::mutex> const&) -> bool
+{
+    while (!chunks.empty())
+    {
+        auto const data = static_cast<uint8_t const*>(xcb_get_property_value(chunks.front().get()));
+        size_t const size = xcb_get_property_value_length(chunks.front().get());
+
+        if (offset < size)
+        {
+            auto const len = write(destination_fd, data + offset, size - offset);
+            if (len < 0)
+            {
+                if (errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    return true;
+                }
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                mir::log_error("failed to send X11 clipboard data: %s", strerror(errno));
+                return false;
+            }
+            offset += len;
+        }
+
+        if (offset >= size)
+        {
+            chunks.pop_front();
+            offset = 0;
+        }
+    }
+    return true;
+}
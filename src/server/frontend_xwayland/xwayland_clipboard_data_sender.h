@@ -0,0 +1,68 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_FRONTEND_XWAYLAND_CLIPBOARD_DATA_SENDER_H_
+#define MIR_FRONTEND_XWAYLAND_CLIPBOARD_DATA_SENDER_H_
+
+#include "mir/dispatch/dispatchable.h"
+#include "mir/c_memory.h"
+#include "mir/fd.h"
+
+#include <xcb/xproto.h>
+
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace mir
+{
+namespace frontend
+{
+/// Writes X11 selection data to a (non-blocking) receiver fd straight out of the property replies that carried it.
+/// Incremental transfers hold only the chunk being written: the next one isn't requested until this one is sent.
+class XWaylandClipboardDataSender : public dispatch::Dispatchable
+{
+public:
+    /// on_done is called (without our lock held) with false when all data given so far has been written, or with
+    /// true if the transfer failed
+    XWaylandClipboardDataSender(
+        Fd const& destination_fd,
+        std::function<void(XWaylandClipboardDataSender const* sender, bool failed)> on_done);
+
+    /// Returns if there was no data waiting to be written. If return value is true, this needs to be added to the
+    /// dispatcher.
+    auto add_chunk(UniqueCPtr<xcb_get_property_reply_t>&& reply) -> bool;
+
+    auto watch_fd() const -> Fd override;
+    auto dispatch(dispatch::FdEvents events) -> bool override;
+    auto relevant_events() const -> dispatch::FdEvents override;
+
+private:
+    /// Writes as much as the receiver will take without blocking, returns false on error
+    auto write_some(std::lock_guard<std::mutex> const&) -> bool;
+
+    Fd const destination_fd;
+    std::function<void(XWaylandClipboardDataSender const* sender, bool failed)> const on_done;
+
+    std::mutex mutex;
+    std::deque<UniqueCPtr<xcb_get_property_reply_t>> chunks;
+    size_t offset{0}; ///< How much of the front chunk has been written
+};
+}
+}
+
+#endif // MIR_FRONTEND_XWAYLAND_CLIPBOARD_DATA_SENDER_H_
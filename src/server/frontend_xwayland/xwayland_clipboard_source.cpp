@@ -18,13 +18,13 @@
 
 #include "xwayland_clipboard_source.h"
 
+#include "xwayland_clipboard_data_sender.h"
 #include "xwayland_log.h"
+#include "mir/c_memory.h"
 #include "mir/scene/clipboard.h"
 #include "mir/dispatch/multiplexing_dispatchable.h"
 
 #include <xcb/xfixes.h>
-#include <string.h>
-#include <unistd.h>
 #include <map>
 #include <set>
 
@@ -118,81 +118,12 @@ private:
     XWaylandClipboardSource* owner; ///< Can be null
 };
 
-class mf::XWaylandClipboardSource::DataSender : public md::Dispatchable
-{
-public:
-    DataSender(mir::Fd const& destination_fd)
-        : destination_fd{destination_fd}
-    {
-    }
-
-    /// Returns if the previous buffer was empty. If return value is true, this needs to be added to the dispatcher.
-    auto add_data(std::vector<uint8_t>&& new_data) -> bool {
-        std::lock_guard<std::mutex> lock{mutex};
-        if (data.empty())
-        {
-            data = std::move(new_data);
-            return true;
-        }
-        else
-        {
-            data.insert(data.end(), new_data.begin(), new_data.end());
-            return false;
-        }
-    }
-
-private:
-    auto watch_fd() const -> mir::Fd override
-    {
-        return destination_fd;
-    }
-
-    auto dispatch(md::FdEvents events) -> bool override
-    {
-        std::lock_guard<std::mutex> lock{mutex};
-
-        if (events & md::FdEvent::error)
-        {
-            mir::log_error("failed to send X11 clipboard data: fd error");
-            return false;
-        }
-
-        if (events & md::FdEvent::remote_closed)
-        {
-            mir::log_error("failed to send X11 clipboard data: fd closed");
-            return false;
-        }
-
-        if (events & md::FdEvent::writable)
-        {
-            auto const len = write(destination_fd, &data[0], data.size());
-            if (len < 0)
-            {
-                mir::log_error("failed to send X11 clipboard data: %s", strerror(errno));
-                return false;
-            }
-            data.erase(data.begin(), data.begin() + len);
-        }
-
-        return !data.empty();
-    }
-
-    auto relevant_events() const -> md::FdEvents override
-    {
-        return md::FdEvent::writable;
-    }
-
-    mir::Fd const destination_fd;
-
-    std::mutex mutex;
-    std::vector<uint8_t> data;
-};
-
 mf::XWaylandClipboardSource::XWaylandClipboardSource(
     XCBConnection& connection,
     std::shared_ptr<md::MultiplexingDispatchable> const& dispatcher,
     std::shared_ptr<scene::Clipboard> const& clipboard)
-    : connection{connection},
+    : threadsafe_self{std::make_shared<ThreadsafeSelf>(this)},
+      connection{connection},
       dispatcher{dispatcher},
       clipboard{clipboard},
       receiving_window{create_receiving_window(connection)}
@@ -214,6 +145,12 @@ auto mf::XWaylandClipboardSource::source_is_from(ms::ClipboardSource* source, XC
 
 mf::XWaylandClipboardSource::~XWaylandClipboardSource()
 {
+    {
+        // Senders still in the dispatcher can outlive us
+        std::lock_guard<std::mutex> lock{threadsafe_self->mutex};
+        threadsafe_self->ptr = nullptr;
+    }
+
     std::unique_lock<std::mutex> lock{mutex};
     auto const source_to_reset = std::move(clipboard_source);
     lock.unlock();
@@ -238,7 +175,16 @@ void mf::XWaylandClipboardSource::initiate_send(xcb_atom_t target_type, Fd const
         log_error("can not send clipboard data from X11 because another send is currently in progress");
         return;
     }
-    in_progress_send = std::make_shared<DataSender>(receiver_fd);
+    in_progress_send = std::make_shared<XWaylandClipboardDataSender>(
+        receiver_fd,
+        [self = threadsafe_self](XWaylandClipboardDataSender const* sender, bool failed)
+        {
+            std::lock_guard<std::mutex> lock{self->mutex};
+            if (self->ptr)
+            {
+                self->ptr->chunk_sent(sender, failed);
+            }
+        });
     lock.unlock();
 
     if (verbose_xwayland_logging_enabled())
@@ -401,60 +347,68 @@ void mf::XWaylandClipboardSource::create_source(xcb_timestamp_t timestamp, std::
 
 void mf::XWaylandClipboardSource::read_and_send_wl_selection_data(std::lock_guard<std::mutex> const& lock)
 {
-    auto const completion = connection.read_property(
+    // The property is not deleted as it's read. For incremental transfers, deleting it asks the client for the next
+    // chunk, which we only want once the receiver has taken this one.
+    auto const cookie = xcb_get_property(
+        connection,
+        0, // don't delete
         receiving_window,
         connection._WL_SELECTION,
-        true, // delete
-        0x1fffffff, // length lifted from Weston
-        {[&](xcb_get_property_reply_t* reply)
-        {
-            if (reply->type == connection.INCR)
-            {
-                if (verbose_xwayland_logging_enabled())
-                {
-                    log_info("Initiating incremental data transfer from X11");
-                }
-                incremental_transfer_in_progress = true;
-            }
-            else
-            {
-                auto const data_ptr = static_cast<uint8_t*>(xcb_get_property_value(reply));
-                auto const data_size = xcb_get_property_value_length(reply);
-                add_data_to_in_progress_send(lock, data_ptr, data_size);
-            }
-        },
-        [&](const std::string& error_message)
-        {
-            log_error("Error getting selection property: %s", error_message.c_str());
-            in_progress_send.reset();
-        }});
+        XCB_ATOM_ANY,
+        0, // no offset
+        0x1fffffff); // length lifted from Weston
+    XCBConnection::Error error;
+    auto reply = make_unique_cptr(xcb_get_property_reply(connection, cookie, &error.ptr));
 
-    completion();
+    if (!reply || reply->type == XCB_ATOM_NONE)
+    {
+        log_error(
+            "Error getting selection property: %s",
+            error.ptr ? connection.error_debug_string(error.ptr).c_str() : "no reply data");
+        in_progress_send.reset();
+        incremental_transfer_in_progress = false;
+        return;
+    }
+
+    if (reply->type == connection.INCR)
+    {
+        if (verbose_xwayland_logging_enabled())
+        {
+            log_info("Initiating incremental data transfer from X11");
+        }
+        incremental_transfer_in_progress = true;
+        // Deleting the INCR property starts the transfer
+        xcb_delete_property(connection, receiving_window, connection._WL_SELECTION);
+        connection.flush();
+    }
+    else
+    {
+        add_data_to_in_progress_send(lock, std::move(reply));
+    }
 }
 
 void mf::XWaylandClipboardSource::add_data_to_in_progress_send(
     std::lock_guard<std::mutex> const&,
-    uint8_t* data_ptr,
-    size_t data_size)
+    UniqueCPtr<xcb_get_property_reply_t>&& reply)
 {
-
     if (!in_progress_send)
     {
         log_error("Can not send clipboard data from X11 because there is no send in progress");
         return;
     }
 
+    size_t const data_size = xcb_get_property_value_length(reply.get());
+
     if (data_size > 0)
     {
-        std::vector<uint8_t> data{data_ptr, data_ptr + data_size};
         if (verbose_xwayland_logging_enabled())
         {
-            log_info("Writing %zu bytes of clipboard data from X11", data.size());
+            log_info("Writing %zu bytes of clipboard data from X11", data_size);
         }
 
-        if (in_progress_send->add_data(std::move(data)))
+        if (in_progress_send->add_chunk(std::move(reply)))
         {
-            // add_data() returns if it needs to be added to the dispatcher
+            // add_chunk() returns if it needs to be added to the dispatcher
             dispatcher->add_watch(in_progress_send);
         }
     }
@@ -462,8 +416,36 @@ void mf::XWaylandClipboardSource::add_data_to_in_progress_send(
     // Normal transfers are done after the first chunk, incremental transfers are done after a zero-size chunk
     if (!incremental_transfer_in_progress || data_size == 0)
     {
+        // The property has been read, so the client can let it go
+        xcb_delete_property(connection, receiving_window, connection._WL_SELECTION);
+        connection.flush();
+
         // in_progress_send may still be sending data on it's fd, but the dispatcher will hold onto it until it's done
         in_progress_send.reset();
         incremental_transfer_in_progress = false;
     }
+    // Otherwise the property is deleted in chunk_sent(), once the receiver has taken the data
+}
+
+void mf::XWaylandClipboardSource::chunk_sent(XWaylandClipboardDataSender const* sender, bool failed)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (!incremental_transfer_in_progress || in_progress_send.get() != sender)
+    {
+        // Not our current incremental transfer (normal transfers need nothing from the X11 client once read)
+        return;
+    }
+
+    if (failed)
+    {
+        // Nothing more can be sent to the receiver, so don't wait on the X11 client for data
+        in_progress_send.reset();
+        incremental_transfer_in_progress = false;
+        return;
+    }
+
+    // Ask the client for the next chunk
+    xcb_delete_property(connection, receiving_window, connection._WL_SELECTION);
+    connection.flush();
 }
@@ -20,6 +20,7 @@
 #define MIR_FRONTEND_XWAYLAND_CLIPBOARD_SOURCE_H_
 
 #include "xcb_connection.h"
+#include "mir/c_memory.h"
 
 struct xcb_xfixes_selection_notify_event_t;
 
@@ -36,6 +37,8 @@ class MultiplexingDispatchable;
 }
 namespace frontend
 {
+class XWaylandClipboardDataSender;
+
 /// Exposes X11 selections to non-X11 clients
 class XWaylandClipboardSource
 {
@@ -63,7 +66,17 @@ public:
 
 private:
     class ClipboardSource;
-    class DataSender;
+
+    struct ThreadsafeSelf
+    {
+        ThreadsafeSelf(XWaylandClipboardSource* ptr)
+            : ptr{ptr}
+        {
+        }
+
+        std::mutex mutex;
+        XWaylandClipboardSource* ptr; ///< nulled out when source is destroyed
+    };
 
     XWaylandClipboardSource(XWaylandClipboardSource const&) = delete;
     XWaylandClipboardSource& operator=(XWaylandClipboardSource const&) = delete;
@@ -75,9 +88,16 @@ private:
     /// Called when there is new data in the _WL_SELECTION property that needs to be sent to the in-progress send
     void read_and_send_wl_selection_data(std::lock_guard<std::mutex> const& lock);
 
-    /// Sends the given data to the current destination fd
-    void add_data_to_in_progress_send(std::lock_guard<std::mutex> const& lock, uint8_t* data_ptr, size_t data_size);
+    /// Hands the data in the given property reply to the in-progress send, which writes it to the receiver fd
+    void add_data_to_in_progress_send(
+        std::lock_guard<std::mutex> const& lock,
+        UniqueCPtr<xcb_get_property_reply_t>&& reply);
+
+    /// Called by a sender when it has written everything it's been given (or has failed). For incremental
+    /// transfers, this is when the next chunk is requested from the X11 client.
+    void chunk_sent(XWaylandClipboardDataSender const* sender, bool failed);
 
+    std::shared_ptr<ThreadsafeSelf> const threadsafe_self;
     XCBConnection& connection;
     std::shared_ptr<dispatch::MultiplexingDispatchable> const dispatcher;
     std::shared_ptr<scene::Clipboard> const clipboard;
@@ -88,7 +108,7 @@ private:
     xcb_timestamp_t clipboard_ownership_timestamp{0};
     std::shared_ptr<ClipboardSource> clipboard_source;
     bool incremental_transfer_in_progress{false};
-    std::shared_ptr<DataSender> in_progress_send;
+    std::shared_ptr<XWaylandClipboardDataSender> in_progress_send;
 };
 }
 }
@@ -25,7 +25,7 @@
 #include "mir/log.h"
 #include "mir/dispatch/multiplexing_dispatchable.h"
 #include "mir/dispatch/readable_fd.h"
-#include "mir/executor.h"
+#include "mir/main_loop.h"
 
 #include <unistd.h>
 
@@ -33,14 +33,29 @@ namespace mf = mir::frontend;
 namespace md = mir::dispatch;
 
 mf::XWaylandConnector::XWaylandConnector(
-    std::shared_ptr<Executor> const& main_loop,
+    std::shared_ptr<MainLoop> const& main_loop,
     std::shared_ptr<WaylandConnector> const& wayland_connector,
     std::string const& xwayland_path,
-    float scale)
+    float scale,
+    std::chrono::seconds idle_timeout)
     : main_loop{main_loop},
       wayland_connector{wayland_connector},
       xwayland_path{xwayland_path},
-      scale{scale}
+      scale{scale},
+      idle_timeout{
+          *main_loop,
+          idle_timeout,
+          [this]()
+          {
+              // Alarm callbacks must not block on our mutex, as it may be held while the alarm is cancelled
+              this->main_loop->spawn([weak_self=weak_from_this()]()
+                  {
+                      if (auto const self = weak_self.lock())
+                      {
+                          self->stop_if_idle();
+                      }
+                  });
+          }}
 {
     if (access(xwayland_path.c_str(), F_OK | X_OK) != 0)
     {
@@ -143,6 +158,8 @@ void mf::XWaylandConnector::clean_up(std::unique_lock<std::mutex> lock)
 
     lock.unlock();
 
+    idle_timeout.stopped();
+
     // Local objects are now dropped with the mutex not locked
 }
 
@@ -204,7 +221,13 @@ void mf::XWaylandConnector::spawn()
             server->client(),
             server->x11_wm_fd(),
             wm_dispatcher,
-            scale);
+            main_loop,
+            scale,
+            [this](bool idle)
+            {
+                idle_timeout.idle_changed(idle);
+            });
+        idle_timeout.started(wm->has_client_windows());
         mir::log_info("XWayland is running");
     }
     catch (...)
@@ -230,3 +253,28 @@ void mf::XWaylandConnector::spawn()
             });
     }
 }
+
+void mf::XWaylandConnector::stop_if_idle()
+{
+    std::unique_lock<std::mutex> lock{mutex};
+
+    if (!server || !wm || !idle_timeout.timed_out())
+    {
+        // Either XWayland isn't running, or it has been used since the timeout
+        return;
+    }
+
+    auto local_server{std::move(server)};
+    auto local_wm{std::move(wm)};
+    auto local_wm_event_thread{std::move(wm_event_thread)};
+
+    lock.unlock();
+
+    idle_timeout.stopped();
+
+    mir::log_info(
+        "XWayland has had no windows for %llds, stopping it until an X11 client connects",
+        static_cast<long long>(idle_timeout.timeout().count()));
+
+    // Local objects are now dropped with the mutex not locked. The spawner is kept, so X11 clients can still connect.
+}
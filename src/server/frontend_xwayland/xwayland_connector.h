@@ -20,13 +20,15 @@
 #define MIR_FRONTEND_XWAYLAND_CONNECTOR_H
 
 #include "mir/frontend/connector.h"
+#include "xwayland_idle_timeout.h"
 
+#include <chrono>
 #include <memory>
 #include <mutex>
 
 namespace mir
 {
-class Executor;
+class MainLoop;
 namespace dispatch
 {
 class ReadableFd;
@@ -46,11 +48,15 @@ public:
     /// scale and the scale the application uses should all match. Application scale needs to be configured on a per-app
     /// or even per-toolkit basis. GDK_SCALE is used by default for XWayland scale because many apps respect it, so it's
     /// generally as correct as anything.
+    ///
+    /// If idle_timeout is non-zero XWayland is stopped once it has had no client windows for that long. The X11
+    /// display stays reserved, and XWayland is started again when the next client connects.
     XWaylandConnector(
-        std::shared_ptr<Executor> const& main_loop,
+        std::shared_ptr<MainLoop> const& main_loop,
         std::shared_ptr<WaylandConnector> const& wayland_connector,
         std::string const& xwayland_path,
-        float scale);
+        float scale,
+        std::chrono::seconds idle_timeout);
     ~XWaylandConnector();
 
     void start() override;
@@ -63,7 +69,7 @@ public:
     auto socket_name() const -> optional_value<std::string> override;
 
 private:
-    std::shared_ptr<Executor> const main_loop;
+    std::shared_ptr<MainLoop> const main_loop;
     std::shared_ptr<WaylandConnector> const wayland_connector;
     std::string const xwayland_path;
     float const scale;
@@ -75,6 +81,9 @@ private:
     /// Called the first time a client attempts to connect. Creates the server (which forks the XWayland process), wm
     /// and wm_event_thread.
     void spawn();
+    /// Called once the idle_timeout has passed (XWayland may have been spawned or used again since)
+    /// Destroys the server, wm and wm_event_thread but keeps the spawner, so the next client restarts XWayland
+    void stop_if_idle();
 
     std::mutex mutable mutex;
     /// Set in start() and stop(), should always reflect the state Mir has requested this object to be in
@@ -83,6 +92,9 @@ private:
     std::unique_ptr<XWaylandServer> server;
     std::unique_ptr<XWaylandWM> wm;
     std::unique_ptr<dispatch::ThreadedDispatcher> wm_event_thread;
+
+    /// Declared last so its alarm is cancelled before anything it could use is destroyed
+    XWaylandIdleTimeout idle_timeout;
 };
 } /* frontend */
 } /* mir */
@@ -24,6 +24,7 @@
 
 #include <boost/lexical_cast.hpp>
 
+#include <chrono>
 #include <string>
 #include <cstdlib>
 
@@ -74,12 +75,20 @@ std::shared_ptr<mf::Connector> mir::DefaultServerConfiguration::the_xwayland_con
                 {
                     BOOST_THROW_EXCEPTION(std::runtime_error("scale outside of valid range"));
                 }
+                auto const idle_timeout = options->is_set("xwayland-idle-timeout") ?
+                    std::chrono::seconds{options->get<int>("xwayland-idle-timeout")} :
+                    std::chrono::seconds::zero();
+                if (idle_timeout < std::chrono::seconds::zero())
+                {
+                    BOOST_THROW_EXCEPTION(std::runtime_error("xwayland-idle-timeout must not be negative"));
+                }
                 auto wayland_connector = std::static_pointer_cast<mf::WaylandConnector>(the_wayland_connector());
                 return std::make_shared<mf::XWaylandConnector>(
                     the_main_loop(),
                     wayland_connector,
                     options->get<std::string>("xwayland-path"),
-                    scale);
+                    scale,
+                    idle_timeout);
             }
             catch (std::exception& x)
             {
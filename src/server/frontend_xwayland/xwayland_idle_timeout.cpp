@@ -0,0 +1,85 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "xwayland_idle_timeout.h"
+
+#include "mir/time/alarm.h"
+#include "mir/time/alarm_factory.h"
+
+namespace mf = mir::frontend;
+
+mf::XWaylandIdleTimeout::XWaylandIdleTimeout(
+    time::AlarmFactory& alarm_factory,
+    std::chrono::seconds timeout,
+    std::function<void()>&& idle_for_timeout)
+    : timeout_{timeout},
+      alarm{timeout.count() > 0 ? alarm_factory.create_alarm(std::move(idle_for_timeout)) : nullptr}
+{
+}
+
+mf::XWaylandIdleTimeout::~XWaylandIdleTimeout() = default;
+
+void mf::XWaylandIdleTimeout::started(bool has_client_windows)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    running = true;
+    idle = !has_client_windows;
+    update_alarm(lock);
+}
+
+void mf::XWaylandIdleTimeout::idle_changed(bool idle)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    if (this->idle == idle)
+    {
+        return;
+    }
+    this->idle = idle;
+    update_alarm(lock);
+}
+
+void mf::XWaylandIdleTimeout::stopped()
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    running = false;
+    update_alarm(lock);
+}
+
+auto mf::XWaylandIdleTimeout::timed_out() const -> bool
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    // Going idle again since the alarm fired reschedules it
+    return alarm && running && idle && alarm->state() == time::Alarm::State::triggered;
+}
+
+void mf::XWaylandIdleTimeout::update_alarm(std::lock_guard<std::mutex> const&)
+{
+    if (!alarm)
+    {
+        return;
+    }
+
+    // The alarm's callback doesn't take our lock, so it's safe to wait on it here
+    if (running && idle)
+    {
+        alarm->reschedule_in(timeout_);
+    }
+    else
+    {
+        alarm->cancel();
+    }
+}
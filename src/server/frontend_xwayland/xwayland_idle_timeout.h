@@ -0,0 +1,83 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#ifndef MIR_FRONTEND_XWAYLAND_IDLE_TIMEOUT_H
+#define MIR_FRONTEND_XWAYLAND_IDLE_TIMEOUT_H
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace mir
+{
+namespace time
+{
+class Alarm;
+class AlarmFactory;
+}
+namespace frontend
+{
+/// Decides when XWayland has had no client windows for long enough to be stopped
+class XWaylandIdleTimeout
+{
+public:
+    /// \p idle_for_timeout is called on the thread the alarm factory runs alarms on once XWayland has been idle for
+    /// \p timeout. It must not block on any lock held while calling into this object, and the idleness may have ended
+    /// by the time it is acted on, so it should recheck with timed_out(). A zero timeout never times out.
+    XWaylandIdleTimeout(
+        time::AlarmFactory& alarm_factory,
+        std::chrono::seconds timeout,
+        std::function<void()>&& idle_for_timeout);
+    ~XWaylandIdleTimeout();
+
+    auto timeout() const -> std::chrono::seconds { return timeout_; }
+
+    /// XWayland has been spawned. A client that causes a spawn may never create a window, so the timeout starts now
+    /// unless there are already client windows.
+    void started(bool has_client_windows);
+
+    /// Called when the first client window is created (false) or the last one destroyed (true)
+    void idle_changed(bool idle);
+
+    /// XWayland has been stopped, for whatever reason
+    void stopped();
+
+    /// True if XWayland is running and has stayed idle for the whole timeout, false if it was used (or stopped and
+    /// started) again since idle_for_timeout was called
+    auto timed_out() const -> bool;
+
+private:
+    XWaylandIdleTimeout(XWaylandIdleTimeout const&) = delete;
+    XWaylandIdleTimeout& operator=(XWaylandIdleTimeout const&) = delete;
+
+    /// Given lock must be locked
+    void update_alarm(std::lock_guard<std::mutex> const&);
+
+    std::chrono::seconds const timeout_;
+
+    std::mutex mutable mutex;
+    bool running{false};
+    bool idle{false};
+
+    /// Null if the timeout is zero. Declared last so it is destroyed (and can no longer fire) first.
+    std::unique_ptr<time::Alarm> const alarm;
+};
+}
+}
+
+#endif // MIR_FRONTEND_XWAYLAND_IDLE_TIMEOUT_H
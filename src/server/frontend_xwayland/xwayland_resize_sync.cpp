@@ -0,0 +1,139 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "xwayland_resize_sync.h"
+
+#include "mir/time/alarm.h"
+#include "mir/time/alarm_factory.h"
+
+#include <utility>
+
+namespace mf = mir::frontend;
+namespace geom = mir::geometry;
+
+std::chrono::milliseconds const mf::XWaylandResizeSync::timeout{500};
+
+mf::XWaylandResizeSync::XWaylandResizeSync(
+    time::AlarmFactory& alarm_factory,
+    std::function<void(std::optional<geometry::Rectangle> const& held_back, bool timed_out)> drawn)
+    : drawn{std::move(drawn)},
+      timeout_alarm{alarm_factory.create_alarm([this]() { timed_out(); })}
+{
+}
+
+mf::XWaylandResizeSync::~XWaylandResizeSync() = default;
+
+auto mf::XWaylandResizeSync::configure(geom::Rectangle const& geometry, bool use_sync_request, bool size_changed)
+    -> Configure
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (use_sync_request && awaiting && !unresponsive)
+    {
+        held_back_ = geometry;
+        return {true, std::nullopt};
+    }
+
+    held_back_ = std::nullopt;
+
+    if (!use_sync_request || !size_changed)
+    {
+        return {false, std::nullopt};
+    }
+
+    awaiting = true;
+    // Nothing is held back while the client is unresponsive, so the alarm only matters if it has been responsive
+    timeout_alarm->reschedule_in(timeout);
+    return {false, ++last_request_};
+}
+
+auto mf::XWaylandResizeSync::held_back() const -> std::optional<geom::Rectangle>
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    return held_back_;
+}
+
+void mf::XWaylandResizeSync::discard_held_back()
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    held_back_ = std::nullopt;
+}
+
+auto mf::XWaylandResizeSync::awaiting_frame() const -> bool
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    return awaiting && !unresponsive;
+}
+
+auto mf::XWaylandResizeSync::last_request() const -> uint64_t
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    return last_request_;
+}
+
+void mf::XWaylandResizeSync::counter_reached(uint64_t value)
+{
+    std::optional<geom::Rectangle> geometry;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        // If the counter has somehow got ahead of us, later requests need to be ahead of it
+        if (value > last_request_)
+        {
+            last_request_ = value;
+        }
+        else if (value < last_request_)
+        {
+            // An answer to a request that has since been superseded
+            return;
+        }
+
+        awaiting = false;
+        unresponsive = false;
+        geometry = std::exchange(held_back_, std::nullopt);
+    }
+
+    drawn(geometry, false);
+}
+
+auto mf::XWaylandResizeSync::reset() -> std::optional<geom::Rectangle>
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    awaiting = false;
+    unresponsive = false;
+    return std::exchange(held_back_, std::nullopt);
+}
+
+void mf::XWaylandResizeSync::timed_out()
+{
+    std::optional<geom::Rectangle> geometry;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        if (!awaiting || unresponsive)
+        {
+            // Answered (or given up on) since the alarm was scheduled
+            return;
+        }
+
+        unresponsive = true;
+        geometry = std::exchange(held_back_, std::nullopt);
+    }
+
+    drawn(geometry, true);
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_FRONTEND_XWAYLAND_RESIZE_SYNC_H
+#define MIR_FRONTEND_XWAYLAND_RESIZE_SYNC_H
+
+#include "mir/geometry/rectangle.h"
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace mir
+{
+namespace time
+{
+class Alarm;
+class AlarmFactory;
+}
+namespace frontend
+{
+/// Paces the geometry sent to an X11 client that supports _NET_WM_SYNC_REQUEST, see
+/// https://specifications.freedesktop.org/wm-spec/wm-spec-1.3.html#idm45805407906624
+/// While the client is drawing a size it was sent newer geometry is held back, and only the latest is sent once it
+/// has drawn. A client that doesn't answer within the timeout is not waited on again until it does answer.
+class XWaylandResizeSync
+{
+public:
+    /// How long a client has to answer a sync request
+    static std::chrono::milliseconds const timeout;
+
+    /// \p drawn is called when the client has drawn the size it was sent, or has failed to in time (in which case
+    /// timed_out is true). It gets the latest geometry held back in the meantime, if any. It is called without our lock
+    /// held, either from counter_reached() or on the thread the alarm factory runs alarms on.
+    XWaylandResizeSync(
+        time::AlarmFactory& alarm_factory,
+        std::function<void(std::optional<geometry::Rectangle> const& held_back, bool timed_out)> drawn);
+    ~XWaylandResizeSync();
+
+    struct Configure
+    {
+        /// If true the geometry must not be sent now, it is passed to drawn() later
+        bool held_back;
+        /// If set, the client must be sent a sync request with this value before the geometry
+        std::optional<uint64_t> sync_request;
+    };
+
+    /// Decides how the client is sent new \p geometry. Without \p use_sync_request it is always sent straight away.
+    auto configure(geometry::Rectangle const& geometry, bool use_sync_request, bool size_changed) -> Configure;
+
+    /// The latest geometry being held back, if any
+    auto held_back() const -> std::optional<geometry::Rectangle>;
+
+    /// Drops any geometry being held back, for when the client already has what it would have been sent
+    void discard_held_back();
+
+    /// True while the client is drawing a size it was sent (unless it has taken too long)
+    auto awaiting_frame() const -> bool;
+
+    /// The value sent with the most recent sync request
+    auto last_request() const -> uint64_t;
+
+    /// Called with the value the client has set its counter to. Answers to superseded requests are ignored.
+    void counter_reached(uint64_t value);
+
+    /// Stops waiting on the client, for when it no longer has a counter. Returns any geometry that was held back.
+    auto reset() -> std::optional<geometry::Rectangle>;
+
+private:
+    XWaylandResizeSync(XWaylandResizeSync const&) = delete;
+    XWaylandResizeSync& operator=(XWaylandResizeSync const&) = delete;
+
+    void timed_out();
+
+    std::function<void(std::optional<geometry::Rectangle> const&, bool)> const drawn;
+
+    std::mutex mutable mutex;
+
+    /// The value sent with the most recent sync request
+    uint64_t last_request_{0};
+
+    /// If the client has not yet answered the most recent sync request
+    bool awaiting{false};
+
+    /// Set when the client fails to answer a request in time. We stop waiting on it until it answers one.
+    bool unresponsive{false};
+
+    /// The latest geometry held back until the client answers
+    std::optional<geometry::Rectangle> held_back_;
+
+    /// Declared last so it is destroyed (and can no longer call timed_out()) first
+    std::unique_ptr<time::Alarm> const timeout_alarm;
+};
+}
+}
+
+#endif // MIR_FRONTEND_XWAYLAND_RESIZE_SYNC_H
@@ -27,11 +27,13 @@
 #include "mir/scene/surface_creation_parameters.h"
 #include "mir/scene/surface.h"
 #include "mir/shell/shell.h"
+#include "mir/executor.h"
 
 #include "boost/throw_exception.hpp"
 
 #include <string.h>
 #include <algorithm>
+#include <utility>
 
 namespace mf = mir::frontend;
 namespace msh = mir::shell;
@@ -229,6 +231,16 @@ auto property_handler(
     return property_handler<T>(connection, window, property, mf::XCBConnection::Handler<T>{std::move(handler)});
 }
 
+auto to_xsync_int64(uint64_t value) -> xcb_sync_int64_t
+{
+    return {static_cast<int32_t>(value >> 32), static_cast<uint32_t>(value & 0xffffffff)};
+}
+
+auto from_xsync_int64(xcb_sync_int64_t value) -> uint64_t
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(value.hi)) << 32) | value.lo;
+}
+
 template<typename T>
 auto make_optional_if(bool condition, T&& value) -> std::optional<T>
 {
@@ -248,6 +260,7 @@ mf::XWaylandSurface::XWaylandSurface(
     std::shared_ptr<XCBConnection> const& connection,
     XWaylandWMShell const& wm_shell,
     std::shared_ptr<XWaylandClientManager> const& client_manager,
+    time::AlarmFactory& alarm_factory,
     xcb_window_t window,
     geometry::Rectangle const& geometry,
     bool override_redirect,
@@ -342,7 +355,28 @@ mf::XWaylandSurface::XWaylandSurface(
               [this](auto hints)
               {
                   motif_wm_hints(hints);
-              })}
+              }),
+          property_handler<std::vector<uint32_t>>(
+              connection,
+              window,
+              connection->_NET_WM_SYNC_REQUEST_COUNTER,
+              {
+                  [this](auto counters)
+                  {
+                      // If there is a second (extended) counter we ignore it, the first is always the basic one
+                      set_sync_counter(counters.empty() ? XCB_NONE : counters.front());
+                  },
+                  [this](auto)
+                  {
+                      set_sync_counter(XCB_NONE);
+                  }
+              })},
+      resize_pacing{
+          alarm_factory,
+          [this](auto const& held_back, bool timed_out)
+          {
+              client_drew_size(held_back, timed_out);
+          }}
 {
     cached.geometry = geometry;
     cached.override_redirect = override_redirect;
@@ -413,6 +447,8 @@ void mf::XWaylandSurface::close()
         scene_surface = weak_scene_surface.lock();
         weak_scene_surface.reset();
 
+        destroy_sync_alarm(lock);
+
         if (surface_observer)
         {
             observer = surface_observer.value();
@@ -647,6 +683,71 @@ void mf::XWaylandSurface::property_notify(xcb_atom_t property)
     }
 }
 
+void mf::XWaylandSurface::sync_alarm_notify(xcb_sync_alarm_notify_event_t* event)
+{
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+
+        if (resize_sync.alarm == XCB_NONE || event->alarm != resize_sync.alarm)
+        {
+            return;
+        }
+    }
+
+    resize_pacing.counter_reached(from_xsync_int64(event->counter_value));
+}
+
+void mf::XWaylandSurface::client_drew_size(std::optional<geom::Rectangle> const& held_back, bool timed_out)
+{
+    if (timed_out && verbose_xwayland_logging_enabled())
+    {
+        log_debug(
+            "%s did not answer _NET_WM_SYNC_REQUEST in time, no longer waiting on it",
+            connection->window_debug_string(window).c_str());
+    }
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        release_held_commit(lock);
+    }
+
+    if (held_back)
+    {
+        inform_client_of_geometry(
+            held_back.value().left(),
+            held_back.value().top(),
+            held_back.value().size.width,
+            held_back.value().size.height);
+        connection->flush();
+    }
+}
+
+void mf::XWaylandSurface::release_held_commit(ProofOfMutexLock const&)
+{
+    if (!commit_held)
+    {
+        return;
+    }
+
+    wm_shell.wayland_executor->spawn([weak_self = weak_from_this()]()
+        {
+            if (auto const self = weak_self.lock())
+            {
+                std::function<void()> commit;
+                {
+                    std::lock_guard<std::mutex> lock{self->mutex};
+                    commit = std::move(self->commit_held);
+                    self->commit_held = nullptr;
+                }
+
+                if (commit)
+                {
+                    commit();
+                }
+            }
+        });
+}
+
 void mf::XWaylandSurface::attach_wl_surface(WlSurface* wl_surface)
 {
     // We assume we are on the Wayland thread
@@ -975,6 +1076,13 @@ void mf::XWaylandSurface::wl_surface_destroyed()
     {
         log_debug("%s's wl_surface destoyed", connection->window_debug_string(window).c_str());
     }
+
+    {
+        // The role holding the commit is about to be destroyed
+        std::lock_guard<std::mutex> lock{mutex};
+        commit_held = nullptr;
+    }
+
     close();
 }
 
@@ -987,6 +1095,18 @@ auto mf::XWaylandSurface::scene_surface() const -> std::optional<std::shared_ptr
         return std::nullopt;
 }
 
+auto mf::XWaylandSurface::hold_commit(std::function<void()> const& commit_held) -> bool
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    if (!resize_pacing.awaiting_frame())
+    {
+        return false;
+    }
+
+    this->commit_held = commit_held;
+    return true;
+}
+
 auto mf::XWaylandSurface::pending_spec(ProofOfMutexLock const&) -> msh::SurfaceSpecification&
 {
     if (!nullable_pending_spec)
@@ -1102,13 +1222,38 @@ void mf::XWaylandSurface::inform_client_of_geometry(
     std::optional<geometry::Height> height)
 {
     std::unique_lock<std::mutex> lock{mutex};
+    // Geometry that has been held back is more recent than what the client was last sent
+    auto const latest = resize_pacing.held_back().value_or(cached.geometry);
     auto const geometry = geom::Rectangle{
-        {x.value_or(cached.geometry.left()), y.value_or(cached.geometry.top())},
-        {width.value_or(cached.geometry.size.width), height.value_or(cached.geometry.size.height)}};
+        {x.value_or(latest.left()), y.value_or(latest.top())},
+        {width.value_or(latest.size.width), height.value_or(latest.size.height)}};
     if (geometry == cached.geometry)
     {
+        resize_pacing.discard_held_back();
         return;
     }
+
+    bool const use_sync_request =
+        resize_sync.alarm != XCB_NONE &&
+        cached.supported_wm_protocols.find(connection->_NET_WM_SYNC_REQUEST) != cached.supported_wm_protocols.end();
+
+    auto const configure = resize_pacing.configure(geometry, use_sync_request, geometry.size != cached.geometry.size);
+    if (configure.held_back)
+    {
+        // The client is still drawing the last size we sent. Sending more would only make it draw frames that are
+        // out of date before they're shown, so resize_pacing sends just the latest once it has drawn (or timed out).
+        return;
+    }
+
+    auto const sync_request = configure.sync_request;
+    if (sync_request)
+    {
+        // Re-arm the alarm for the new value (this is sent before the request, so it can't be missed)
+        xcb_sync_change_alarm_value_list_t alarm_values{};
+        alarm_values.value = to_xsync_int64(sync_request.value());
+        xcb_sync_change_alarm_aux(*connection, resize_sync.alarm, XCB_SYNC_CA_VALUE, &alarm_values);
+    }
+
     cached.geometry = geometry;
     inflight_configures.push_back(geometry);
     lock.unlock();
@@ -1120,6 +1265,18 @@ void mf::XWaylandSurface::inform_client_of_geometry(
         log_debug("            size: %dx%d", geometry.size.width.as_int(), geometry.size.height.as_int());
     }
 
+    if (sync_request)
+    {
+        // The client must get this before the ConfigureNotify it applies to
+        uint32_t const client_message_data[]{
+            connection->_NET_WM_SYNC_REQUEST,
+            XCB_TIME_CURRENT_TIME,
+            static_cast<uint32_t>(sync_request.value() & 0xffffffff),
+            static_cast<uint32_t>(sync_request.value() >> 32)};
+
+        connection->send_client_message<XCBType::WM_PROTOCOLS>(window, XCB_EVENT_MASK_NO_EVENT, client_message_data);
+    }
+
     connection->configure_window(
         window,
         geometry.top_left,
@@ -1390,6 +1547,71 @@ void mf::XWaylandSurface::motif_wm_hints(std::vector<uint32_t> const& hints)
     }
 }
 
+void mf::XWaylandSurface::set_sync_counter(xcb_sync_counter_t counter)
+{
+    std::optional<geom::Rectangle> deferred;
+
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (counter == resize_sync.counter)
+        {
+            return;
+        }
+
+        deferred = destroy_sync_alarm(lock);
+        resize_sync.counter = counter;
+
+        if (counter != XCB_NONE && xwm->has_xsync())
+        {
+            // The alarm fires (and becomes inactive) once the client sets the counter to the value of our latest
+            // request, inform_client_of_geometry() re-arms it with each new request
+            xcb_sync_create_alarm_value_list_t alarm_values{};
+            alarm_values.counter = counter;
+            alarm_values.valueType = XCB_SYNC_VALUETYPE_ABSOLUTE;
+            alarm_values.value = to_xsync_int64(resize_pacing.last_request() + 1);
+            alarm_values.testType = XCB_SYNC_TESTTYPE_POSITIVE_COMPARISON;
+            alarm_values.delta = to_xsync_int64(0);
+            alarm_values.events = 1;
+
+            resize_sync.alarm = xcb_generate_id(*connection);
+            xcb_sync_create_alarm_aux(
+                *connection,
+                resize_sync.alarm,
+                XCB_SYNC_CA_COUNTER |
+                    XCB_SYNC_CA_VALUE_TYPE |
+                    XCB_SYNC_CA_VALUE |
+                    XCB_SYNC_CA_TEST_TYPE |
+                    XCB_SYNC_CA_DELTA |
+                    XCB_SYNC_CA_EVENTS,
+                &alarm_values);
+        }
+    }
+
+    if (deferred)
+    {
+        inform_client_of_geometry(
+            deferred.value().left(),
+            deferred.value().top(),
+            deferred.value().size.width,
+            deferred.value().size.height);
+    }
+    connection->flush();
+}
+
+auto mf::XWaylandSurface::destroy_sync_alarm(ProofOfMutexLock const& lock) -> std::optional<geometry::Rectangle>
+{
+    if (resize_sync.alarm != XCB_NONE)
+    {
+        xcb_sync_destroy_alarm(*connection, resize_sync.alarm);
+    }
+
+    // Without an alarm there is nothing to wait for
+    resize_sync.alarm = XCB_NONE;
+    resize_sync.counter = XCB_NONE;
+    release_held_commit(lock);
+    return resize_pacing.reset();
+}
+
 auto mf::XWaylandSurface::xcb_window_get_scene_surface(
     mf::XWaylandWM* xwm,
     xcb_window_t window) -> std::shared_ptr<ms::Surface>
@@ -24,8 +24,10 @@
 #include "xwayland_client_manager.h"
 #include "xwayland_surface_role_surface.h"
 #include "xwayland_surface_observer_surface.h"
+#include "xwayland_resize_sync.h"
 
 #include <xcb/xcb.h>
+#include <xcb/sync.h>
 
 #include <mutex>
 #include <chrono>
@@ -34,6 +36,10 @@
 
 namespace mir
 {
+namespace time
+{
+class AlarmFactory;
+}
 namespace shell
 {
 class Shell;
@@ -47,7 +53,8 @@ class XWaylandSurfaceObserver;
 
 class XWaylandSurface
     : public XWaylandSurfaceRoleSurface,
-      public XWaylandSurfaceObserverSurface
+      public XWaylandSurfaceObserverSurface,
+      public std::enable_shared_from_this<XWaylandSurface>
 {
 public:
     XWaylandSurface(
@@ -55,6 +62,7 @@ public:
         std::shared_ptr<XCBConnection> const& connection,
         XWaylandWMShell const& wm_shell,
         std::shared_ptr<XWaylandClientManager> const& client_manager,
+        time::AlarmFactory& alarm_factory,
         xcb_window_t window,
         geometry::Rectangle const& geometry,
         bool override_redirect,
@@ -71,6 +79,8 @@ public:
     void property_notify(xcb_atom_t property);
     void attach_wl_surface(WlSurface* wl_surface); ///< Should only be called on the Wayland thread
     void move_resize(uint32_t detail);
+    /// Called for every XSync alarm, ignored unless it's this window's _NET_WM_SYNC_REQUEST alarm
+    void sync_alarm_notify(xcb_sync_alarm_notify_event_t* event);
 
 private:
     // See https://specifications.freedesktop.org/wm-spec/wm-spec-1.3.html#idm45805407959456
@@ -129,6 +139,7 @@ private:
     /// @{
     void wl_surface_destroyed() override;
     auto scene_surface() const -> std::optional<std::shared_ptr<scene::Surface>> override;
+    auto hold_commit(std::function<void()> const& commit_held) -> bool override;
     /// @}
 
     /// Creates a pending spec if needed and returns a reference
@@ -146,6 +157,8 @@ private:
 
     /// Calls connection->configure_window() with the given position and size, as well as tracking the calls made so
     /// future configure notifies can determine if the source was us or the client
+    /// If the client supports _NET_WM_SYNC_REQUEST and has not yet drawn the last size it was sent, the configure is
+    /// held back until it has (only the most recent held back geometry is sent)
     void inform_client_of_geometry(
         std::optional<geometry::X> x,
         std::optional<geometry::Y> y,
@@ -181,6 +194,14 @@ private:
     void apply_cached_transient_for_and_type(ProofOfMutexLock const& lock);
     void wm_size_hints(std::vector<int32_t> const& hints);
     void motif_wm_hints(std::vector<uint32_t> const& hints);
+    /// Sets up (or with XCB_NONE tears down) the alarm that tells us when the client has drawn a new size
+    void set_sync_counter(xcb_sync_counter_t counter);
+    /// Returns any geometry that was being held back, which the caller should send if the window is still in use
+    auto destroy_sync_alarm(ProofOfMutexLock const&) -> std::optional<geometry::Rectangle>;
+    /// Called by resize_pacing once the client has drawn the size it was sent (or taken too long to)
+    void client_drew_size(std::optional<geometry::Rectangle> const& held_back, bool timed_out);
+    /// Has the Wayland thread apply the commit the role is holding back, if any
+    void release_held_commit(ProofOfMutexLock const&);
 
     /// Returns the scene surface associated with a given xcb_window, or nullptr if none
     static auto xcb_window_get_scene_surface(XWaylandWM* xwm, xcb_window_t window) -> std::shared_ptr<scene::Surface>;
@@ -223,12 +244,30 @@ private:
     /// before it
     std::deque<geometry::Rectangle> inflight_configures;
 
+    /// X resources of the _NET_WM_SYNC_REQUEST protocol, see
+    /// https://specifications.freedesktop.org/wm-spec/wm-spec-1.3.html#idm45805407906624
+    struct
+    {
+        /// From the _NET_WM_SYNC_REQUEST_COUNTER property, XCB_NONE if the client didn't set one
+        xcb_sync_counter_t counter{XCB_NONE};
+
+        /// Triggered when counter reaches the latest request, XCB_NONE if there is no counter
+        xcb_sync_alarm_t alarm{XCB_NONE};
+    } resize_sync;
+
+    /// Set by the role (on the Wayland thread) while it holds back a commit, applies it
+    std::function<void()> commit_held;
+
     /// Set in set_wl_surface and cleared when a scene surface is created from it
     std::optional<std::shared_ptr<XWaylandSurfaceObserver>> surface_observer;
     std::unique_ptr<shell::SurfaceSpecification> nullable_pending_spec;
     std::shared_ptr<XWaylandClientManager::Session> client_session;
     std::weak_ptr<scene::Surface> weak_scene_surface;
     std::weak_ptr<scene::Surface> effective_parent;
+
+    /// Paces geometry sent to clients using _NET_WM_SYNC_REQUEST. Declared last so its alarm can't fire into a
+    /// partly destroyed surface.
+    XWaylandResizeSync resize_pacing;
 };
 } /* frontend */
 } /* mir */
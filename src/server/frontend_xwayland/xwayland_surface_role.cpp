@@ -131,6 +131,33 @@ void mf::XWaylandSurfaceRole::commit(WlSurfaceState const& state)
         BOOST_THROW_EXCEPTION(std::runtime_error("Got XWaylandSurfaceRole::commit() when the role had no surface"));
     }
 
+    if (!held_state)
+    {
+        held_state = WlSurfaceState();
+    }
+    held_state.value().update_from(state);
+
+    // While the client draws a new size its commits show it half drawn, so the scene keeps the previous frame until
+    // it has finished
+    auto const wm_surface = weak_wm_surface.lock();
+    if (wm_surface && wm_surface->hold_commit([this]() { commit_held_state(); }))
+    {
+        return;
+    }
+
+    commit_held_state();
+}
+
+void mf::XWaylandSurfaceRole::commit_held_state()
+{
+    if (!held_state)
+    {
+        return;
+    }
+
+    auto const state = std::move(held_state.value());
+    held_state = std::nullopt;
+
     wl_surface->commit(state);
 
     auto const surface = this->scene_surface();
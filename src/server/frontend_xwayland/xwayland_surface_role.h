@@ -20,6 +20,9 @@
 #define MIR_FRONTEND_XWAYLAND_SURFACE_ROLE_H
 
 #include "wl_surface_role.h"
+#include "wl_surface.h"
+
+#include <optional>
 
 namespace mir
 {
@@ -65,6 +68,11 @@ private:
     WlSurface* const wl_surface;
     float const scale;
 
+    /// What the client has committed while the WM surface holds its commits back
+    std::optional<WlSurfaceState> held_state;
+
+    void commit_held_state();
+
     /// Overrides from WlSurfaceRole
     /// @{
     auto scene_surface() const -> std::optional<std::shared_ptr<scene::Surface>> override;
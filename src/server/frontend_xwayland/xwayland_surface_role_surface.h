@@ -19,6 +19,7 @@
 #ifndef MIR_FRONTEND_XWAYLAND_SURFACE_ROLE_SURFACE_H
 #define MIR_FRONTEND_XWAYLAND_SURFACE_ROLE_SURFACE_H
 
+#include <functional>
 #include <memory>
 #include <optional>
 
@@ -42,6 +43,11 @@ public:
     virtual void wl_surface_destroyed() = 0;
     virtual auto scene_surface() const -> std::optional<std::shared_ptr<scene::Surface>> = 0;
 
+    /// Called on the Wayland thread for each commit. Returns true if the commit should be held back because the client
+    /// is still drawing a size it was sent, in which case \p commit_held is later called on the Wayland thread (unless
+    /// wl_surface_destroyed() is called first)
+    virtual auto hold_commit(std::function<void()> const& commit_held) -> bool = 0;
+
 private:
     XWaylandSurfaceRoleSurface(XWaylandSurfaceRoleSurface const&) = delete;
     XWaylandSurfaceRoleSurface& operator=(XWaylandSurfaceRoleSurface const&) = delete;
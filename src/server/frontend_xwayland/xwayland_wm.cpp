@@ -104,6 +104,34 @@ auto init_xfixes(mf::XCBConnection const& connection) -> xcb_query_extension_rep
     return xfixes;
 }
 
+auto init_xsync(mf::XCBConnection const& connection) -> xcb_query_extension_reply_t const*
+{
+    xcb_prefetch_extension_data(connection, &xcb_sync_id);
+
+    auto const xsync = xcb_get_extension_data(connection, &xcb_sync_id);
+    if (!xsync || !xsync->present)
+    {
+        mir::log_warning("XSync not available, X11 windows will not be resized in step with their clients");
+        return nullptr;
+    }
+
+    // Clients must initialize the extension before using it
+    auto const xsync_cookie = xcb_sync_initialize(connection, XCB_SYNC_MAJOR_VERSION, XCB_SYNC_MINOR_VERSION);
+    auto const xsync_reply = mir::make_unique_cptr(xcb_sync_initialize_reply(connection, xsync_cookie, nullptr));
+    if (!xsync_reply)
+    {
+        mir::log_warning("Failed to initialize XSync");
+        return nullptr;
+    }
+
+    if (mir::verbose_xwayland_logging_enabled())
+    {
+        mir::log_debug("XSync version: %d.%d", xsync_reply->major_version, xsync_reply->minor_version);
+    }
+
+    return xsync;
+}
+
 auto focus_mode_to_string(uint32_t focus_mode) -> std::string
 {
     switch (focus_mode)
@@ -139,9 +167,12 @@ mf::XWaylandWM::XWaylandWM(
     wl_client* wayland_client,
     Fd const& fd,
     std::shared_ptr<dispatch::MultiplexingDispatchable> const& dispatcher,
-    float assumed_surface_scale)
+    std::shared_ptr<time::AlarmFactory> const& alarm_factory,
+    float assumed_surface_scale,
+    std::function<void(bool idle)> const& idle_changed)
     : connection{std::make_shared<XCBConnection>(fd)},
       xfixes{init_xfixes(*connection)},
+      xsync{init_xsync(*connection)},
       wayland_connector(wayland_connector),
       wayland_client{wayland_client},
       wm_shell{std::static_pointer_cast<XWaylandWMShell>(wayland_connector->get_extension("x11-support"))},
@@ -152,7 +183,9 @@ mf::XWaylandWM::XWaylandWM(
       wm_window{create_wm_window(*connection)},
       scene_observer{std::make_shared<XWaylandSceneObserver>(this)},
       client_manager{std::make_shared<XWaylandClientManager>(wm_shell->shell)},
-      assumed_surface_scale{assumed_surface_scale}
+      alarm_factory{alarm_factory},
+      assumed_surface_scale{assumed_surface_scale},
+      idle_changed{idle_changed}
 {
     uint32_t const attrib_values[]{
         XCB_EVENT_MASK_SUBSTRUCTURE_NOTIFY | XCB_EVENT_MASK_SUBSTRUCTURE_REDIRECT | XCB_EVENT_MASK_PROPERTY_CHANGE};
@@ -163,6 +196,7 @@ mf::XWaylandWM::XWaylandWM(
 
     xcb_atom_t const supported[]{
         connection->_NET_WM_MOVERESIZE,
+        connection->_NET_WM_SYNC_REQUEST,
         connection->_NET_WM_STATE,
         connection->_NET_WM_STATE_FULLSCREEN,
         connection->_NET_WM_STATE_MAXIMIZED_VERT,
@@ -309,6 +343,17 @@ auto mf::XWaylandWM::get_wm_surface(
         return surface->second;
 }
 
+auto mf::XWaylandWM::has_client_windows() -> bool
+{
+    std::lock_guard<std::mutex> lock{mutex};
+    return !surfaces.empty();
+}
+
+auto mf::XWaylandWM::has_xsync() const -> bool
+{
+    return xsync != nullptr;
+}
+
 auto mf::XWaylandWM::get_focused_window() -> std::optional<xcb_window_t>
 {
     std::lock_guard<std::mutex> lock{mutex};
@@ -497,23 +542,34 @@ void mf::XWaylandWM::manage_window(xcb_window_t window, geom::Rectangle const& g
         }
     }
 
-    std::lock_guard<std::mutex> lock{mutex};
+    bool was_idle;
 
-    if (surfaces.find(window) != surfaces.end())
     {
-        // If a window is created during startup, we may be double-notified of it
-        return;
+        std::lock_guard<std::mutex> lock{mutex};
+
+        if (surfaces.find(window) != surfaces.end())
+        {
+            // If a window is created during startup, we may be double-notified of it
+            return;
+        }
+
+        was_idle = surfaces.empty();
+        surfaces[window] = std::make_shared<XWaylandSurface>(
+            this,
+            connection,
+            *wm_shell,
+            client_manager,
+            *alarm_factory,
+            window,
+            geometry,
+            override_redirect,
+            assumed_surface_scale);
     }
 
-    surfaces[window] = std::make_shared<XWaylandSurface>(
-        this,
-        connection,
-        *wm_shell,
-        client_manager,
-        window,
-        geometry,
-        override_redirect,
-        assumed_surface_scale);
+    if (was_idle)
+    {
+        idle_changed(false);
+    }
 }
 
 void mf::XWaylandWM::handle_event(xcb_generic_event_t* event)
@@ -614,6 +670,19 @@ void mf::XWaylandWM::handle_event(xcb_generic_event_t* event)
             break;
         }
     }
+
+    if (xsync)
+    {
+        auto const xsync_type = event->response_type - xsync->first_event;
+        switch (xsync_type)
+        {
+        case XCB_SYNC_ALARM_NOTIFY:
+            handle_sync_alarm_notify(reinterpret_cast<xcb_sync_alarm_notify_event_t*>(event));
+            break;
+        default:
+            break;
+        }
+    }
 }
 
 void mf::XWaylandWM::handle_property_notify(xcb_property_notify_event_t *event)
@@ -722,6 +791,7 @@ void mf::XWaylandWM::handle_destroy_notify(xcb_destroy_notify_event_t *event)
     }
 
     std::shared_ptr<XWaylandSurface> surface{nullptr};
+    bool now_idle{false};
 
     {
         std::lock_guard<std::mutex> lock{mutex};
@@ -730,11 +800,15 @@ void mf::XWaylandWM::handle_destroy_notify(xcb_destroy_notify_event_t *event)
         {
             surface = iter->second;
             surfaces.erase(iter);
+            now_idle = surfaces.empty();
         }
     }
 
     if (surface)
         surface->close();
+
+    if (now_idle)
+        idle_changed(true);
 }
 
 void mf::XWaylandWM::handle_map_request(xcb_map_request_event_t *event)
@@ -910,6 +984,29 @@ void mf::XWaylandWM::handle_focus_in(xcb_focus_in_event_t* event)
     }
 }
 
+void mf::XWaylandWM::handle_sync_alarm_notify(xcb_sync_alarm_notify_event_t* event)
+{
+    if (verbose_xwayland_logging_enabled())
+    {
+        log_debug("XCB_SYNC_ALARM_NOTIFY alarm %u", event->alarm);
+    }
+
+    // Alarms don't say which window they belong to, and there are few enough windows to ask them all
+    std::vector<std::shared_ptr<XWaylandSurface>> local_surfaces;
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        for (auto const& surface : surfaces)
+        {
+            local_surfaces.push_back(surface.second);
+        }
+    }
+
+    for (auto const& surface : local_surfaces)
+    {
+        surface->sync_alarm_notify(event);
+    }
+}
+
 void mf::XWaylandWM::handle_error(xcb_generic_error_t* event)
 {
     if (verbose_xwayland_logging_enabled())
@@ -24,6 +24,7 @@
 #include "wayland_connector.h"
 #include "xcb_connection.h"
 
+#include <functional>
 #include <map>
 #include <set>
 #include <thread>
@@ -32,6 +33,7 @@
 
 #include <wayland-server-core.h>
 #include <xcb/xfixes.h>
+#include <xcb/sync.h>
 
 namespace mir
 {
@@ -44,6 +46,10 @@ namespace dispatch
 {
 class MultiplexingDispatchable;
 }
+namespace time
+{
+class AlarmFactory;
+}
 namespace frontend
 {
 class XWaylandSurface;
@@ -67,13 +73,17 @@ public:
         wl_client* wayland_client,
         Fd const& fd,
         std::shared_ptr<dispatch::MultiplexingDispatchable> const& dispatcher,
-        float assumed_surface_scale);
+        std::shared_ptr<time::AlarmFactory> const& alarm_factory,
+        float assumed_surface_scale,
+        std::function<void(bool idle)> const& idle_changed);
     ~XWaylandWM();
 
     /// Called by the XWayland connector when there may be new events
     void handle_events();
 
     auto get_wm_surface(xcb_window_t xcb_window) -> std::optional<std::shared_ptr<XWaylandSurface>>;
+    /// If any X11 client has a top-level window (mapped or not)
+    auto has_client_windows() -> bool;
     auto get_focused_window() -> std::optional<xcb_window_t>;
     void set_focus(xcb_window_t xcb_window, bool should_be_focused);
     void remember_scene_surface(std::weak_ptr<scene::Surface> const& scene_surface, xcb_window_t window);
@@ -81,6 +91,9 @@ public:
 
     void surfaces_reordered(scene::SurfaceSet const& affected_surfaces);
 
+    /// If the X server supports the SYNC extension (and so _NET_WM_SYNC_REQUEST can be used)
+    auto has_xsync() const -> bool;
+
 private:
     XWaylandWM(XWaylandWM const&) = delete;
     XWaylandWM& operator=(XWaylandWM const&) = delete;
@@ -104,9 +117,11 @@ private:
     void handle_unmap_notify(xcb_unmap_notify_event_t *event);
     void handle_destroy_notify(xcb_destroy_notify_event_t *event);
     void handle_focus_in(xcb_focus_in_event_t* event);
+    void handle_sync_alarm_notify(xcb_sync_alarm_notify_event_t* event);
     void handle_error(xcb_generic_error_t* event);
 
     xcb_query_extension_reply_t const* const xfixes; ///< Must not be freed, can be null
+    xcb_query_extension_reply_t const* const xsync; ///< Must not be freed, can be null
     std::shared_ptr<WaylandConnector> const wayland_connector;
     wl_client* const wayland_client;
     std::shared_ptr<XWaylandWMShell> const wm_shell;
@@ -117,10 +132,13 @@ private:
     xcb_window_t const wm_window;
     std::shared_ptr<XWaylandSceneObserver> const scene_observer;
     std::shared_ptr<XWaylandClientManager> const client_manager;
+    std::shared_ptr<time::AlarmFactory> const alarm_factory;
     /// The scale we assume applications are rendering at. If this doesn't match the scale an app is actually rendering
     /// at the app will appear the wrong size. If this matches the app but both are smaller than the output scale, the
     /// app will appear the correct size but blurry.
     float const assumed_surface_scale;
+    /// Called (not under lock) with true when the last client window is destroyed and false when the first is created
+    std::function<void(bool idle)> const idle_changed;
 
     std::mutex mutex;
     std::map<xcb_window_t, std::shared_ptr<XWaylandSurface>> surfaces;
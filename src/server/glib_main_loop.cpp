@@ -131,6 +131,7 @@ mir::GLibMainLoop::GLibMainLoop(
       running_{false},
       fd_sources{main_context},
       signal_sources{fd_sources},
+      server_actions{main_context, [this](void const* owner) { return should_process_actions_for(owner); }},
       before_iteration_hook{[]{}}
 {
 }
@@ -256,12 +257,7 @@ void mir::GLibMainLoop::enqueue(void const* owner, ServerAction const& action)
             catch (...) { handle_exception(std::current_exception()); }
         };
 
-    detail::add_server_action_gsource(main_context, owner,
-        action_with_exception_handling,
-        [this] (void const* owner)
-        {
-            return should_process_actions_for(owner);
-        });
+    server_actions.enqueue(owner, action_with_exception_handling);
 }
 
 
@@ -460,9 +456,5 @@ void mir::GLibMainLoop::spawn(std::function<void()>&& work)
             catch (...) { handle_exception(std::current_exception()); }
         };
 
-    detail::add_server_action_gsource(
-        main_context,
-        nullptr,
-        action_with_exception_handling,
-        [](auto) { return true; });
+    server_actions.spawn(action_with_exception_handling);
 }
@@ -180,80 +180,6 @@ void md::add_idle_gsource(
     g_source_attach(gsource, main_context);
 }
 
-void md::add_server_action_gsource(
-    GMainContext* main_context,
-    void const* owner,
-    std::function<void()> const& action,
-    std::function<bool(void const*)> const& should_dispatch)
-{
-    struct ServerActionContext
-    {
-        void const* const owner;
-        std::function<void(void)> const action;
-        std::function<bool(void const*)> const should_dispatch;
-
-        // If we come to finalize() before dispatch() we have already
-        // torn down most of Mir and even unloaded some shared libraries.
-        // That means the action could refer to  stuff that is no longer
-        // in the address space.
-        // We will just leak any resources instead of crashing.
-        bool mutable dispatched{false};
-    };
-
-    struct ServerActionGSource
-    {
-        GSource gsource;
-        ServerActionContext ctx;
-        bool ctx_constructed;
-
-        static gboolean prepare(GSource* source, gint *timeout)
-        {
-            *timeout = -1;
-            auto const& ctx = reinterpret_cast<ServerActionGSource*>(source)->ctx;
-            return ctx.should_dispatch(ctx.owner);
-        }
-
-        static gboolean check(GSource* source)
-        {
-            auto const& ctx = reinterpret_cast<ServerActionGSource*>(source)->ctx;
-            return ctx.should_dispatch(ctx.owner);
-        }
-
-        static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
-        {
-            auto const& ctx = reinterpret_cast<ServerActionGSource*>(source)->ctx;
-            ctx.action();
-            ctx.dispatched = true;
-            return FALSE;
-        }
-
-        static void finalize(GSource* source)
-        {
-            auto const sa_gsource = reinterpret_cast<ServerActionGSource*>(source);
-            if (sa_gsource->ctx_constructed && sa_gsource->ctx.dispatched)
-                sa_gsource->ctx.~ServerActionContext();
-        }
-    };
-
-    static GSourceFuncs gsource_funcs{
-        ServerActionGSource::prepare,
-        ServerActionGSource::check,
-        ServerActionGSource::dispatch,
-        ServerActionGSource::finalize,
-        nullptr,
-        nullptr
-    };
-
-    GSourceRef gsource{g_source_new(&gsource_funcs, sizeof(ServerActionGSource))};
-    auto const sa_gsource = reinterpret_cast<ServerActionGSource*>(static_cast<GSource*>(gsource));
-
-    sa_gsource->ctx_constructed = false;
-    new (&sa_gsource->ctx) decltype(sa_gsource->ctx){owner, action, should_dispatch};
-    sa_gsource->ctx_constructed = true;
-
-    g_source_attach(gsource, main_context);
-}
-
 md::GSourceHandle md::add_timer_gsource(
     GMainContext* main_context,
     std::shared_ptr<time::Clock> const& clock,
@@ -464,6 +390,143 @@ void md::FdSources::remove_all_owned_by(void const* owner)
     sources.erase(new_end, sources.end());
 }
 
+/*********************
+ * ServerActionQueue *
+ *********************/
+
+struct md::ServerActionQueue::Source
+{
+    GSource gsource;
+    ServerActionQueue* queue;
+
+    static gboolean prepare(GSource* source, gint *timeout)
+    {
+        *timeout = -1;
+        return reinterpret_cast<Source*>(source)->queue->has_dispatchable_action();
+    }
+
+    static gboolean check(GSource* source)
+    {
+        return reinterpret_cast<Source*>(source)->queue->has_dispatchable_action();
+    }
+
+    static gboolean dispatch(GSource* source, GSourceFunc, gpointer)
+    {
+        reinterpret_cast<Source*>(source)->queue->dispatch();
+        return G_SOURCE_CONTINUE;
+    }
+};
+
+md::ServerActionQueue::ServerActionQueue(
+    GMainContext* main_context,
+    std::function<bool(void const*)> const& should_dispatch)
+    : main_context{main_context},
+      should_dispatch{should_dispatch}
+{
+    static GSourceFuncs gsource_funcs{
+        Source::prepare,
+        Source::check,
+        Source::dispatch,
+        nullptr,
+        nullptr,
+        nullptr
+    };
+
+    gsource = GSourceHandle{g_source_new(&gsource_funcs, sizeof(Source)), [](GSource*){}};
+    reinterpret_cast<Source*>(static_cast<GSource*>(gsource))->queue = this;
+    g_source_attach(gsource, main_context);
+}
+
+md::ServerActionQueue::~ServerActionQueue()
+{
+    // If we are destroyed with actions still queued we have already torn
+    // down most of Mir and even unloaded some shared libraries. That means
+    // the actions could refer to stuff that is no longer in the address space.
+    // We will just leak any resources instead of crashing.
+    std::lock_guard<std::mutex> lock{actions_mutex};
+    if (!actions.empty())
+        static_cast<void>(new std::deque<Action>{std::move(actions)});
+}
+
+void md::ServerActionQueue::enqueue(void const* owner, std::function<void()> const& action)
+{
+    add(Action{owner, true, action});
+}
+
+void md::ServerActionQueue::spawn(std::function<void()> const& action)
+{
+    add(Action{nullptr, false, action});
+}
+
+void md::ServerActionQueue::add(Action&& action)
+{
+    bool needs_wakeup;
+    {
+        std::lock_guard<std::mutex> lock{actions_mutex};
+        actions.push_back(std::move(action));
+
+        // One wakeup is enough to get the queue looked at again
+        needs_wakeup = !wakeup_pending;
+        wakeup_pending = true;
+    }
+
+    if (needs_wakeup)
+        g_main_context_wakeup(main_context);
+}
+
+bool md::ServerActionQueue::has_dispatchable_action()
+{
+    std::lock_guard<std::mutex> lock{actions_mutex};
+
+    wakeup_pending = false;
+    return std::any_of(
+        actions.begin(), actions.end(),
+        [this](Action const& action) { return !action.pausable || should_dispatch(action.owner); });
+}
+
+void md::ServerActionQueue::dispatch()
+{
+    std::deque<Action> batch;
+    {
+        std::lock_guard<std::mutex> lock{actions_mutex};
+        std::swap(batch, actions);
+    }
+
+    std::deque<Action> held;
+    std::vector<void const*> held_owners;
+
+    for (auto& action : batch)
+    {
+        if (action.pausable)
+        {
+            // Once an action of an owner is held so are the rest, even if
+            // processing for the owner is resumed part way through the batch
+            auto const owner_held =
+                std::find(held_owners.begin(), held_owners.end(), action.owner) != held_owners.end();
+
+            if (owner_held || !should_dispatch(action.owner))
+            {
+                if (!owner_held)
+                    held_owners.push_back(action.owner);
+
+                held.push_back(std::move(action));
+                continue;
+            }
+        }
+
+        action.action();
+    }
+
+    if (!held.empty())
+    {
+        std::lock_guard<std::mutex> lock{actions_mutex};
+        actions.insert(
+            actions.begin(),
+            std::make_move_iterator(held.begin()),
+            std::make_move_iterator(held.end()));
+    }
+}
+
 /*****************
  * SignalSources *
  *****************/
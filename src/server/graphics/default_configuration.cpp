@@ -142,6 +142,19 @@ auto select_platforms_from_list(std::string const& selection, std::vector<std::s
 
     return selected_modules;
 }
+
+auto probe_cache_for(mir::options::Option const& options, std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules)
+    -> std::unique_ptr<mg::PlatformProbeCache>
+{
+    if (!options.is_set(mir::options::platform_probe_cache_opt))
+    {
+        return nullptr;
+    }
+
+    return std::make_unique<mg::PlatformProbeCache>(
+        options.get<std::string>(mir::options::platform_probe_cache_opt),
+        modules);
+}
 }
 
 auto mir::DefaultServerConfiguration::the_display_platforms() -> std::vector<std::shared_ptr<graphics::DisplayPlatform>> const&
@@ -153,14 +166,7 @@ auto mir::DefaultServerConfiguration::the_display_platforms() -> std::vector<std
 
         try
         {
-            auto const& path = the_options()->get<std::string>(options::platform_path);
-            auto platforms = mir::libraries_for_path(path, *the_shared_library_prober_report());
-
-            if (platforms.empty())
-            {
-                auto msg = "Failed to find any platform plugins in: " + path;
-                throw std::runtime_error(msg.c_str());
-            }
+            auto const& platforms = the_platform_candidates();
 
             if (the_options()->is_set(options::platform_display_libs))
             {
@@ -188,7 +194,8 @@ auto mir::DefaultServerConfiguration::the_display_platforms() -> std::vector<std
             }
             else
             {
-                platform_modules = mir::graphics::display_modules_for_device(platforms, dynamic_cast<mir::options::ProgramOption&>(*the_options()), the_console_services());
+                auto const cache = probe_cache_for(*the_options(), platforms);
+                platform_modules = mir::graphics::display_modules_for_device(platforms, dynamic_cast<mir::options::ProgramOption&>(*the_options()), the_console_services(), cache.get());
             }
 
             for (auto const& platform : platform_modules)
@@ -230,6 +237,7 @@ auto mir::DefaultServerConfiguration::the_display_platforms() -> std::vector<std
         {
             BOOST_THROW_EXCEPTION(std::runtime_error(error_report.str()));
         }
+        release_unused_platform_candidates();
     }
 
     return display_platforms;
@@ -245,14 +253,7 @@ auto mir::DefaultServerConfiguration::the_rendering_platforms() ->
 
         try
         {
-            auto const& path = the_options()->get<std::string>(options::platform_path);
-            auto platforms = mir::libraries_for_path(path, *the_shared_library_prober_report());
-
-            if (platforms.empty())
-            {
-                auto msg = "Failed to find any platform plugins in: " + path;
-                throw std::runtime_error(msg.c_str());
-            }
+            auto const& platforms = the_platform_candidates();
 
             if (the_options()->is_set(options::platform_rendering_libs))
             {
@@ -280,7 +281,8 @@ auto mir::DefaultServerConfiguration::the_rendering_platforms() ->
             }
             else
             {
-                platform_modules = mir::graphics::rendering_modules_for_device(platforms, dynamic_cast<mir::options::ProgramOption&>(*the_options()), the_console_services());
+                auto const cache = probe_cache_for(*the_options(), platforms);
+                platform_modules = mir::graphics::rendering_modules_for_device(platforms, dynamic_cast<mir::options::ProgramOption&>(*the_options()), the_console_services(), cache.get());
             }
 
             for (auto const& platform : platform_modules)
@@ -320,6 +322,7 @@ auto mir::DefaultServerConfiguration::the_rendering_platforms() ->
         {
             BOOST_THROW_EXCEPTION(std::runtime_error(error_report.str()));
         }
+        release_unused_platform_candidates();
     }
 
     return rendering_platforms;
@@ -331,6 +334,32 @@ auto mir::DefaultServerConfiguration::the_platform_libaries()
     return platform_libraries;
 }
 
+auto mir::DefaultServerConfiguration::the_platform_candidates()
+    -> std::vector<std::shared_ptr<mir::SharedLibrary>> const&
+{
+    if (platform_candidates.empty())
+    {
+        auto const& path = the_options()->get<std::string>(options::platform_path);
+        platform_candidates = mir::libraries_for_path(path, *the_shared_library_prober_report());
+
+        if (platform_candidates.empty())
+        {
+            auto msg = "Failed to find any platform plugins in: " + path;
+            throw std::runtime_error(msg.c_str());
+        }
+    }
+    return platform_candidates;
+}
+
+void mir::DefaultServerConfiguration::release_unused_platform_candidates()
+{
+    // Once both display and rendering platforms are chosen the rest can be unloaded
+    if (!display_platforms.empty() && !rendering_platforms.empty())
+    {
+        platform_candidates.clear();
+    }
+}
+
 std::shared_ptr<mg::GraphicBufferAllocator>
 mir::DefaultServerConfiguration::the_buffer_allocator()
 {
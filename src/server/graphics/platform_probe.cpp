@@ -21,6 +21,12 @@
 #include "platform_probe.h"
 
 #include <boost/throw_exception.hpp>
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <fstream>
+#include <future>
+#include <sstream>
 
 namespace
 {
@@ -84,80 +90,338 @@ enum class ModuleType
     Display
 };
 
-auto modules_for_device(
+auto name_of(ModuleType type) -> std::string
+{
+    switch (type)
+    {
+    case ModuleType::Rendering:
+        return "rendering";
+    case ModuleType::Display:
+        return "display";
+    }
+    return "unknown";
+}
+
+/* Each probe can open DRM devices, query udev and initialise EGL, and the probes of
+ * different modules don't depend on each other, so rendering probes are all run at once.
+ *
+ * Display probes acquire their devices (and DRM master) from the console, and two
+ * modules probing the same card at once would contend for it, so they are run in turn.
+ *
+ * A module that fails to probe is unsupported.
+ */
+auto probe_all(
     ModuleType type,
     std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules,
     mir::options::ProgramOption const& options,
     std::shared_ptr<mir::ConsoleServices> const& console)
+-> std::vector<mir::graphics::PlatformPriority>
+{
+    // Deferred probes run, one at a time, as their results are collected below
+    auto const policy = type == ModuleType::Display ? std::launch::deferred : std::launch::async;
+
+    std::vector<std::future<mir::graphics::PlatformPriority>> probes;
+    probes.reserve(modules.size());
+    for (auto const& module : modules)
+    {
+        probes.push_back(std::async(
+            policy,
+            [type, module, &options, &console]()
+            {
+                switch (type)
+                {
+                case ModuleType::Rendering:
+                    return mir::graphics::probe_rendering_module(*module, options, console);
+                case ModuleType::Display:
+                    return mir::graphics::probe_display_module(*module, options, console);
+                }
+                return mir::graphics::unsupported;
+            }));
+    }
+
+    std::vector<mir::graphics::PlatformPriority> priorities;
+    priorities.reserve(probes.size());
+    for (auto& probe : probes)
+    {
+        try
+        {
+            priorities.push_back(probe.get());
+        }
+        catch (std::runtime_error const&)
+        {
+            priorities.push_back(mir::graphics::unsupported);
+        }
+    }
+    return priorities;
+}
+
+auto name_of(mir::SharedLibrary& module) -> std::string
+{
+    auto describe = module.load_function<mir::graphics::DescribeModule>(
+        "describe_graphics_module",
+        MIR_SERVER_GRAPHICS_PLATFORM_VERSION);
+    return describe()->name;
+}
+
+auto cached_modules_for_device(
+    ModuleType type,
+    mir::options::ProgramOption const& options,
+    std::shared_ptr<mir::ConsoleServices> const& console,
+    mir::graphics::PlatformProbeCache const& cache)
+-> std::vector<std::shared_ptr<mir::SharedLibrary>>
+{
+    auto const record = cache.lookup(name_of(type));
+    if (record.modules.empty())
+    {
+        return {};
+    }
+
+    for (auto const priority : probe_all(type, record.modules, options, console))
+    {
+        if (priority != record.priority)
+        {
+            mir::log_info("Cached %s platform selection is out of date", name_of(type).c_str());
+            return {};
+        }
+    }
+    return record.modules;
+}
+
+auto modules_for_device(
+    ModuleType type,
+    std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules,
+    mir::options::ProgramOption const& options,
+    std::shared_ptr<mir::ConsoleServices> const& console,
+    mir::graphics::PlatformProbeCache* cache)
 -> std::vector<std::shared_ptr<mir::SharedLibrary>>
 {
+    if (cache)
+    {
+        auto cached_modules = cached_modules_for_device(type, options, console, *cache);
+        if (!cached_modules.empty())
+        {
+            return cached_modules;
+        }
+    }
+
+    /* TODO: We will (pretty shortly) need to have some concept of binding-a-device.
+     * What we really want to do here is:
+     * foreach device in system:
+     *   find best driver for device
+     *
+     * For now, hopefully “load each platform that claims to best support (at least some)
+     * device” will work.
+     */
+    auto const priorities = probe_all(type, modules, options, console);
+
     mir::graphics::PlatformPriority best_priority_so_far = mir::graphics::unsupported;
     std::vector<std::shared_ptr<mir::SharedLibrary>> best_modules_so_far;
-    for (auto& module : modules)
+    for (size_t i = 0; i != modules.size(); ++i)
     {
-        try
+        auto const module_priority = priorities[i];
+        if (module_priority > best_priority_so_far)
         {
-            /* TODO: We will (pretty shortly) need to have some concept of binding-a-device.
-             * What we really want to do here is:
-             * foreach device in system:
-             *   find best driver for device
-             *
-             * For now, hopefully “load each platform that claims to best support (at least some)
-             * device” will work.
-             */
-            mir::graphics::PlatformPriority module_priority;
-            switch (type)
-            {
-            case ModuleType::Rendering:
-                module_priority = mir::graphics::probe_rendering_module(*module, options, console);
-                break;
-            case ModuleType::Display:
-                module_priority = mir::graphics::probe_display_module(*module, options, console);
-                break;
-            }
-            if (module_priority > best_priority_so_far)
-            {
-                best_priority_so_far = module_priority;
-                best_modules_so_far.clear();
-                best_modules_so_far.push_back(module);
-            }
-            else if (module_priority == best_priority_so_far)
-            {
-                best_modules_so_far.push_back(module);
-            }
+            best_priority_so_far = module_priority;
+            best_modules_so_far.clear();
+            best_modules_so_far.push_back(modules[i]);
         }
-        catch (std::runtime_error const&)
+        else if (module_priority == best_priority_so_far)
         {
+            best_modules_so_far.push_back(modules[i]);
         }
     }
     if (best_priority_so_far > mir::graphics::unsupported)
     {
+        if (cache)
+        {
+            cache->store(name_of(type), {best_priority_so_far, best_modules_so_far});
+        }
         return best_modules_so_far;
     }
     BOOST_THROW_EXCEPTION((std::runtime_error{"Failed to find any platforms for current system"}));
 }
+
+/// The DRM devices in sysfs, and where each sits on its bus
+auto drm_devices_fingerprint() -> std::string
+{
+    std::vector<std::string> devices;
+
+    boost::system::error_code ignored;
+    for (auto const& entry : boost::filesystem::directory_iterator{"/sys/class/drm", ignored})
+    {
+        auto const name = entry.path().filename().string();
+        // Skip connectors (card0-HDMI-A-1) and render nodes; each card has one of each
+        if (name.compare(0, 4, "card") != 0 || name.find('-') != std::string::npos)
+        {
+            continue;
+        }
+
+        auto const device = entry.path() / "device";
+        std::string modalias;
+        std::ifstream{(device / "modalias").string()} >> modalias;
+        devices.push_back(
+            name + "=" + boost::filesystem::canonical(device, ignored).string() + "@" + modalias);
+    }
+
+    std::sort(devices.begin(), devices.end());
+
+    std::string fingerprint;
+    for (auto const& device : devices)
+    {
+        fingerprint += device + ";";
+    }
+    return fingerprint;
+}
+}
+
+mir::graphics::PlatformProbeCache::PlatformProbeCache(
+    std::string path,
+    std::vector<std::shared_ptr<SharedLibrary>> const& modules)
+    : path{std::move(path)},
+      fingerprint{[&]()
+          {
+              auto key = drm_devices_fingerprint();
+              for (auto const& module : modules)
+              {
+                  try
+                  {
+                      key += name_of(*module) + ";";
+                  }
+                  catch (std::runtime_error const&)
+                  {
+                      // Not a graphics platform
+                  }
+              }
+
+              std::stringstream hash;
+              hash << std::hex << std::hash<std::string>{}(key);
+              return hash.str();
+          }()},
+      available{modules}
+{
+}
+
+/* The cache file has a line per type:
+ *   <type> <fingerprint> <priority> <module name>[,<module name>...]
+ */
+auto mir::graphics::PlatformProbeCache::lookup(std::string const& type) const -> Record
+{
+    std::ifstream file{path};
+    std::string line;
+    while (std::getline(file, line))
+    {
+        std::istringstream fields{line};
+        std::string record_type, record_fingerprint, names;
+        uint32_t priority;
+        if (!(fields >> record_type >> record_fingerprint >> priority >> names) ||
+            record_type != type ||
+            record_fingerprint != fingerprint)
+        {
+            continue;
+        }
+
+        Record record{static_cast<PlatformPriority>(priority), {}};
+        std::istringstream name_stream{names};
+        std::string name;
+        while (std::getline(name_stream, name, ','))
+        {
+            auto const module = std::find_if(
+                available.begin(),
+                available.end(),
+                [&name](auto const& module)
+                {
+                    try
+                    {
+                        return name_of(*module) == name;
+                    }
+                    catch (std::runtime_error const&)
+                    {
+                        return false;
+                    }
+                });
+
+            if (module == available.end())
+            {
+                return {};
+            }
+            record.modules.push_back(*module);
+        }
+        return record;
+    }
+    return {};
+}
+
+void mir::graphics::PlatformProbeCache::store(std::string const& type, Record const& record)
+{
+    std::vector<std::string> lines;
+    {
+        std::ifstream file{path};
+        std::string line;
+        while (std::getline(file, line))
+        {
+            if (line.compare(0, type.size() + 1, type + " ") != 0)
+            {
+                lines.push_back(line);
+            }
+        }
+    }
+
+    std::string names;
+    for (auto const& module : record.modules)
+    {
+        names += (names.empty() ? "" : ",") + name_of(*module);
+    }
+    lines.push_back(type + " " + fingerprint + " " + std::to_string(record.priority) + " " + names);
+
+    // Replace the file in one step, so that a crash can't leave a partial record
+    auto const new_path = path + ".new";
+    {
+        std::ofstream file{new_path, std::ios::trunc};
+        for (auto const& line : lines)
+        {
+            file << line << '\n';
+        }
+        if (!file.flush())
+        {
+            mir::log_warning("Failed to write platform probe cache %s", new_path.c_str());
+            return;
+        }
+    }
+    boost::system::error_code error;
+    boost::filesystem::rename(new_path, path, error);
+    if (error)
+    {
+        mir::log_warning(
+            "Failed to update platform probe cache %s: %s",
+            path.c_str(),
+            error.message().c_str());
+    }
 }
 
 auto mir::graphics::display_modules_for_device(
     std::vector<std::shared_ptr<SharedLibrary>> const& modules,
     options::ProgramOption const& options,
-    std::shared_ptr<ConsoleServices> const& console) -> std::vector<std::shared_ptr<SharedLibrary>>
+    std::shared_ptr<ConsoleServices> const& console,
+    PlatformProbeCache* cache) -> std::vector<std::shared_ptr<SharedLibrary>>
 {
     return modules_for_device(
         ModuleType::Display,
         modules,
         options,
-        console);
+        console,
+        cache);
 }
 
 auto mir::graphics::rendering_modules_for_device(
     std::vector<std::shared_ptr<SharedLibrary>> const& modules,
     options::ProgramOption const& options,
-    std::shared_ptr<ConsoleServices> const& console) -> std::vector<std::shared_ptr<SharedLibrary>>
+    std::shared_ptr<ConsoleServices> const& console,
+    PlatformProbeCache* cache) -> std::vector<std::shared_ptr<SharedLibrary>>
 {
     return modules_for_device(
         ModuleType::Rendering,
         modules,
         options,
-        console);
+        console,
+        cache);
 }
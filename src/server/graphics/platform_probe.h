@@ -21,6 +21,7 @@
 
 #include <vector>
 #include <memory>
+#include <string>
 #include "mir/shared_library.h"
 #include "mir/options/program_option.h"
 #include "mir/graphics/platform.h"
@@ -43,16 +44,56 @@ auto probe_rendering_module(
     options::ProgramOption const& options,
     std::shared_ptr<ConsoleServices> const& console) -> PlatformPriority;
 
+/**
+ * Remembers which platform modules were selected for the hardware present
+ *
+ * Records are kept in a file and keyed on the DRM devices udev exposes in
+ * sysfs and on the modules available, so adding or moving a GPU or installing
+ * a platform invalidates them. This is intended for deployments where neither
+ * changes between runs; a platform that would now probe better for other
+ * reasons (such as a host display server appearing) is not noticed.
+ */
+class PlatformProbeCache
+{
+public:
+    PlatformProbeCache(std::string path, std::vector<std::shared_ptr<SharedLibrary>> const& modules);
+
+    struct Record
+    {
+        PlatformPriority priority;
+        std::vector<std::shared_ptr<SharedLibrary>> modules;
+    };
+
+    /// The modules recorded for \a type ("display" or "rendering"), or no modules if there is no record
+    auto lookup(std::string const& type) const -> Record;
+    void store(std::string const& type, Record const& record);
+
+private:
+    std::string const path;
+    std::string const fingerprint;
+    std::vector<std::shared_ptr<SharedLibrary>> const available;
+};
+
+/**
+ * The modules that best support the hardware present
+ *
+ * Rendering modules are probed concurrently; display modules are probed in turn,
+ * as they contend for the same devices. If \a cache is given and has a record
+ * for this hardware only the recorded modules are probed, falling back to probing
+ * everything if any of them no longer reports the priority it had.
+ */
 auto display_modules_for_device(
     std::vector<std::shared_ptr<SharedLibrary>> const& modules,
     options::ProgramOption const& options,
-    std::shared_ptr<ConsoleServices> const& console)
+    std::shared_ptr<ConsoleServices> const& console,
+    PlatformProbeCache* cache = nullptr)
     -> std::vector<std::shared_ptr<SharedLibrary>>;
 
 auto rendering_modules_for_device(
     std::vector<std::shared_ptr<SharedLibrary>> const& modules,
     options::ProgramOption const& options,
-    std::shared_ptr<ConsoleServices> const& console)
+    std::shared_ptr<ConsoleServices> const& console,
+    PlatformProbeCache* cache = nullptr)
     -> std::vector<std::shared_ptr<SharedLibrary>>;
 }
 }
@@ -26,6 +26,7 @@
 #include "mir/scene/null_surface_observer.h"
 #include "mir/scene/surface.h"
 
+#include <algorithm>
 #include <mutex>
 #include <map>
 
@@ -152,6 +153,11 @@ struct UpdateCursorOnSceneChanges : ms::Observer
         cursor_controller->update_cursor_image();
     }
 
+    void scene_damaged(geom::Rectangle const&) override
+    {
+        // Only input visualizations (such as the cursor itself) damage the scene
+    }
+
     void surface_exists(std::shared_ptr<ms::Surface> const& surface) override
     {
         add_surface_observer(surface.get());
@@ -177,17 +183,16 @@ private:
     std::map<ms::Surface*, std::weak_ptr<ms::SurfaceObserver>> surface_observers;
 };
 
-std::shared_ptr<mi::Surface> topmost_surface_containing_point(
-    std::shared_ptr<mi::Scene> const& targets, geom::Point const& point)
+// The index of the first of surfaces[begin, end) containing point, or end if there's none
+size_t first_surface_containing_point(
+    std::vector<std::shared_ptr<mi::Surface>> const& surfaces, size_t begin, size_t end, geom::Point const& point)
 {
-    std::shared_ptr<mi::Surface> top_surface_at_point;
-    targets->for_each([&top_surface_at_point, &point]
-        (std::shared_ptr<mi::Surface> const& surface) 
-        {
-            if (surface->input_area_contains(point))
-                top_surface_at_point = surface;
-        });
-    return top_surface_at_point;
+    for (auto i = begin; i != end; ++i)
+    {
+        if (surfaces[i]->input_area_contains(point))
+            return i;
+    }
+    return end;
 }
 
 bool is_empty(std::shared_ptr<mg::CursorImage> const& image)
@@ -249,10 +254,50 @@ void mi::CursorController::set_cursor_image_locked(std::unique_lock<std::mutex>&
 
 void mi::CursorController::update_cursor_image_locked(std::unique_lock<std::mutex>& lock)
 {
-    auto surface = topmost_surface_containing_point(input_targets, cursor_location);
-    if (surface)
+    bool const rescanned = surfaces_stale;
+
+    if (surfaces_stale)
+    {
+        surfaces_topmost_first.clear();
+        input_targets->for_each([this](std::shared_ptr<mi::Surface> const& surface)
+            {
+                surfaces_topmost_first.push_back(surface);
+            });
+        std::reverse(surfaces_topmost_first.begin(), surfaces_topmost_first.end());
+        surfaces_stale = false;
+    }
+
+    auto const& surfaces = surfaces_topmost_first;
+    auto const none = surfaces.size();
+    auto const previous = surface_under_cursor;
+
+    if (rescanned)
+    {
+        surface_under_cursor = first_surface_containing_point(surfaces, 0, none, cursor_location);
+    }
+    else if (previous != none && surfaces[previous]->input_area_contains(cursor_location))
+    {
+        // Only a surface above the one under the cursor can have taken the cursor from it
+        surface_under_cursor = first_surface_containing_point(surfaces, 0, previous, cursor_location);
+    }
+    else
+    {
+        // No need to hit-test the surface the cursor has just left again
+        surface_under_cursor = first_surface_containing_point(surfaces, 0, previous, cursor_location);
+        if (surface_under_cursor == previous && previous != none)
+        {
+            surface_under_cursor = first_surface_containing_point(surfaces, previous + 1, none, cursor_location);
+        }
+    }
+
+    // Changes to the cursor image of a surface come with a rescan, so if we're still over
+    // the same surface (or still over none) there's nothing to do
+    if (!rescanned && surface_under_cursor == previous)
+        return;
+
+    if (surface_under_cursor != none)
     {
-        set_cursor_image_locked(lock, surface->cursor_image());
+        set_cursor_image_locked(lock, surfaces[surface_under_cursor]->cursor_image());
     }
     else
     {
@@ -263,6 +308,7 @@ void mi::CursorController::update_cursor_image_locked(std::unique_lock<std::mute
 void mi::CursorController::update_cursor_image()
 {
     std::unique_lock<std::mutex> lock(cursor_state_guard);
+    surfaces_stale = true;
     update_cursor_image_locked(lock);
 }
 
@@ -24,6 +24,7 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace mir
 {
@@ -40,6 +41,7 @@ class Observer;
 namespace input
 {
 class Scene;
+class Surface;
 
 class CursorController : public CursorListener
 {
@@ -70,6 +72,14 @@ private:
     std::shared_ptr<graphics::CursorImage> current_cursor;
     bool usable = false;
 
+    // The scene's surfaces, topmost first. Only refreshed after the scene or one of
+    // its surfaces changes, so that pointer motion doesn't need to walk the scene.
+    std::vector<std::shared_ptr<Surface>> surfaces_topmost_first;
+    bool surfaces_stale = true;
+    // Index into surfaces_topmost_first of the surface under the cursor, or its size if there's none.
+    // Pointer motion only needs to hit-test this surface and those above it.
+    size_t surface_under_cursor = 0;
+
     // Used only to serialize calls to pointer_usable()/pointer_unusable()
     std::mutex serialize_pointer_usable_unusable;
 
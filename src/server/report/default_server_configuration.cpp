@@ -70,6 +70,15 @@ auto mir::DefaultServerConfiguration::the_compositor_report() -> std::shared_ptr
         });
 }
 
+auto mir::DefaultServerConfiguration::the_input_latency_report() -> std::shared_ptr<mc::InputLatencyReport>
+{
+    return input_latency_report(
+        [this]()->std::shared_ptr<mc::InputLatencyReport>
+        {
+            return report_factory(options::input_latency_report_opt)->create_input_latency_report();
+        });
+}
+
 auto mir::DefaultServerConfiguration::the_display_report() -> std::shared_ptr<mg::DisplayReport>
 {
     return display_report(
@@ -0,0 +1,173 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_latency_report.h"
+#include "mir/logging/logger.h"
+#include "mir/graphics/buffer.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace mg = mir::graphics;
+namespace ml = mir::logging;
+namespace mrl = mir::report::logging;
+
+namespace
+{
+char const* const component = "input-latency";
+auto const min_report_interval = std::chrono::seconds(1);
+
+/// The sample at \a percent (0-100) through \a samples in microseconds; \a samples are partially reordered
+auto percentile(std::vector<std::chrono::nanoseconds>& samples, size_t percent) -> long
+{
+    auto const nth = samples.begin() + (samples.size() - 1) * percent / 100;
+    std::nth_element(samples.begin(), nth, samples.end());
+    return std::chrono::duration_cast<std::chrono::microseconds>(*nth).count();
+}
+}
+
+mrl::InputLatencyReport::InputLatencyReport(
+    std::shared_ptr<ml::Logger> const& logger,
+    std::shared_ptr<time::Clock> const& clock)
+    : logger{logger},
+      clock{clock},
+      last_report{clock->now()}
+{
+}
+
+void mrl::InputLatencyReport::buffer_committed(
+    SurfaceId surface,
+    mg::BufferID buffer,
+    std::chrono::nanoseconds input_time)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    // wl_surface is mailbox mode: if an earlier response from this surface hasn't been composited it never will be,
+    // and this buffer is the first that can show the effect of the earlier input.
+    for (auto i = committed.begin(); i != committed.end(); ++i)
+    {
+        if (i->second.surface == surface)
+        {
+            input_time = std::min(input_time, i->second.input_time);
+            committed.erase(i);
+            break;
+        }
+    }
+
+    committed[buffer] = Response{surface, input_time};
+}
+
+void mrl::InputLatencyReport::surface_destroyed(SurfaceId surface)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    for (auto i = committed.begin(); i != committed.end();)
+    {
+        if (i->second.surface == surface)
+            i = committed.erase(i);
+        else
+            ++i;
+    }
+
+    for (auto& frame : in_frame)
+    {
+        auto& responses = frame.second;
+        responses.erase(
+            std::remove_if(responses.begin(), responses.end(), [&](auto const& r) { return r.surface == surface; }),
+            responses.end());
+    }
+
+    samples.erase(surface);
+}
+
+void mrl::InputLatencyReport::renderables_in_frame(SubCompositorId id, mg::RenderableList const& renderables)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    if (committed.empty())
+        return;
+
+    for (auto const& renderable : renderables)
+    {
+        if (auto const buffer = renderable->buffer())
+        {
+            auto const response = committed.find(buffer->id());
+            if (response != committed.end())
+            {
+                in_frame[id].push_back(response->second);
+                committed.erase(response);
+            }
+        }
+    }
+}
+
+void mrl::InputLatencyReport::frame_posted(SubCompositorId id)
+{
+    std::lock_guard<std::mutex> lock{mutex};
+
+    auto const now = clock->now();
+
+    auto const frame = in_frame.find(id);
+    if (frame != in_frame.end())
+    {
+        for (auto const& response : frame->second)
+        {
+            auto const latency = now.time_since_epoch() - response.input_time;
+
+            // Input devices that don't stamp events with CLOCK_MONOTONIC can't be measured
+            if (latency >= std::chrono::nanoseconds::zero())
+                samples[response.surface].push_back(latency);
+        }
+        in_frame.erase(frame);
+    }
+
+    if ((now - last_report) >= min_report_interval)
+    {
+        last_report = now;
+        log_samples();
+    }
+}
+
+void mrl::InputLatencyReport::log_samples()
+{
+    for (auto& surface : samples)
+    {
+        auto& latencies = surface.second;
+
+        // Keep everything in microseconds to avoid floating point
+        long const min_usec = percentile(latencies, 0);
+        long const median_usec = percentile(latencies, 50);
+        long const p95_usec = percentile(latencies, 95);
+        long const max_usec = percentile(latencies, 100);
+
+        char msg[192];
+        snprintf(msg, sizeof msg, "Surface %p input-to-scanout latency over %zu frames: "
+                 "min %ld.%03ld ms, "
+                 "median %ld.%03ld ms, "
+                 "95%% %ld.%03ld ms, "
+                 "max %ld.%03ld ms",
+                 surface.first,
+                 latencies.size(),
+                 min_usec / 1000, min_usec % 1000,
+                 median_usec / 1000, median_usec % 1000,
+                 p95_usec / 1000, p95_usec % 1000,
+                 max_usec / 1000, max_usec % 1000);
+
+        logger->log(ml::Severity::informational, msg, component);
+    }
+
+    samples.clear();
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_LOGGING_INPUT_LATENCY_REPORT_H_
+#define MIR_REPORT_LOGGING_INPUT_LATENCY_REPORT_H_
+
+#include "mir/compositor/input_latency_report.h"
+#include "mir/time/clock.h"
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace mir
+{
+namespace logging
+{
+class Logger;
+}
+namespace report
+{
+namespace logging
+{
+
+/// Periodically logs the distribution of input-to-scanout latency for each surface that has responded to input
+class InputLatencyReport : public compositor::InputLatencyReport
+{
+public:
+    InputLatencyReport(
+        std::shared_ptr<mir::logging::Logger> const& logger,
+        std::shared_ptr<time::Clock> const& clock);
+
+    void buffer_committed(SurfaceId surface, graphics::BufferID buffer, std::chrono::nanoseconds input_time) override;
+    void surface_destroyed(SurfaceId surface) override;
+    void renderables_in_frame(SubCompositorId id, graphics::RenderableList const& renderables) override;
+    void frame_posted(SubCompositorId id) override;
+
+private:
+    struct Response
+    {
+        SurfaceId surface;
+        std::chrono::nanoseconds input_time;
+    };
+
+    void log_samples();
+
+    std::shared_ptr<mir::logging::Logger> const logger;
+    std::shared_ptr<time::Clock> const clock;
+
+    std::mutex mutex; // Protects the following...
+    std::unordered_map<graphics::BufferID, Response> committed;
+    std::unordered_map<SubCompositorId, std::vector<Response>> in_frame;
+    std::unordered_map<SurfaceId, std::vector<std::chrono::nanoseconds>> samples;
+    time::Timestamp last_report;
+};
+
+} // namespace logging
+} // namespace report
+} // namespace mir
+
+#endif // MIR_REPORT_LOGGING_INPUT_LATENCY_REPORT_H_
@@ -20,6 +20,7 @@
 
 #include "compositor_report.h"
 #include "display_report.h"
+#include "input_latency_report.h"
 #include "scene_report.h"
 #include "shell_report.h"
 #include "input_report.h"
@@ -42,6 +43,11 @@ std::shared_ptr<mir::compositor::CompositorReport> mr::LoggingReportFactory::cre
     return std::make_shared<logging::CompositorReport>(logger, clock);
 }
 
+std::shared_ptr<mir::compositor::InputLatencyReport> mr::LoggingReportFactory::create_input_latency_report()
+{
+    return std::make_shared<logging::InputLatencyReport>(logger, clock);
+}
+
 std::shared_ptr<mir::graphics::DisplayReport> mr::LoggingReportFactory::create_display_report()
 {
     return std::make_shared<logging::DisplayReport>(logger);
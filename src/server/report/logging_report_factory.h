@@ -41,6 +41,7 @@ public:
     LoggingReportFactory(std::shared_ptr<mir::logging::Logger> const& logger,
                          std::shared_ptr<time::Clock> const& clock);
     std::shared_ptr<compositor::CompositorReport> create_compositor_report() override;
+    std::shared_ptr<compositor::InputLatencyReport> create_input_latency_report() override;
     std::shared_ptr<graphics::DisplayReport> create_display_report() override;
     std::shared_ptr<scene::SceneReport> create_scene_report() override;
 
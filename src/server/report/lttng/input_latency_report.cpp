@@ -0,0 +1,54 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_latency_report.h"
+
+#include "mir/graphics/buffer.h"
+#include "mir/report/lttng/mir_tracepoint.h"
+
+#define TRACEPOINT_DEFINE
+#define TRACEPOINT_PROBE_DYNAMIC_LINKAGE
+#include "input_latency_report_tp.h"
+
+#include <vector>
+
+void mir::report::lttng::InputLatencyReport::buffer_committed(
+    SurfaceId surface,
+    graphics::BufferID buffer,
+    std::chrono::nanoseconds input_time)
+{
+    mir_tracepoint(mir_server_input_latency, buffer_committed, surface, buffer.as_value(), input_time.count());
+}
+
+void mir::report::lttng::InputLatencyReport::surface_destroyed(SurfaceId surface)
+{
+    mir_tracepoint(mir_server_input_latency, surface_destroyed, surface);
+}
+
+void mir::report::lttng::InputLatencyReport::renderables_in_frame(
+    SubCompositorId id, graphics::RenderableList const& list)
+{
+    std::vector<uint32_t> ids(list.size());
+    auto it = list.begin();
+    for(auto& id : ids)
+        id = (*it++)->buffer()->id().as_value();
+    mir_tracepoint(mir_server_input_latency, buffers_in_frame, id, ids.data(), ids.size());
+}
+
+void mir::report::lttng::InputLatencyReport::frame_posted(SubCompositorId id)
+{
+    mir_tracepoint(mir_server_input_latency, frame_posted, id);
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MIR_REPORT_LTTNG_INPUT_LATENCY_REPORT_H_
+#define MIR_REPORT_LTTNG_INPUT_LATENCY_REPORT_H_
+
+#include "server_tracepoint_provider.h"
+
+#include "mir/compositor/input_latency_report.h"
+
+namespace mir
+{
+namespace report
+{
+namespace lttng
+{
+
+/// Traces the raw events; latencies are derived by correlating buffer ids offline
+class InputLatencyReport : public compositor::InputLatencyReport
+{
+public:
+    void buffer_committed(SurfaceId surface, graphics::BufferID buffer, std::chrono::nanoseconds input_time) override;
+    void surface_destroyed(SurfaceId surface) override;
+    void renderables_in_frame(SubCompositorId id, graphics::RenderableList const& renderables) override;
+    void frame_posted(SubCompositorId id) override;
+private:
+    ServerTracepointProvider tp_provider;
+};
+
+} // namespace lttng
+} // namespace report
+} // namespace mir
+
+#endif // MIR_REPORT_LTTNG_INPUT_LATENCY_REPORT_H_
@@ -0,0 +1,70 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER mir_server_input_latency
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "./input_latency_report_tp.h"
+
+#if !defined(MIR_LTTNG_INPUT_LATENCY_REPORT_TP_H_) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define MIR_LTTNG_INPUT_LATENCY_REPORT_TP_H_
+
+#include <lttng/tracepoint.h>
+#include <stdint.h>
+
+TRACEPOINT_EVENT(
+    mir_server_input_latency,
+    buffer_committed,
+    TP_ARGS(void const*, surface, unsigned int, buffer_id, int64_t, input_time),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, surface, (uintptr_t)(surface))
+        ctf_integer(unsigned int, buffer_id, buffer_id)
+        ctf_integer(int64_t, input_time, input_time)
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_input_latency,
+    surface_destroyed,
+    TP_ARGS(void const*, surface),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, surface, (uintptr_t)(surface))
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_input_latency,
+    buffers_in_frame,
+    TP_ARGS(void const*, id, unsigned int*, buffer_ids, size_t, buffer_ids_len),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, id, (uintptr_t)(id))
+        ctf_sequence(unsigned int, buffer_ids, buffer_ids, size_t, buffer_ids_len)
+    )
+)
+
+TRACEPOINT_EVENT(
+    mir_server_input_latency,
+    frame_posted,
+    TP_ARGS(void const*, id),
+    TP_FIELDS(
+        ctf_integer_hex(uintptr_t, id, (uintptr_t)(id))
+    )
+)
+
+#endif /* MIR_LTTNG_INPUT_LATENCY_REPORT_TP_H_ */
+
+#include <lttng/tracepoint-event.h>
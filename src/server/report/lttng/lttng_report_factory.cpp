@@ -20,6 +20,7 @@
 
 #include "compositor_report.h"
 #include "display_report.h"
+#include "input_latency_report.h"
 #include "input_report.h"
 #include "scene_report.h"
 #include "shared_library_prober_report.h"
@@ -30,6 +31,11 @@ std::shared_ptr<mir::compositor::CompositorReport> mir::report::LttngReportFacto
     return std::make_shared<lttng::CompositorReport>();
 }
 
+std::shared_ptr<mir::compositor::InputLatencyReport> mir::report::LttngReportFactory::create_input_latency_report()
+{
+    return std::make_shared<lttng::InputLatencyReport>();
+}
+
 std::shared_ptr<mir::graphics::DisplayReport> mir::report::LttngReportFactory::create_display_report()
 {
     return std::make_shared<lttng::DisplayReport>();
@@ -3,6 +3,7 @@
 
 #include "compositor_report_tp.h"
 #include "input_report_tp.h"
+#include "input_latency_report_tp.h"
 #include "display_report_tp.h"
 #include "scene_report_tp.h"
 #include "shared_library_prober_report_tp.h"
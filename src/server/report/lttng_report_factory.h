@@ -29,6 +29,7 @@ class LttngReportFactory : public report::ReportFactory
 {
 public:
     std::shared_ptr<compositor::CompositorReport> create_compositor_report() override;
+    std::shared_ptr<compositor::InputLatencyReport> create_input_latency_report() override;
     std::shared_ptr<graphics::DisplayReport> create_display_report() override;
     std::shared_ptr<scene::SceneReport> create_scene_report() override;
 
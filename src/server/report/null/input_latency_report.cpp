@@ -0,0 +1,35 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "input_latency_report.h"
+
+namespace mrn = mir::report::null;
+
+void mrn::InputLatencyReport::buffer_committed(SurfaceId, mir::graphics::BufferID, std::chrono::nanoseconds)
+{
+}
+
+void mrn::InputLatencyReport::surface_destroyed(SurfaceId)
+{
+}
+
+void mrn::InputLatencyReport::renderables_in_frame(SubCompositorId, mir::graphics::RenderableList const&)
+{
+}
+
+void mrn::InputLatencyReport::frame_posted(SubCompositorId)
+{
+}
@@ -20,6 +20,7 @@
 
 #include "compositor_report.h"
 #include "display_report.h"
+#include "input_latency_report.h"
 #include "input_report.h"
 #include "seat_report.h"
 #include "shell_report.h"
@@ -31,6 +32,11 @@ std::shared_ptr<mir::compositor::CompositorReport> mir::report::NullReportFactor
     return std::make_shared<null::CompositorReport>();
 }
 
+std::shared_ptr<mir::compositor::InputLatencyReport> mir::report::NullReportFactory::create_input_latency_report()
+{
+    return std::make_shared<null::InputLatencyReport>();
+}
+
 std::shared_ptr<mir::graphics::DisplayReport> mir::report::NullReportFactory::create_display_report()
 {
     return std::make_shared<null::DisplayReport>();
@@ -66,6 +72,11 @@ std::shared_ptr<mir::compositor::CompositorReport> mir::report::null_compositor_
     return NullReportFactory{}.create_compositor_report();
 }
 
+std::shared_ptr<mir::compositor::InputLatencyReport> mir::report::null_input_latency_report()
+{
+    return NullReportFactory{}.create_input_latency_report();
+}
+
 std::shared_ptr<mir::SharedLibraryProberReport> mir::report::null_shared_library_prober_report()
 {
     return NullReportFactory{}.create_shared_library_prober_report();
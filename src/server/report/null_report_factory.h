@@ -29,6 +29,7 @@ class NullReportFactory : public mir::report::ReportFactory
 {
 public:
     std::shared_ptr<compositor::CompositorReport> create_compositor_report() override;
+    std::shared_ptr<compositor::InputLatencyReport> create_input_latency_report() override;
     std::shared_ptr<graphics::DisplayReport> create_display_report() override;
     std::shared_ptr<scene::SceneReport> create_scene_report() override;
     std::shared_ptr<input::InputReport> create_input_report() override;
@@ -38,6 +39,7 @@ public:
 };
 
 std::shared_ptr<compositor::CompositorReport> null_compositor_report();
+std::shared_ptr<compositor::InputLatencyReport> null_input_latency_report();
 std::shared_ptr<graphics::DisplayReport> null_display_report();
 std::shared_ptr<scene::SceneReport> null_scene_report();
 std::shared_ptr<input::InputReport> null_input_report();
@@ -27,6 +27,7 @@ class SharedLibraryProberReport;
 namespace compositor
 {
 class CompositorReport;
+class InputLatencyReport;
 }
 namespace graphics
 {
@@ -50,6 +51,7 @@ class ReportFactory
 public:
     virtual ~ReportFactory() = default;
     virtual std::shared_ptr<compositor::CompositorReport> create_compositor_report() = 0;
+    virtual std::shared_ptr<compositor::InputLatencyReport> create_input_latency_report() = 0;
     virtual std::shared_ptr<graphics::DisplayReport> create_display_report() = 0;
     virtual std::shared_ptr<scene::SceneReport> create_scene_report() = 0;
 
@@ -492,10 +492,22 @@ void ms::MediatingDisplayChanger::apply_config(
         if (configuration_has_new_outputs_enabled(*display->configuration(), *conf) ||
             !display->apply_if_configuration_preserves_display_buffers(*conf))
         {
-            ApplyNowAndRevertOnScopeExit comp{
-                [this] { compositor->stop(); },
-                [this] { compositor->start(); }};
-            display->configure(*conf);
+            // Where the display can, only the outputs that change stop being composited
+            auto const applied_incrementally = display->apply_keeping_unchanged_sync_groups(
+                *conf,
+                [this](mg::DisplaySyncGroup& group) { compositor->stop_compositing_to(group); });
+
+            if (applied_incrementally)
+            {
+                compositor->start_compositing_to_new_groups();
+            }
+            else
+            {
+                ApplyNowAndRevertOnScopeExit comp{
+                    [this] { compositor->stop(); },
+                    [this] { compositor->start(); }};
+                display->configure(*conf);
+            }
         }
 
         observer->configuration_applied(conf);
@@ -59,6 +59,7 @@ public:
    void surface_removed(std::shared_ptr<Surface> const& surface) override;
    void surfaces_reordered(SurfaceSet const& affected_surfaces) override;
    void scene_changed() override;
+   void scene_damaged(geometry::Rectangle const& damage) override;
    void surface_exists(std::shared_ptr<Surface> const& surface) override;
    void end_observation() override;
 
@@ -108,6 +109,7 @@ public:
     void remove_input_visualization(std::weak_ptr<graphics::Renderable> const& overlay) override;
 
     void emit_scene_changed() override;
+    void emit_scene_damaged(geometry::Rectangle const& damage) override;
 
 private:
     SurfaceStack(const SurfaceStack&) = delete;
@@ -121,7 +121,8 @@ TEST_F(DefaultDisplayBufferCompositor, render)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        mr::null_compositor_report());
+        mr::null_compositor_report(),
+        mr::null_input_latency_report());
     compositor.composite(make_scene_elements({}));
 }
 
@@ -151,7 +152,8 @@ TEST_F(DefaultDisplayBufferCompositor, optimization_skips_composition)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        report);
+        report,
+        mr::null_input_latency_report());
     compositor.composite(make_scene_elements({}));
 }
 
@@ -179,7 +181,8 @@ TEST_F(DefaultDisplayBufferCompositor, rendering_reports_everything)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        report);
+        report,
+        mr::null_input_latency_report());
     compositor.composite(make_scene_elements({}));
 }
 
@@ -201,7 +204,8 @@ TEST_F(DefaultDisplayBufferCompositor, calls_renderer_in_sequence)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        mr::null_compositor_report());
+        mr::null_compositor_report(),
+        mr::null_input_latency_report());
 
     compositor.composite(make_scene_elements({
         big,
@@ -238,7 +242,8 @@ TEST_F(DefaultDisplayBufferCompositor, rotates_viewport)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        mr::null_compositor_report());
+        mr::null_compositor_report(),
+        mr::null_input_latency_report());
 
     compositor.composite(make_scene_elements({
         big,
@@ -288,7 +293,8 @@ TEST_F(DefaultDisplayBufferCompositor, optimization_toggles_seamlessly)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        mr::null_compositor_report());
+        mr::null_compositor_report(),
+        mr::null_input_latency_report());
 
     compositor.composite(make_scene_elements({}));
     compositor.composite(make_scene_elements({}));
@@ -319,7 +325,8 @@ TEST_F(DefaultDisplayBufferCompositor, occluded_surfaces_are_not_rendered)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        mr::null_compositor_report());
+        mr::null_compositor_report(),
+        mr::null_input_latency_report());
     compositor.composite(make_scene_elements({
         window0, //not occluded
         window1, //occluded
@@ -359,7 +366,8 @@ TEST_F(DefaultDisplayBufferCompositor, marks_rendered_scene_elements)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        mr::null_compositor_report());
+        mr::null_compositor_report(),
+        mr::null_input_latency_report());
 
     compositor.composite({element0_rendered, element1_rendered});
 }
@@ -382,7 +390,8 @@ TEST_F(DefaultDisplayBufferCompositor, marks_occluded_scene_elements)
     mc::DefaultDisplayBufferCompositor compositor(
         display_buffer,
         mt::fake_shared(mock_renderer),
-        mr::null_compositor_report());
+        mr::null_compositor_report(),
+        mr::null_input_latency_report());
 
     compositor.composite({element0_occluded, element1_rendered, element2_occluded});
 }
@@ -22,6 +22,7 @@
 #include "mir/test/fake_shared.h"
 #include "src/server/compositor/stream.h"
 #include "mir/scene/null_surface_observer.h"
+#include "mir/graphics/prepared_in_background.h"
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
@@ -35,6 +36,36 @@ namespace mg = mir::graphics;
 namespace geom = mir::geometry;
 namespace
 {
+/// A buffer that is only ready to draw once the test says it is prepared
+struct PreparingBuffer : mtd::StubBuffer, mg::PreparedInBackground
+{
+    using mtd::StubBuffer::StubBuffer;
+
+    void when_ready(std::function<void()>&& on_ready) override
+    {
+        if (prepared)
+        {
+            on_ready();
+        }
+        else
+        {
+            this->on_ready = std::move(on_ready);
+        }
+    }
+
+    void prepare()
+    {
+        prepared = true;
+        if (on_ready)
+        {
+            on_ready();
+        }
+    }
+
+    bool prepared{false};
+    std::function<void()> on_ready;
+};
+
 struct Stream : Test
 {
     Stream() :
@@ -241,3 +272,112 @@ TEST_F(Stream, stream_remembers_scale_when_buffer_added)
     stream.submit_buffer(buffers[0]);
     ASSERT_THAT(stream.stream_size(), Eq(initial_size / 2));
 }
+
+TEST_F(Stream, buffer_being_prepared_is_not_given_to_compositor)
+{
+    auto const preparing = std::make_shared<PreparingBuffer>(initial_size);
+
+    stream.submit_buffer(buffers[0]);
+    stream.submit_buffer(preparing);
+
+    EXPECT_THAT(stream.lock_compositor_buffer(this), Eq(buffers[0]));
+    EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(0));
+
+    preparing->prepare();
+
+    EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(1));
+    EXPECT_THAT(stream.lock_compositor_buffer(this), Eq(preparing));
+}
+
+TEST_F(Stream, prepared_buffer_is_given_to_compositor_immediately)
+{
+    auto const prepared = std::make_shared<PreparingBuffer>(initial_size);
+    prepared->prepare();
+
+    stream.submit_buffer(prepared);
+
+    EXPECT_THAT(stream.lock_compositor_buffer(this), Eq(prepared));
+}
+
+TEST_F(Stream, frame_is_posted_once_buffer_is_prepared)
+{
+    auto const preparing = std::make_shared<PreparingBuffer>(initial_size);
+    int frame_count{0};
+    stream.set_frame_posted_callback([&frame_count](auto) { ++frame_count; });
+
+    stream.submit_buffer(preparing);
+    EXPECT_THAT(frame_count, Eq(0));
+    EXPECT_FALSE(stream.has_submitted_buffer());
+
+    preparing->prepare();
+    EXPECT_THAT(frame_count, Eq(1));
+    EXPECT_TRUE(stream.has_submitted_buffer());
+}
+
+TEST_F(Stream, reports_size_of_buffer_being_prepared)
+{
+    geom::Size const new_size{66, 4};
+
+    stream.submit_buffer(std::make_shared<PreparingBuffer>(new_size));
+
+    EXPECT_THAT(stream.stream_size(), Eq(new_size));
+}
+
+TEST_F(Stream, queued_buffers_stay_in_order_while_being_prepared)
+{
+    auto const first = std::make_shared<PreparingBuffer>(initial_size);
+    auto const second = std::make_shared<PreparingBuffer>(initial_size);
+
+    stream.submit_buffer(first);
+    stream.submit_buffer(second);
+    stream.submit_buffer(buffers[0]);
+
+    second->prepare();
+    EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(0));
+
+    first->prepare();
+    EXPECT_THAT(stream.lock_compositor_buffer(this), Eq(first));
+    EXPECT_THAT(stream.lock_compositor_buffer(this), Eq(second));
+    EXPECT_THAT(stream.lock_compositor_buffer(this), Eq(buffers[0]));
+}
+
+TEST_F(Stream, superseded_buffer_being_prepared_is_released_when_dropping)
+{
+    stream.allow_framedropping(true);
+    auto const superseded = std::make_shared<PreparingBuffer>(initial_size);
+    auto const latest = std::make_shared<PreparingBuffer>(initial_size);
+
+    stream.submit_buffer(superseded);
+    stream.submit_buffer(latest);
+
+    EXPECT_TRUE(superseded.unique());
+
+    superseded->prepare();
+    EXPECT_THAT(stream.buffers_ready_for_compositor(this), Eq(0));
+
+    latest->prepare();
+    EXPECT_THAT(stream.lock_compositor_buffer(this), Eq(latest));
+}
+
+TEST_F(Stream, ready_buffer_supersedes_buffer_being_prepared_when_dropping)
+{
+    stream.allow_framedropping(true);
+    auto const superseded = std::make_shared<PreparingBuffer>(initial_size);
+
+    stream.submit_buffer(superseded);
+    stream.submit_buffer(buffers[0]);
+
+    EXPECT_TRUE(superseded.unique());
+    EXPECT_THAT(stream.lock_compositor_buffer(this), Eq(buffers[0]));
+}
+
+TEST_F(Stream, buffer_prepared_after_stream_is_destroyed_is_ignored)
+{
+    auto const preparing = std::make_shared<PreparingBuffer>(initial_size);
+    {
+        mc::Stream transient_stream{initial_size, construction_format};
+        transient_stream.submit_buffer(preparing);
+    }
+
+    preparing->prepare();
+}
@@ -490,3 +490,100 @@ TEST(MultiplexingDispatchableTest, automatic_removals_are_threadsafe)
     
     dispatchee->trigger();
 }
+
+TEST(MultiplexingDispatchableTest, dispatches_all_ready_dispatchees_in_one_call)
+{
+    int const dispatchee_count{5};
+    int dispatched{0};
+
+    md::MultiplexingDispatchable dispatcher;
+    std::vector<std::shared_ptr<mt::TestDispatchable>> dispatchees;
+    for (int i = 0; i != dispatchee_count; ++i)
+    {
+        dispatchees.push_back(std::make_shared<mt::TestDispatchable>([&dispatched]() { ++dispatched; }));
+        dispatcher.add_watch(dispatchees.back());
+        dispatchees.back()->trigger();
+    }
+
+    ASSERT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+    dispatcher.dispatch(md::FdEvent::readable);
+
+    EXPECT_THAT(dispatched, testing::Eq(dispatchee_count));
+    EXPECT_FALSE(mt::fd_is_readable(dispatcher.watch_fd()));
+}
+
+TEST(MultiplexingDispatchableTest, rearms_every_dispatchee_in_a_batch)
+{
+    int dispatched{0};
+    auto const dispatchee_a = std::make_shared<mt::TestDispatchable>([&dispatched]() { ++dispatched; });
+    auto const dispatchee_b = std::make_shared<mt::TestDispatchable>([&dispatched]() { ++dispatched; });
+    md::MultiplexingDispatchable dispatcher{dispatchee_a, dispatchee_b};
+
+    dispatchee_a->trigger();
+    dispatchee_a->trigger();
+    dispatchee_b->trigger();
+    dispatchee_b->trigger();
+
+    dispatcher.dispatch(md::FdEvent::readable);
+    EXPECT_THAT(dispatched, testing::Eq(2));
+
+    ASSERT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+    dispatcher.dispatch(md::FdEvent::readable);
+    EXPECT_THAT(dispatched, testing::Eq(4));
+}
+
+TEST(MultiplexingDispatchableTest, rearms_rest_of_batch_when_a_dispatchee_throws)
+{
+    bool dispatched{false};
+    auto const throwing = std::make_shared<mt::TestDispatchable>(
+        [](md::FdEvents) -> bool { throw std::runtime_error{"Dispatch failed"}; });
+    auto const dispatchee = std::make_shared<mt::TestDispatchable>([&dispatched]() { dispatched = true; });
+    md::MultiplexingDispatchable dispatcher{throwing, dispatchee};
+
+    throwing->trigger();
+    dispatchee->trigger();
+
+    while (mt::fd_is_readable(dispatcher.watch_fd()) && !dispatched)
+    {
+        try
+        {
+            dispatcher.dispatch(md::FdEvent::readable);
+        }
+        catch (std::runtime_error const&)
+        {
+        }
+    }
+
+    EXPECT_TRUE(dispatched);
+}
+
+TEST(MultiplexingDispatchableTest, dispatchee_removed_by_another_in_the_same_batch_is_not_dispatched)
+{
+    int dispatched{0};
+    md::MultiplexingDispatchable dispatcher;
+    std::shared_ptr<mt::TestDispatchable> dispatchee_a, dispatchee_b;
+
+    // Whichever is dispatched first removes the other before it gets its turn
+    dispatchee_a = std::make_shared<mt::TestDispatchable>(
+        [&]()
+        {
+            ++dispatched;
+            dispatcher.remove_watch(dispatchee_b);
+        });
+    dispatchee_b = std::make_shared<mt::TestDispatchable>(
+        [&]()
+        {
+            ++dispatched;
+            dispatcher.remove_watch(dispatchee_a);
+        });
+    dispatcher.add_watch(dispatchee_a);
+    dispatcher.add_watch(dispatchee_b);
+
+    dispatchee_a->trigger();
+    dispatchee_b->trigger();
+
+    ASSERT_TRUE(mt::fd_is_readable(dispatcher.watch_fd()));
+    dispatcher.dispatch(md::FdEvent::readable);
+
+    EXPECT_THAT(dispatched, testing::Eq(1));
+}
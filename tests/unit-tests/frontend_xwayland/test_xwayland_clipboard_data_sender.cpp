@@ -0,0 +1,208 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "src/server/frontend_xwayland/xwayland_clipboard_data_sender.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+namespace mf = mir::frontend;
+namespace md = mir::dispatch;
+
+using namespace testing;
+
+namespace
+{
+/// A reply like the X server sends for a property holding the given data
+auto property_reply(std::string const& data) -> mir::UniqueCPtr<xcb_get_property_reply_t>
+{
+    auto const reply = static_cast<xcb_get_property_reply_t*>(calloc(1, sizeof(xcb_get_property_reply_t) + data.size()));
+    reply->format = 8;
+    reply->value_len = data.size();
+    memcpy(reply + 1, data.data(), data.size());
+    return mir::make_unique_cptr(reply);
+}
+
+struct Pipe
+{
+    Pipe()
+    {
+        int fds[2];
+        if (pipe(fds) != 0)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create pipe"};
+        }
+        read_end = mir::Fd{fds[0]};
+        write_end = mir::Fd{fds[1]};
+        fcntl(read_end, F_SETFL, O_NONBLOCK);
+    }
+
+    mir::Fd read_end;
+    mir::Fd write_end;
+};
+
+struct XWaylandClipboardDataSenderTest : Test
+{
+    auto read_all() -> std::string
+    {
+        std::string result;
+        char buffer[4096];
+        ssize_t len;
+        while ((len = read(read_end, buffer, sizeof(buffer))) > 0)
+        {
+            result.append(buffer, len);
+        }
+        return result;
+    }
+
+    Pipe const pipe;
+    mir::Fd const read_end{pipe.read_end};
+    mir::Fd const write_end{pipe.write_end};
+    size_t const pipe_capacity{static_cast<size_t>(fcntl(write_end, F_GETPIPE_SZ))};
+    std::vector<bool> done_calls;
+    mf::XWaylandClipboardDataSender sender{
+        write_end,
+        [this](mf::XWaylandClipboardDataSender const*, bool failed) { done_calls.push_back(failed); }};
+};
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, makes_receiver_fd_non_blocking)
+{
+    EXPECT_TRUE(fcntl(write_end, F_GETFL) & O_NONBLOCK);
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, watches_receiver_fd_for_writability)
+{
+    EXPECT_THAT(int{sender.watch_fd()}, Eq(int{write_end}));
+    EXPECT_THAT(sender.relevant_events(), Eq(md::FdEvent::writable));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, needs_adding_to_dispatcher_only_when_idle)
+{
+    EXPECT_TRUE(sender.add_chunk(property_reply("first")));
+    EXPECT_FALSE(sender.add_chunk(property_reply("second")));
+
+    EXPECT_FALSE(sender.dispatch(md::FdEvent::writable));
+
+    EXPECT_TRUE(sender.add_chunk(property_reply("third")));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, writes_chunk_and_reports_done)
+{
+    sender.add_chunk(property_reply("Hello, clipboard"));
+
+    EXPECT_FALSE(sender.dispatch(md::FdEvent::writable));
+
+    EXPECT_THAT(read_all(), Eq("Hello, clipboard"));
+    EXPECT_THAT(done_calls, ElementsAre(false));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, writes_queued_chunks_in_order)
+{
+    sender.add_chunk(property_reply("one "));
+    sender.add_chunk(property_reply("two "));
+    sender.add_chunk(property_reply("three"));
+
+    sender.dispatch(md::FdEvent::writable);
+
+    EXPECT_THAT(read_all(), Eq("one two three"));
+    EXPECT_THAT(done_calls, ElementsAre(false));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, does_not_block_on_full_receiver)
+{
+    std::string const data(3 * pipe_capacity, 'x');
+    sender.add_chunk(property_reply(data));
+
+    // Would block if the fd were blocking, as nothing reads the pipe yet
+    EXPECT_TRUE(sender.dispatch(md::FdEvent::writable));
+    EXPECT_THAT(done_calls, IsEmpty());
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, is_only_done_once_receiver_has_taken_everything)
+{
+    std::string const data(3 * pipe_capacity + 7, 'x');
+    sender.add_chunk(property_reply(data));
+
+    std::string received;
+    int dispatches{0};
+    while (sender.dispatch(md::FdEvent::writable))
+    {
+        EXPECT_THAT(done_calls, IsEmpty());
+        received += read_all();
+        ASSERT_THAT(++dispatches, Lt(100));
+    }
+    received += read_all();
+
+    EXPECT_THAT(received, Eq(data));
+    EXPECT_THAT(done_calls, ElementsAre(false));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, reports_done_after_each_incremental_chunk)
+{
+    // Each INCR chunk is only requested from the X11 client once the last one is done
+    sender.add_chunk(property_reply("chunk 1, "));
+    sender.dispatch(md::FdEvent::writable);
+    EXPECT_THAT(done_calls, ElementsAre(false));
+
+    sender.add_chunk(property_reply("chunk 2"));
+    sender.dispatch(md::FdEvent::writable);
+    EXPECT_THAT(done_calls, ElementsAre(false, false));
+
+    EXPECT_THAT(read_all(), Eq("chunk 1, chunk 2"));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, empty_chunk_is_done_straight_away)
+{
+    sender.add_chunk(property_reply(""));
+
+    EXPECT_FALSE(sender.dispatch(md::FdEvent::writable));
+    EXPECT_THAT(done_calls, ElementsAre(false));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, reports_failure_when_receiver_closes)
+{
+    sender.add_chunk(property_reply("never read"));
+
+    EXPECT_FALSE(sender.dispatch(md::FdEvent::remote_closed));
+    EXPECT_THAT(done_calls, ElementsAre(true));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, reports_failure_on_fd_error)
+{
+    sender.add_chunk(property_reply("never read"));
+
+    EXPECT_FALSE(sender.dispatch(md::FdEvent::error));
+    EXPECT_THAT(done_calls, ElementsAre(true));
+}
+
+TEST_F(XWaylandClipboardDataSenderTest, drops_unwritten_data_on_failure)
+{
+    std::string const data(3 * pipe_capacity, 'x');
+    sender.add_chunk(property_reply(data));
+    sender.dispatch(md::FdEvent::writable);
+    read_all();
+
+    sender.dispatch(md::FdEvent::error);
+
+    // Nothing is left queued, so the next chunk needs the sender adding to the dispatcher again
+    EXPECT_TRUE(sender.add_chunk(property_reply("more")));
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "src/server/frontend_xwayland/xwayland_idle_timeout.h"
+#include "mir/test/doubles/fake_alarm_factory.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+auto const timeout = 30s;
+
+struct XWaylandIdleTimeoutTest : Test
+{
+    mtd::FakeAlarmFactory alarm_factory;
+    int times_idle_for_timeout{0};
+    mf::XWaylandIdleTimeout idle_timeout{alarm_factory, timeout, [this]() { ++times_idle_for_timeout; }};
+
+    // FakeAlarms fire once the clock is past their deadline
+    void advance_past_timeout()
+    {
+        alarm_factory.advance_by(timeout + 1ms);
+    }
+};
+}
+
+TEST_F(XWaylandIdleTimeoutTest, does_not_time_out_before_xwayland_is_started)
+{
+    advance_past_timeout();
+
+    EXPECT_THAT(times_idle_for_timeout, Eq(0));
+    EXPECT_FALSE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, times_out_if_started_without_client_windows)
+{
+    idle_timeout.started(false);
+
+    alarm_factory.advance_by(timeout - 1s);
+    EXPECT_THAT(times_idle_for_timeout, Eq(0));
+    EXPECT_FALSE(idle_timeout.timed_out());
+
+    alarm_factory.advance_by(1s + 1ms);
+    EXPECT_THAT(times_idle_for_timeout, Eq(1));
+    EXPECT_TRUE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, does_not_time_out_while_there_are_client_windows)
+{
+    idle_timeout.started(true);
+    advance_past_timeout();
+
+    idle_timeout.started(false);
+    idle_timeout.idle_changed(false);
+    advance_past_timeout();
+
+    EXPECT_THAT(times_idle_for_timeout, Eq(0));
+    EXPECT_FALSE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, times_out_after_last_client_window_is_destroyed)
+{
+    idle_timeout.started(true);
+    alarm_factory.advance_by(2 * timeout);
+
+    idle_timeout.idle_changed(true);
+    advance_past_timeout();
+
+    EXPECT_THAT(times_idle_for_timeout, Eq(1));
+    EXPECT_TRUE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, the_timeout_restarts_each_time_xwayland_goes_idle)
+{
+    idle_timeout.started(false);
+    alarm_factory.advance_by(timeout - 1s);
+    idle_timeout.idle_changed(false);
+    idle_timeout.idle_changed(true);
+
+    alarm_factory.advance_by(timeout - 1s);
+    EXPECT_THAT(times_idle_for_timeout, Eq(0));
+
+    alarm_factory.advance_by(1s + 1ms);
+    EXPECT_THAT(times_idle_for_timeout, Eq(1));
+}
+
+TEST_F(XWaylandIdleTimeoutTest, repeated_idle_notifications_do_not_restart_the_timeout)
+{
+    idle_timeout.started(false);
+    alarm_factory.advance_by(timeout - 1s);
+    idle_timeout.idle_changed(true);
+
+    alarm_factory.advance_by(1s + 1ms);
+    EXPECT_THAT(times_idle_for_timeout, Eq(1));
+}
+
+TEST_F(XWaylandIdleTimeoutTest, is_not_timed_out_if_used_before_the_timeout_is_acted_on)
+{
+    idle_timeout.started(false);
+    advance_past_timeout();
+    ASSERT_THAT(times_idle_for_timeout, Eq(1));
+
+    // A window is created before the connector gets round to stopping XWayland
+    idle_timeout.idle_changed(false);
+
+    EXPECT_FALSE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, is_not_timed_out_if_used_and_idle_again_before_the_timeout_is_acted_on)
+{
+    idle_timeout.started(false);
+    advance_past_timeout();
+    ASSERT_THAT(times_idle_for_timeout, Eq(1));
+
+    idle_timeout.idle_changed(false);
+    idle_timeout.idle_changed(true);
+
+    EXPECT_FALSE(idle_timeout.timed_out());
+
+    advance_past_timeout();
+    EXPECT_THAT(times_idle_for_timeout, Eq(2));
+    EXPECT_TRUE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, is_not_timed_out_once_stopped)
+{
+    idle_timeout.started(false);
+    advance_past_timeout();
+
+    idle_timeout.stopped();
+
+    EXPECT_FALSE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, stopping_cancels_the_timeout)
+{
+    idle_timeout.started(false);
+    idle_timeout.stopped();
+    advance_past_timeout();
+
+    EXPECT_THAT(times_idle_for_timeout, Eq(0));
+}
+
+TEST_F(XWaylandIdleTimeoutTest, is_not_timed_out_if_respawned_before_the_timeout_is_acted_on)
+{
+    idle_timeout.started(false);
+    advance_past_timeout();
+    ASSERT_THAT(times_idle_for_timeout, Eq(1));
+
+    // XWayland is stopped (say by an error) and a new client spawns it again
+    idle_timeout.stopped();
+    idle_timeout.started(false);
+
+    EXPECT_FALSE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, respawned_xwayland_times_out_again)
+{
+    idle_timeout.started(false);
+    advance_past_timeout();
+    idle_timeout.stopped();
+
+    idle_timeout.started(false);
+    advance_past_timeout();
+
+    EXPECT_THAT(times_idle_for_timeout, Eq(2));
+    EXPECT_TRUE(idle_timeout.timed_out());
+}
+
+TEST_F(XWaylandIdleTimeoutTest, zero_timeout_never_times_out)
+{
+    mf::XWaylandIdleTimeout never{alarm_factory, 0s, [this]() { ++times_idle_for_timeout; }};
+
+    never.started(false);
+    alarm_factory.advance_by(24h);
+
+    EXPECT_THAT(times_idle_for_timeout, Eq(0));
+    EXPECT_FALSE(never.timed_out());
+}
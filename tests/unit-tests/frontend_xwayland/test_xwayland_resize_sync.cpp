@@ -0,0 +1,192 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_xwayland/xwayland_resize_sync.h"
+#include "mir/test/doubles/fake_alarm_factory.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct XWaylandResizeSyncTest : Test
+{
+    XWaylandResizeSyncTest()
+        : sync{
+              alarm_factory,
+              [this](auto const& held_back, bool timed_out)
+              {
+                  drawn(held_back, timed_out);
+              }}
+    {
+    }
+
+    MOCK_METHOD2(drawn, void(std::optional<geom::Rectangle> const&, bool));
+
+    geom::Rectangle const first{{0, 0}, {640, 480}};
+    geom::Rectangle const second{{0, 0}, {650, 490}};
+    geom::Rectangle const third{{0, 0}, {660, 500}};
+
+    mtd::FakeAlarmFactory alarm_factory;
+    mf::XWaylandResizeSync sync;
+};
+}
+
+TEST_F(XWaylandResizeSyncTest, without_sync_request_geometry_is_sent_straight_away)
+{
+    auto const configure = sync.configure(first, false, true);
+
+    EXPECT_FALSE(configure.held_back);
+    EXPECT_FALSE(configure.sync_request);
+    EXPECT_FALSE(sync.awaiting_frame());
+}
+
+TEST_F(XWaylandResizeSyncTest, size_change_is_sent_with_sync_request)
+{
+    auto const configure = sync.configure(first, true, true);
+
+    EXPECT_FALSE(configure.held_back);
+    EXPECT_THAT(configure.sync_request, Eq(1u));
+    EXPECT_THAT(sync.last_request(), Eq(1u));
+    EXPECT_TRUE(sync.awaiting_frame());
+}
+
+TEST_F(XWaylandResizeSyncTest, move_is_sent_without_sync_request)
+{
+    auto const configure = sync.configure(first, true, false);
+
+    EXPECT_FALSE(configure.held_back);
+    EXPECT_FALSE(configure.sync_request);
+    EXPECT_FALSE(sync.awaiting_frame());
+}
+
+TEST_F(XWaylandResizeSyncTest, geometry_is_held_back_while_client_draws)
+{
+    sync.configure(first, true, true);
+
+    EXPECT_TRUE(sync.configure(second, true, true).held_back);
+    EXPECT_TRUE(sync.configure(third, true, true).held_back);
+    EXPECT_THAT(sync.held_back(), Eq(third));
+}
+
+TEST_F(XWaylandResizeSyncTest, latest_held_back_geometry_is_given_when_client_has_drawn)
+{
+    sync.configure(first, true, true);
+    sync.configure(second, true, true);
+    sync.configure(third, true, true);
+
+    EXPECT_CALL(*this, drawn(Eq(third), false));
+
+    sync.counter_reached(1);
+
+    EXPECT_FALSE(sync.held_back());
+    EXPECT_FALSE(sync.awaiting_frame());
+}
+
+TEST_F(XWaylandResizeSyncTest, held_back_geometry_is_given_when_client_does_not_answer_in_time)
+{
+    sync.configure(first, true, true);
+    sync.configure(second, true, true);
+
+    EXPECT_CALL(*this, drawn(_, _)).Times(0);
+    alarm_factory.advance_by(mf::XWaylandResizeSync::timeout);
+    Mock::VerifyAndClearExpectations(this);
+
+    EXPECT_CALL(*this, drawn(Eq(second), true));
+    alarm_factory.advance_by(1ms);
+}
+
+TEST_F(XWaylandResizeSyncTest, client_is_not_waited_on_after_it_times_out)
+{
+    EXPECT_CALL(*this, drawn(_, _)).Times(AnyNumber());
+
+    sync.configure(first, true, true);
+    alarm_factory.advance_by(mf::XWaylandResizeSync::timeout + 1ms);
+
+    auto const configure = sync.configure(second, true, true);
+
+    EXPECT_FALSE(configure.held_back);
+    EXPECT_THAT(configure.sync_request, Eq(2u));
+    EXPECT_FALSE(sync.awaiting_frame());
+    EXPECT_FALSE(sync.configure(third, true, true).held_back);
+}
+
+TEST_F(XWaylandResizeSyncTest, client_is_waited_on_again_once_it_answers)
+{
+    EXPECT_CALL(*this, drawn(_, _)).Times(AnyNumber());
+
+    sync.configure(first, true, true);
+    alarm_factory.advance_by(mf::XWaylandResizeSync::timeout + 1ms);
+    sync.configure(second, true, true);
+    sync.counter_reached(2);
+
+    sync.configure(first, true, true);
+
+    EXPECT_TRUE(sync.awaiting_frame());
+    EXPECT_TRUE(sync.configure(third, true, true).held_back);
+}
+
+TEST_F(XWaylandResizeSyncTest, answer_to_superseded_request_is_ignored)
+{
+    EXPECT_CALL(*this, drawn(_, _)).Times(AnyNumber());
+
+    sync.configure(first, true, true);
+    alarm_factory.advance_by(mf::XWaylandResizeSync::timeout + 1ms);
+    sync.configure(second, true, true);
+    Mock::VerifyAndClearExpectations(this);
+
+    EXPECT_CALL(*this, drawn(_, _)).Times(0);
+    sync.counter_reached(1);
+}
+
+TEST_F(XWaylandResizeSyncTest, counter_ahead_of_requests_moves_later_requests_past_it)
+{
+    EXPECT_CALL(*this, drawn(_, _)).Times(AnyNumber());
+
+    sync.configure(first, true, true);
+    sync.counter_reached(41);
+
+    EXPECT_THAT(sync.configure(second, true, true).sync_request, Eq(42u));
+}
+
+TEST_F(XWaylandResizeSyncTest, answer_before_timeout_stops_alarm_having_effect)
+{
+    EXPECT_CALL(*this, drawn(_, false));
+    EXPECT_CALL(*this, drawn(_, true)).Times(0);
+
+    sync.configure(first, true, true);
+    sync.counter_reached(1);
+    alarm_factory.advance_by(mf::XWaylandResizeSync::timeout * 2);
+}
+
+TEST_F(XWaylandResizeSyncTest, reset_stops_waiting_and_returns_held_back_geometry)
+{
+    sync.configure(first, true, true);
+    sync.configure(second, true, true);
+
+    EXPECT_CALL(*this, drawn(_, _)).Times(0);
+
+    EXPECT_THAT(sync.reset(), Eq(second));
+    EXPECT_FALSE(sync.awaiting_frame());
+    EXPECT_FALSE(sync.configure(third, true, true).held_back);
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/async_import.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <deque>
+#include <optional>
+
+namespace mg = mir::graphics;
+namespace mw = mir::wayland;
+using namespace testing;
+
+namespace
+{
+/// Queues work until the test chooses to run it
+class QueuedExecutor : public mir::Executor
+{
+public:
+    void spawn(std::function<void()>&& work) override
+    {
+        queue.push_back(std::move(work));
+    }
+
+    void run_queued()
+    {
+        while (!queue.empty())
+        {
+            auto const work = std::move(queue.front());
+            queue.pop_front();
+            work();
+        }
+    }
+
+    auto pending() const -> size_t
+    {
+        return queue.size();
+    }
+
+private:
+    std::deque<std::function<void()>> queue;
+};
+
+struct Params : mw::LifetimeTracker
+{
+    MOCK_METHOD1(import_finished, void(bool));
+};
+
+struct AsyncImport : Test
+{
+    QueuedExecutor egl_delegate;
+    std::shared_ptr<QueuedExecutor> const wayland_executor{std::make_shared<QueuedExecutor>()};
+    std::optional<NiceMock<Params>> params{std::in_place};
+
+    void import_with_result(bool result)
+    {
+        mg::async_import<Params>(
+            egl_delegate,
+            wayland_executor,
+            mw::make_weak<Params>(&params.value()),
+            [result]() { return result; },
+            [](Params& params, bool imported) { params.import_finished(imported); });
+    }
+};
+}
+
+TEST_F(AsyncImport, import_runs_on_egl_delegate)
+{
+    bool imported{false};
+    mg::async_import<Params>(
+        egl_delegate,
+        wayland_executor,
+        mw::make_weak<Params>(&params.value()),
+        [&]() { return imported = true; },
+        [](Params&, bool) {});
+
+    EXPECT_FALSE(imported);
+    egl_delegate.run_queued();
+    EXPECT_TRUE(imported);
+}
+
+TEST_F(AsyncImport, result_is_reported_on_wayland_thread)
+{
+    EXPECT_CALL(*params, import_finished(_)).Times(0);
+    import_with_result(true);
+    egl_delegate.run_queued();
+    Mock::VerifyAndClearExpectations(&*params);
+
+    EXPECT_CALL(*params, import_finished(true));
+    ASSERT_THAT(wayland_executor->pending(), Eq(1u));
+    wayland_executor->run_queued();
+}
+
+TEST_F(AsyncImport, failure_is_reported)
+{
+    EXPECT_CALL(*params, import_finished(false));
+
+    import_with_result(false);
+    egl_delegate.run_queued();
+    wayland_executor->run_queued();
+}
+
+TEST_F(AsyncImport, nothing_is_reported_if_params_destroyed_before_import)
+{
+    mg::async_import<Params>(
+        egl_delegate,
+        wayland_executor,
+        mw::make_weak<Params>(&params.value()),
+        []() { return true; },
+        [](Params&, bool) { FAIL() << "Result reported to destroyed params"; });
+    params.reset();
+
+    egl_delegate.run_queued();
+    wayland_executor->run_queued();
+}
+
+TEST_F(AsyncImport, nothing_is_reported_if_params_destroyed_during_import)
+{
+    bool params_destroyed_before_report{false};
+    mg::async_import<Params>(
+        egl_delegate,
+        wayland_executor,
+        mw::make_weak<Params>(&params.value()),
+        [&]()
+        {
+            // The client destroys the params while the driver is busy
+            wayland_executor->spawn([&]() { params.reset(); params_destroyed_before_report = true; });
+            return true;
+        },
+        [](Params&, bool) { FAIL() << "Result reported to destroyed params"; });
+
+    egl_delegate.run_queued();
+    wayland_executor->run_queued();
+
+    EXPECT_TRUE(params_destroyed_before_report);
+}
@@ -0,0 +1,173 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/graphics/background_gl_work.h"
+
+#include "mir/test/doubles/mock_gl.h"
+#include "mir/test/signal.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <stdexcept>
+#include <thread>
+
+namespace mg = mir::graphics;
+namespace mt = mir::test;
+namespace mtd = mir::test::doubles;
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct BackgroundGLWork : Test
+{
+    NiceMock<mtd::MockGL> mock_gl;
+    mg::BackgroundGLWork background_work;
+    int runs{0};
+    std::function<void()> const work{[this]() { ++runs; }};
+};
+}
+
+TEST_F(BackgroundGLWork, ensure_done_runs_work_that_has_not_started)
+{
+    background_work.ensure_done(work);
+
+    EXPECT_THAT(runs, Eq(1));
+}
+
+TEST_F(BackgroundGLWork, work_runs_only_once)
+{
+    background_work.run_in_background(work);
+    background_work.ensure_done(work);
+    background_work.run_in_background(work);
+    background_work.ensure_done(work);
+
+    EXPECT_THAT(runs, Eq(1));
+}
+
+TEST_F(BackgroundGLWork, background_work_is_finished_before_run_in_background_returns)
+{
+    InSequence seq;
+    EXPECT_CALL(mock_gl, glGenTextures(_, _));
+    EXPECT_CALL(mock_gl, glFinish());
+
+    background_work.run_in_background(
+        []()
+        {
+            GLuint tex;
+            glGenTextures(1, &tex);
+        });
+}
+
+TEST_F(BackgroundGLWork, ensure_done_waits_for_work_in_progress)
+{
+    mt::Signal work_started;
+    mt::Signal release_work;
+
+    std::thread background{
+        [&]()
+        {
+            background_work.run_in_background(
+                [&]()
+                {
+                    work_started.raise();
+                    release_work.wait_for(60s);
+                    ++runs;
+                });
+        }};
+
+    ASSERT_TRUE(work_started.wait_for(60s));
+
+    std::thread releaser{
+        [&]()
+        {
+            std::this_thread::sleep_for(10ms);
+            release_work.raise();
+        }};
+
+    background_work.ensure_done(work);
+    EXPECT_THAT(runs, Eq(1));
+
+    releaser.join();
+    background.join();
+}
+
+TEST_F(BackgroundGLWork, failed_background_work_is_left_for_ensure_done)
+{
+    EXPECT_THROW(
+        background_work.run_in_background([]() { throw std::runtime_error{"Upload failed"}; }),
+        std::runtime_error);
+
+    background_work.ensure_done(work);
+
+    EXPECT_THAT(runs, Eq(1));
+}
+
+TEST_F(BackgroundGLWork, failed_inline_work_is_retried)
+{
+    EXPECT_THROW(
+        background_work.ensure_done([]() { throw std::runtime_error{"Upload failed"}; }),
+        std::runtime_error);
+
+    background_work.ensure_done(work);
+
+    EXPECT_THAT(runs, Eq(1));
+}
+
+TEST_F(BackgroundGLWork, when_done_waits_for_background_work)
+{
+    bool done{false};
+    background_work.when_done([&]() { done = true; });
+    EXPECT_FALSE(done);
+
+    background_work.run_in_background([&]() { EXPECT_FALSE(done); });
+
+    EXPECT_TRUE(done);
+}
+
+TEST_F(BackgroundGLWork, when_done_calls_back_immediately_after_work_is_done)
+{
+    background_work.ensure_done(work);
+
+    bool done{false};
+    background_work.when_done([&]() { done = true; });
+
+    EXPECT_TRUE(done);
+}
+
+TEST_F(BackgroundGLWork, when_done_is_called_if_background_work_fails)
+{
+    bool done{false};
+    background_work.when_done([&]() { done = true; });
+
+    EXPECT_THROW(
+        background_work.run_in_background([]() { throw std::runtime_error{"Upload failed"}; }),
+        std::runtime_error);
+
+    EXPECT_TRUE(done);
+}
+
+TEST_F(BackgroundGLWork, when_done_is_called_once)
+{
+    int calls{0};
+    background_work.when_done([&]() { ++calls; });
+
+    background_work.run_in_background(work);
+    background_work.ensure_done(work);
+
+    EXPECT_THAT(calls, Eq(1));
+}
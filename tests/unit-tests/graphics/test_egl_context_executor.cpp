@@ -0,0 +1,159 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/platforms/common/server/egl_context_executor.h"
+#include "mir/renderer/gl/context.h"
+
+#include "mir/test/signal.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+
+namespace mgc = mir::graphics::common;
+namespace mt = mir::test;
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+class ThreadTrackingContext : public mir::renderer::gl::Context
+{
+public:
+    explicit ThreadTrackingContext(std::atomic<std::thread::id>& current_on)
+        : current_on{current_on}
+    {
+    }
+
+    void make_current() const override
+    {
+        current_on = std::this_thread::get_id();
+    }
+
+    void release_current() const override
+    {
+        current_on = std::thread::id{};
+    }
+
+private:
+    std::atomic<std::thread::id>& current_on;
+};
+
+struct EGLContextExecutor : Test
+{
+    std::atomic<std::thread::id> context_current_on;
+    std::unique_ptr<mgc::EGLContextExecutor> executor{
+        std::make_unique<mgc::EGLContextExecutor>(std::make_unique<ThreadTrackingContext>(context_current_on))};
+};
+}
+
+TEST_F(EGLContextExecutor, work_runs_with_the_context_current)
+{
+    mt::Signal done;
+    std::atomic<bool> context_was_current{false};
+
+    executor->spawn(
+        [&]()
+        {
+            context_was_current = context_current_on.load() == std::this_thread::get_id();
+            done.raise();
+        });
+
+    ASSERT_TRUE(done.wait_for(60s));
+    EXPECT_TRUE(context_was_current);
+}
+
+TEST_F(EGLContextExecutor, spawn_does_not_wait_for_running_work)
+{
+    mt::Signal work_started;
+    mt::Signal release_work;
+    mt::Signal second_work_done;
+
+    executor->spawn(
+        [&]()
+        {
+            work_started.raise();
+            release_work.wait_for(60s);
+        });
+    ASSERT_TRUE(work_started.wait_for(60s));
+
+    // If spawn() waited on the running work this would not return until it timed out
+    executor->spawn([&]() { second_work_done.raise(); });
+    EXPECT_FALSE(release_work.raised());
+
+    release_work.raise();
+    EXPECT_TRUE(second_work_done.wait_for(60s));
+}
+
+TEST_F(EGLContextExecutor, work_can_spawn_more_work)
+{
+    mt::Signal done;
+
+    executor->spawn(
+        [&]()
+        {
+            executor->spawn([&]() { done.raise(); });
+        });
+
+    EXPECT_TRUE(done.wait_for(60s));
+}
+
+TEST_F(EGLContextExecutor, destruction_runs_outstanding_work)
+{
+    mt::Signal release_work;
+    std::atomic<int> runs{0};
+    // The executor is still usable by its own work while its destructor drains the queue
+    auto const raw_executor = executor.get();
+
+    executor->spawn(
+        [&]()
+        {
+            release_work.wait_for(60s);
+            ++runs;
+        });
+    executor->spawn([&]() { ++runs; });
+    executor->spawn(
+        [&]()
+        {
+            // Work spawned while shutting down is still run
+            raw_executor->spawn([&]() { ++runs; });
+        });
+
+    std::thread releaser{
+        [&]()
+        {
+            std::this_thread::sleep_for(10ms);
+            release_work.raise();
+        }};
+
+    executor.reset();
+    releaser.join();
+
+    EXPECT_THAT(runs, Eq(3));
+}
+
+TEST_F(EGLContextExecutor, context_is_released_on_destruction)
+{
+    mt::Signal done;
+    executor->spawn([&]() { done.raise(); });
+    ASSERT_TRUE(done.wait_for(60s));
+
+    executor.reset();
+
+    EXPECT_THAT(context_current_on.load(), Eq(std::thread::id{}));
+}
@@ -18,6 +18,12 @@
 
 #include <gtest/gtest.h>
 #include <fcntl.h>
+#include <unistd.h>
+#include <system_error>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
 #include <boost/throw_exception.hpp>
 
 #include "mir/graphics/platform.h"
@@ -285,3 +291,181 @@ TEST_F(ServerPlatformProbeMockDRM, IgnoresNonPlatformModules)
         std::make_shared<StubConsoleServices>());
     EXPECT_THAT(selected_modules, Not(IsEmpty()));
 }
+
+#ifdef MIR_BUILD_PLATFORM_GBM_KMS
+namespace
+{
+/// Hands out devices like StubConsoleServices, noting the most probes that held the same one at once
+class ContendedConsoleServices : public StubConsoleServices
+{
+public:
+    std::future<std::unique_ptr<mir::Device>> acquire_device(
+        int major, int minor,
+        std::unique_ptr<mir::Device::Observer> observer) override
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            auto& holders = holders_of[{major, minor}];
+            ++holders;
+            most_concurrent_holders = std::max(most_concurrent_holders, holders);
+        }
+
+        // Give any other probe time to reach the same device
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        StubConsoleServices::acquire_device(major, minor, std::move(observer)).get();
+
+        std::promise<std::unique_ptr<mir::Device>> promise;
+        promise.set_value(std::make_unique<HeldDevice>(*this, major, minor));
+        return promise.get_future();
+    }
+
+    std::mutex mutex;
+    std::map<std::pair<int, int>, int> holders_of;
+    int most_concurrent_holders{0};
+
+private:
+    class HeldDevice : public mir::Device
+    {
+    public:
+        HeldDevice(ContendedConsoleServices& console, int major, int minor)
+            : console{console},
+              devnum{major, minor}
+        {
+        }
+
+        ~HeldDevice()
+        {
+            std::lock_guard<std::mutex> lock{console.mutex};
+            --console.holders_of[devnum];
+        }
+
+    private:
+        ContendedConsoleServices& console;
+        std::pair<int, int> const devnum;
+    };
+};
+}
+
+TEST_F(ServerPlatformProbeMockDRM, display_modules_do_not_contend_for_a_device)
+{
+    using namespace testing;
+    mir::options::ProgramOption options;
+    auto ensure_mesa = ensure_mesa_probing_succeeds();
+
+    auto modules = available_platforms();
+    auto const other_modules = available_platforms();
+    modules.insert(modules.end(), other_modules.begin(), other_modules.end());
+    ASSERT_THAT(modules.size(), Ge(2u));
+
+    auto const console = std::make_shared<ContendedConsoleServices>();
+    mir::graphics::display_modules_for_device(modules, options, console);
+
+    EXPECT_THAT(console->holders_of, Not(IsEmpty()));
+    EXPECT_THAT(console->most_concurrent_holders, Eq(1));
+}
+#endif
+
+namespace
+{
+class ServerPlatformProbeCache : public ::testing::Test
+{
+public:
+    ServerPlatformProbeCache()
+    {
+        char tmp_name[] = "/tmp/mir_probe_cache_XXXXXX";
+        if (mkdtemp(tmp_name) == nullptr)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create temporary directory"};
+        }
+        temporary_directory = tmp_name;
+        cache_path = temporary_directory + "/probe-cache";
+    }
+
+    ~ServerPlatformProbeCache()
+    {
+        unlink(cache_path.c_str());
+        rmdir(temporary_directory.c_str());
+    }
+
+    std::string temporary_directory;
+    std::string cache_path;
+    mir::options::ProgramOption options;
+    std::shared_ptr<void> const block_mesa{ensure_mesa_probing_fails()};
+};
+
+auto names_of(std::vector<std::shared_ptr<mir::SharedLibrary>> const& modules) -> std::vector<std::string>
+{
+    std::vector<std::string> names;
+    for (auto const& module : modules)
+    {
+        auto descriptor = module->load_function<mir::graphics::DescribeModule>(describe_module);
+        names.emplace_back(descriptor()->name);
+    }
+    return names;
+}
+}
+
+TEST_F(ServerPlatformProbeCache, records_selected_modules)
+{
+    using namespace testing;
+    auto modules = available_platforms();
+    add_dummy_platform(modules);
+
+    mir::graphics::PlatformProbeCache cache{cache_path, modules};
+    auto const selected_modules = mir::graphics::display_modules_for_device(
+        modules,
+        options,
+        std::make_shared<mtd::NullConsoleServices>(),
+        &cache);
+
+    auto const record = cache.lookup("display");
+    EXPECT_THAT(record.priority, Eq(mir::graphics::dummy));
+    EXPECT_THAT(names_of(record.modules), ContainerEq(names_of(selected_modules)));
+    EXPECT_THAT(cache.lookup("rendering").modules, IsEmpty());
+}
+
+TEST_F(ServerPlatformProbeCache, selects_recorded_modules)
+{
+    using namespace testing;
+    auto modules = available_platforms();
+    add_dummy_platform(modules);
+
+    {
+        mir::graphics::PlatformProbeCache cache{cache_path, modules};
+        mir::graphics::rendering_modules_for_device(
+            modules,
+            options,
+            std::make_shared<mtd::NullConsoleServices>(),
+            &cache);
+    }
+
+    mir::graphics::PlatformProbeCache cache{cache_path, modules};
+    auto const selected_modules = mir::graphics::rendering_modules_for_device(
+        modules,
+        options,
+        std::make_shared<mtd::NullConsoleServices>(),
+        &cache);
+
+    EXPECT_THAT(names_of(selected_modules), Contains(HasSubstr("mir:stub-graphics")));
+}
+
+TEST_F(ServerPlatformProbeCache, ignores_records_made_with_other_modules)
+{
+    using namespace testing;
+    auto modules = available_platforms();
+    add_dummy_platform(modules);
+
+    {
+        mir::graphics::PlatformProbeCache cache{cache_path, modules};
+        mir::graphics::display_modules_for_device(
+            modules,
+            options,
+            std::make_shared<mtd::NullConsoleServices>(),
+            &cache);
+    }
+
+    modules.push_back(std::make_shared<mir::SharedLibrary>(mtf::server_platform("graphics-dummy.so")));
+    mir::graphics::PlatformProbeCache cache{cache_path, modules};
+
+    EXPECT_THAT(cache.lookup("display").modules, IsEmpty());
+}
@@ -22,6 +22,7 @@
 
 #include "mir/test/doubles/mock_gl.h"
 #include "mir/test/doubles/mock_egl.h"
+#include "mir/test/signal.h"
 
 #include "check_gtest_version.h"
 
@@ -34,6 +35,7 @@
 
 namespace mg = mir::graphics;
 namespace mgc = mir::graphics::common;
+namespace mt = mir::test;
 namespace mtd = mir::test::doubles;
 namespace geom = mir::geometry;
 using namespace testing;
@@ -353,3 +355,44 @@ TEST_F(ShmBufferTest, texture_is_destroyed_on_thread_with_current_context)
         eglMakeCurrent(dummy_dpy, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
     }
 }
+
+TEST_F(ShmBufferTest, aliased_storage_is_kept_until_texture_is_destroyed)
+{
+    struct AliasingShmBuffer : PlatformlessShmBuffer
+    {
+        using PlatformlessShmBuffer::PlatformlessShmBuffer;
+        using ShmBuffer::keep_until_texture_deleted;
+    };
+
+    GLint const tex_id{0x8086};
+    std::weak_ptr<int> storage;
+    bool storage_alive_when_texture_deleted{false};
+
+    ON_CALL(mock_gl, glGenTextures(1,_))
+        .WillByDefault(SetArgPointee<1>(tex_id));
+    EXPECT_CALL(mock_gl, glDeleteTextures(1,Pointee(Eq(tex_id))))
+        .WillOnce(InvokeWithoutArgs([&]() { storage_alive_when_texture_deleted = !storage.expired(); }));
+
+    {
+        // The EGLContextExecutor destructor drains its work-queue
+        auto egl_delegate = std::make_shared<mgc::EGLContextExecutor>(
+            std::make_unique<DumbGLContext>(reinterpret_cast<EGLContext>(42)));
+
+        // Hold up the EGL thread until the buffer has been completely destroyed
+        mt::Signal buffer_destroyed;
+        egl_delegate->spawn([&]() { buffer_destroyed.wait_for(std::chrono::seconds{10}); });
+
+        {
+            AliasingShmBuffer buffer{size, pixel_format, egl_delegate};
+            buffer.bind();
+
+            auto const aliased = std::make_shared<int>(0);
+            storage = aliased;
+            buffer.keep_until_texture_deleted(aliased);
+        }
+        buffer_destroyed.raise();
+    }
+
+    EXPECT_TRUE(storage_alive_when_texture_deleted);
+    EXPECT_TRUE(storage.expired());
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/platforms/common/server/shm_udmabuf.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <system_error>
+
+namespace shm_udmabuf = mir::graphics::common::shm_udmabuf;
+using namespace testing;
+
+namespace
+{
+auto const page_size = sysconf(_SC_PAGESIZE);
+
+auto sealed_memfd(off_t size, unsigned int seals = F_SEAL_SHRINK) -> mir::Fd
+{
+    mir::Fd fd{memfd_create("test_shm_udmabuf", MFD_CLOEXEC | MFD_ALLOW_SEALING)};
+    if (fd == mir::Fd::invalid ||
+        ftruncate(fd, size) != 0 ||
+        (seals && fcntl(fd, F_ADD_SEALS, seals) != 0))
+    {
+        throw std::system_error{errno, std::system_category(), "Failed to create test memfd"};
+    }
+    return fd;
+}
+
+struct ShmUdmabuf : Test
+{
+    // No device: tracking works as normal, but the kernel will refuse to create dmabufs
+    shm_udmabuf::ClientPools pools{mir::Fd{}};
+
+    uint32_t const pool_id{3};
+    uint32_t const buffer_id{7};
+    uint32_t const format{0x34325258};  // XRGB8888
+    shm_udmabuf::BufferPlacement const placement{0, 64, 32, 64 * 4, format};
+    off_t const pool_size{4 * page_size};
+};
+}
+
+TEST_F(ShmUdmabuf, buffer_in_sealed_memfd_pool_can_be_imported)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.buffer_created(buffer_id, pool_id, placement);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), NotNull());
+}
+
+TEST_F(ShmUdmabuf, import_is_reused_for_each_commit_of_a_buffer)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.buffer_created(buffer_id, pool_id, placement);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), Eq(pools.import_for(buffer_id, placement)));
+}
+
+TEST_F(ShmUdmabuf, buffer_in_unsealed_memfd_pool_is_not_imported)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size, 0));
+    pools.buffer_created(buffer_id, pool_id, placement);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), IsNull());
+}
+
+TEST_F(ShmUdmabuf, buffer_in_write_sealed_memfd_pool_is_not_imported)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size, F_SEAL_SHRINK | F_SEAL_WRITE));
+    pools.buffer_created(buffer_id, pool_id, placement);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), IsNull());
+}
+
+TEST_F(ShmUdmabuf, buffer_in_pool_that_is_not_a_memfd_is_not_imported)
+{
+    int pipe_fds[2];
+    ASSERT_THAT(pipe2(pipe_fds, O_CLOEXEC), Eq(0));
+    mir::Fd const read_end{pipe_fds[0]}, write_end{pipe_fds[1]};
+
+    pools.pool_created(pool_id, read_end);
+    pools.buffer_created(buffer_id, pool_id, placement);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), IsNull());
+}
+
+TEST_F(ShmUdmabuf, buffer_at_unaligned_offset_is_not_imported)
+{
+    auto unaligned = placement;
+    unaligned.offset = 64;
+
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.buffer_created(buffer_id, pool_id, unaligned);
+
+    EXPECT_THAT(pools.import_for(buffer_id, unaligned), IsNull());
+}
+
+TEST_F(ShmUdmabuf, buffer_extending_beyond_pool_is_not_imported)
+{
+    // The buffer itself fits, but rounding it up to whole pages does not
+    auto at_end = placement;
+    at_end.offset = pool_size - page_size;
+    at_end.height = page_size / at_end.stride + 1;
+
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.buffer_created(buffer_id, pool_id, at_end);
+
+    EXPECT_THAT(pools.import_for(buffer_id, at_end), IsNull());
+}
+
+TEST_F(ShmUdmabuf, buffer_with_different_geometry_is_not_imported)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.buffer_created(buffer_id, pool_id, placement);
+
+    auto narrower = placement;
+    narrower.width = placement.width - 1;
+    auto other_format = placement;
+    other_format.format = 0x34324152;   // ARGB8888
+
+    EXPECT_THAT(pools.import_for(buffer_id, narrower), IsNull());
+    EXPECT_THAT(pools.import_for(buffer_id, other_format), IsNull());
+}
+
+TEST_F(ShmUdmabuf, destroyed_buffer_is_not_imported)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.buffer_created(buffer_id, pool_id, placement);
+    pools.buffer_destroyed(buffer_id);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), IsNull());
+}
+
+TEST_F(ShmUdmabuf, buffer_outlives_its_pool)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.buffer_created(buffer_id, pool_id, placement);
+    pools.pool_destroyed(pool_id);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), NotNull());
+}
+
+TEST_F(ShmUdmabuf, buffer_created_after_its_pool_is_destroyed_is_not_imported)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.pool_destroyed(pool_id);
+    pools.buffer_created(buffer_id, pool_id, placement);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), IsNull());
+}
+
+TEST_F(ShmUdmabuf, reused_buffer_id_replaces_the_old_buffer)
+{
+    uint32_t const unsealed_pool_id{pool_id + 1};
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.pool_created(unsealed_pool_id, sealed_memfd(pool_size, 0));
+
+    pools.buffer_created(buffer_id, pool_id, placement);
+    pools.buffer_created(buffer_id, unsealed_pool_id, placement);
+
+    EXPECT_THAT(pools.import_for(buffer_id, placement), IsNull());
+}
+
+TEST_F(ShmUdmabuf, failure_to_create_dmabuf_gives_invalid_fd)
+{
+    pools.pool_created(pool_id, sealed_memfd(pool_size));
+    pools.buffer_created(buffer_id, pool_id, placement);
+    auto const import = pools.import_for(buffer_id, placement);
+    ASSERT_THAT(import, NotNull());
+
+    EXPECT_THAT(import->dmabuf(), Eq(mir::Fd::invalid));
+    EXPECT_THAT(import->dmabuf(), Eq(mir::Fd::invalid));
+}
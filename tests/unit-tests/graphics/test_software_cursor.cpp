@@ -47,6 +47,7 @@ struct MockInputScene : mtd::StubInputScene
                  void(std::weak_ptr<mg::Renderable> const&));
 
     MOCK_METHOD0(emit_scene_changed, void());
+    MOCK_METHOD1(emit_scene_damaged, void(geom::Rectangle const&));
 };
 
 struct StubCursorImage : mg::CursorImage
@@ -286,15 +287,27 @@ TEST_F(SoftwareCursor, moves_scene_renderable_offset_by_hotspot_when_moved)
                 Eq(new_position - stub_cursor_image.hotspot()));
 }
 
-TEST_F(SoftwareCursor, notifies_scene_when_moving)
+TEST_F(SoftwareCursor, notifies_scene_of_old_and_new_cursor_areas_when_moving)
 {
     using namespace testing;
 
-    EXPECT_CALL(mock_input_scene, emit_scene_changed());
+    std::shared_ptr<mg::Renderable> cursor_renderable;
+
+    EXPECT_CALL(mock_input_scene, add_input_visualization(_))
+        .WillOnce(SaveArg<0>(&cursor_renderable));
 
     cursor.show(stub_cursor_image);
     executor.execute();
-    cursor.move_to({22,23});
+
+    auto const old_area = cursor_renderable->screen_position();
+    geom::Point const new_position{22,23};
+    geom::Rectangle const new_area{new_position - stub_cursor_image.hotspot(), stub_cursor_image.size()};
+
+    EXPECT_CALL(mock_input_scene, emit_scene_changed()).Times(0);
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(old_area));
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(new_area));
+
+    cursor.move_to(new_position);
 }
 
 TEST_F(SoftwareCursor, creates_renderable_with_filled_buffer)
@@ -326,6 +339,7 @@ TEST_F(SoftwareCursor, does_not_hide_or_move_when_already_hidden)
 
     EXPECT_CALL(mock_input_scene, remove_input_visualization(_)).Times(0);
     EXPECT_CALL(mock_input_scene, emit_scene_changed()).Times(0);
+    EXPECT_CALL(mock_input_scene, emit_scene_damaged(_)).Times(0);
 
     // Already hidden, nothing should happen
     cursor.hide();
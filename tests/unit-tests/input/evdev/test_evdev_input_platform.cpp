@@ -18,16 +18,23 @@
 
 #include "src/platforms/evdev/platform.h"
 #include "src/server/report/null_report_factory.h"
+#include "src/server/input/default_event_builder.h"
 #include "mir/console_services.h"
 
 #include "mir/input/input_device_registry.h"
+#include "mir/input/input_device.h"
 #include "mir/dispatch/dispatchable.h"
+#include "mir/cookie/authority.h"
 
 #include "mir/udev/wrapper.h"
 #include "mir_test_framework/udev_environment.h"
 #include "mir/test/fake_shared.h"
+#include "mir/test/event_matchers.h"
 #include "mir/test/doubles/mock_libinput.h"
 #include "mir/test/doubles/mock_udev.h"
+#include "mir/test/doubles/mock_input_seat.h"
+#include "mir/test/doubles/mock_input_sink.h"
+#include "mir/test/doubles/advanceable_clock.h"
 #include "mir/test/doubles/stub_console_services.h"
 #include "mir/test/fd_utils.h"
 
@@ -35,6 +42,7 @@
 #include <gmock/gmock.h>
 
 #include <umockdev.h>
+#include <linux/input.h>
 #include <memory>
 #include <vector>
 #include <initializer_list>
@@ -132,14 +140,15 @@ struct EvdevInputPlatform : public ::testing::TestWithParam<std::string>
 
     }
 
-    auto create_input_platform()
+    auto create_input_platform(bool coalesce_pointer_motion = false)
     {
         auto ctx = std::make_unique<mu::Context>();
         return std::make_unique<mie::Platform>(
             mt::fake_shared(mock_registry),
             mr::null_input_report(),
             std::move(ctx),
-            std::make_shared<mtd::StubConsoleServices>());
+            std::make_shared<mtd::StubConsoleServices>(),
+            coalesce_pointer_motion);
     }
 
     void remove_all_devices()
@@ -294,3 +303,50 @@ TEST_F(EvdevInputPlatform, creates_new_context_on_resume)
     EXPECT_CALL(li_mock, libinput_path_create_context(_,_));
     platform->start();
 }
+
+TEST_F(EvdevInputPlatform, merged_motion_is_sent_before_a_later_event_from_another_device)
+{
+    NiceMock<mtd::MockInputSink> sink;
+    NiceMock<mtd::MockInputSeat> seat;
+    mtd::AdvanceableClock clock;
+    mi::DefaultEventBuilder builder{
+        MirInputDeviceId{1},
+        mt::fake_shared(clock),
+        mir::cookie::Authority::create(),
+        mt::fake_shared(seat)};
+
+    std::vector<std::shared_ptr<mi::InputDevice>> added;
+    ON_CALL(mock_registry, add_device(_))
+        .WillByDefault(
+            Invoke(
+                [&](std::shared_ptr<mi::InputDevice> const& device)
+                {
+                    added.push_back(device);
+                    return std::weak_ptr<mi::Device>{};
+                }));
+
+    auto platform = create_input_platform(true);
+    platform->start();
+
+    udev.add_standard_device("usb-mouse");
+    run_dispatchable(*platform);
+    auto const mouse = reinterpret_cast<libinput_device*>(device_count);
+    udev.add_standard_device("usb-keyboard");
+    run_dispatchable(*platform);
+    auto const keyboard = reinterpret_cast<libinput_device*>(device_count);
+
+    for (auto const& device : added)
+    {
+        device->start(&sink, &builder);
+    }
+
+    InSequence seq;
+    EXPECT_CALL(sink, handle_input(mt::PointerEventWithDiff(15, 17)));
+    EXPECT_CALL(sink, handle_input(mt::KeyDownEvent()));
+
+    li_mock.setup_pointer_event(mouse, 1000, 15, 17);
+    li_mock.setup_key_event(keyboard, 2000, KEY_A, LIBINPUT_KEY_STATE_PRESSED);
+    run_dispatchable(*platform);
+
+    platform->stop();
+}
@@ -247,6 +247,12 @@ struct LibInputDeviceOnMouse : public LibInputDevice
     mie::LibInputDevice mouse{mir::report::null_input_report(), mie::make_libinput_device(lib, fake_device)};
 };
 
+struct LibInputDeviceOnCoalescingMouse : public LibInputDevice
+{
+    libinput_device*const fake_device = setup_mouse();
+    mie::LibInputDevice mouse{mir::report::null_input_report(), mie::make_libinput_device(lib, fake_device), true};
+};
+
 struct LibInputDeviceOnLaptopKeyboardAndMouse : public LibInputDevice
 {
     libinput_device*const fake_device = setup_mouse();
@@ -453,6 +459,49 @@ TEST_F(LibInputDeviceOnMouse, notices_slow_relative_movements)
     process_events(mouse);
 }
 
+TEST_F(LibInputDeviceOnCoalescingMouse, merges_consecutive_motion_until_flushed)
+{
+    float x1 = 15, x2 = 23;
+    float y1 = 17, y2 = 21;
+
+    mouse.start(&mock_sink, &mock_builder);
+    env.mock_libinput.setup_pointer_event(fake_device, event_time_1, x1, y1);
+    env.mock_libinput.setup_pointer_event(fake_device, event_time_2, x2, y2);
+
+    EXPECT_CALL(mock_sink, handle_input(_)).Times(0);
+    process_events(mouse);
+    Mock::VerifyAndClearExpectations(&mock_sink);
+
+    EXPECT_CALL(mock_sink, handle_input(mt::PointerEventWithDiff(x1 + x2, y1 + y2)));
+    mouse.flush_pending_motion();
+}
+
+TEST_F(LibInputDeviceOnCoalescingMouse, failure_sending_merged_motion_is_not_thrown_from_flush)
+{
+    mouse.start(&mock_sink, &mock_builder);
+    env.mock_libinput.setup_pointer_event(fake_device, event_time_1, 15, 17);
+    process_events(mouse);
+
+    EXPECT_CALL(mock_sink, handle_input(_)).WillOnce(Throw(std::runtime_error{"sink failed"}));
+    EXPECT_NO_THROW(mouse.flush_pending_motion());
+}
+
+TEST_F(LibInputDeviceOnCoalescingMouse, sends_merged_motion_before_button_events)
+{
+    float x1 = 15, x2 = 23;
+    float y1 = 17, y2 = 21;
+
+    InSequence seq;
+    EXPECT_CALL(mock_sink, handle_input(mt::PointerEventWithDiff(x1 + x2, y1 + y2)));
+    EXPECT_CALL(mock_sink, handle_input(mt::ButtonDownEventWithButton(geom::Point{0, 0}, mir_pointer_button_primary)));
+
+    mouse.start(&mock_sink, &mock_builder);
+    env.mock_libinput.setup_pointer_event(fake_device, event_time_1, x1, y1);
+    env.mock_libinput.setup_pointer_event(fake_device, event_time_2, x2, y2);
+    env.mock_libinput.setup_button_event(fake_device, event_time_3, BTN_LEFT, LIBINPUT_BUTTON_STATE_PRESSED);
+    process_events(mouse);
+}
+
 TEST_F(LibInputDeviceOnMouse, process_event_handles_press_and_release)
 {
     float const x = 0;
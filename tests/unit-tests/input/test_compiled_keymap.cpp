@@ -0,0 +1,99 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 or 3 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "mir/input/compiled_keymap.h"
+#include "mir/input/parameter_keymap.h"
+
+#include <xkbcommon/xkbcommon.h>
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace mi = mir::input;
+
+using namespace ::testing;
+
+namespace
+{
+auto us_keymap() -> std::shared_ptr<mi::Keymap>
+{
+    return std::make_shared<mi::ParameterKeymap>("pc105", "us", "", "");
+}
+}
+
+TEST(CompiledKeymap, matching_keymaps_share_a_compilation)
+{
+    auto const a = mi::CompiledKeymap::of(us_keymap());
+    auto const b = mi::CompiledKeymap::of(us_keymap());
+
+    EXPECT_THAT(a, Eq(b));
+}
+
+TEST(CompiledKeymap, different_keymaps_are_compiled_separately)
+{
+    auto const us = mi::CompiledKeymap::of(us_keymap());
+    auto const gb = mi::CompiledKeymap::of(std::make_shared<mi::ParameterKeymap>("pc105", "gb", "", ""));
+
+    EXPECT_THAT(us, Ne(gb));
+}
+
+TEST(CompiledKeymap, text_is_a_nul_terminated_keymap)
+{
+    auto const compiled = mi::CompiledKeymap::of(us_keymap());
+    auto const fd = compiled->text_fd();
+    auto const size = compiled->text_size();
+
+    auto const text = static_cast<char const*>(mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0));
+    ASSERT_THAT(text, Ne(MAP_FAILED));
+
+    EXPECT_THAT(text[size - 1], Eq('\0'));
+    EXPECT_THAT(text, StartsWith("xkb_keymap"));
+    munmap(const_cast<char*>(text), size);
+}
+
+TEST(CompiledKeymap, text_fd_is_read_only)
+{
+    auto const compiled = mi::CompiledKeymap::of(us_keymap());
+    auto const fd = compiled->text_fd();
+
+    EXPECT_THAT(fcntl(fd, F_GETFL) & O_ACCMODE, Eq(O_RDONLY));
+    EXPECT_THAT(mmap(nullptr, compiled->text_size(), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0), Eq(MAP_FAILED));
+}
+
+TEST(CompiledKeymap, text_fds_have_independent_offsets)
+{
+    auto const compiled = mi::CompiledKeymap::of(us_keymap());
+    auto const a = compiled->text_fd();
+    auto const b = compiled->text_fd();
+
+    char c;
+    ASSERT_THAT(read(a, &c, 1), Eq(1));
+    EXPECT_THAT(lseek(b, 0, SEEK_CUR), Eq(0));
+}
+
+TEST(CompiledKeymap, states_outlive_the_compiled_keymap)
+{
+    auto compiled = mi::CompiledKeymap::of(us_keymap());
+    auto const state = compiled->make_state();
+    compiled.reset();
+
+    xkb_keycode_t const key_a{30 + 8};
+    EXPECT_THAT(xkb_state_key_get_one_sym(state.get(), key_a), Eq(XKB_KEY_a));
+}
@@ -127,6 +127,7 @@ struct StubInputSurface : public mtd::StubSurface
 
     bool input_area_contains(geom::Point const& point) const override
     {
+        ++hit_tests;
         return bounds.contains(point);
     }
 
@@ -191,6 +192,7 @@ struct StubInputSurface : public mtd::StubSurface
 
     geom::Rectangle const bounds;
     std::shared_ptr<mg::CursorImage> cursor_image_;
+    mutable int hit_tests{0};
 
     std::mutex observer_guard;
     std::vector<std::shared_ptr<ms::SurfaceObserver>> observers;
@@ -205,6 +207,7 @@ struct StubScene : public mtd::StubInputScene
 
     void for_each(std::function<void(std::shared_ptr<mi::Surface> const&)> const& callback) override
     {
+        ++for_each_calls;
         for (auto const& target : targets)
             callback(target);
     }
@@ -241,6 +244,7 @@ struct StubScene : public mtd::StubInputScene
 
     // TODO: Should be mi::Surface. See comment on StubInputSurface.
     std::vector<std::shared_ptr<ms::Surface>> targets;
+    int for_each_calls{0};
 
     mir::ThreadSafeList<std::shared_ptr<ms::Observer>> observers;
 };
@@ -495,3 +499,85 @@ TEST_F(TestCursorController, zero_sized_image_hides_cursor)
 
     targets.add_surface(mt::fake_shared(surface));
 }
+
+TEST_F(TestCursorController, pointer_motion_does_not_walk_unchanged_scene)
+{
+    StubInputSurface surface_1{rect_0_0_1_1, std::make_shared<NamedCursorImage>(cursor_name_1)};
+    StubInputSurface surface_2{rect_1_1_1_1, std::make_shared<NamedCursorImage>(cursor_name_2)};
+    StubScene targets({mt::fake_shared(surface_1), mt::fake_shared(surface_2)});
+
+    TestController controller{targets, cursor, default_cursor_image};
+
+    EXPECT_CALL(cursor, move_to(_)).Times(AnyNumber());
+    {
+        InSequence seq;
+        EXPECT_CALL(cursor, show(CursorNamed(cursor_name_2))).Times(1);
+        EXPECT_CALL(cursor, show(DefaultCursorImage())).Times(1);
+        EXPECT_CALL(cursor, show(CursorNamed(cursor_name_1))).Times(1);
+    }
+
+    auto const calls_before_motion = targets.for_each_calls;
+
+    controller.cursor_moved_to(1.0f, 1.0f);
+    controller.cursor_moved_to(2.0f, 2.0f);
+    controller.cursor_moved_to(0.0f, 0.0f);
+
+    EXPECT_THAT(targets.for_each_calls, Eq(calls_before_motion));
+}
+
+TEST_F(TestCursorController, motion_within_a_surface_only_hit_tests_it_and_the_surfaces_above_it)
+{
+    StubInputSurface bottom{{{0, 0}, {10, 10}}, std::make_shared<NamedCursorImage>(cursor_name_1)};
+    StubInputSurface middle{{{20, 20}, {10, 10}}, std::make_shared<NamedCursorImage>(cursor_name_2)};
+    StubInputSurface top{{{40, 40}, {10, 10}}, std::make_shared<NamedCursorImage>(cursor_name_1)};
+    StubScene targets({mt::fake_shared(bottom), mt::fake_shared(middle), mt::fake_shared(top)});
+
+    TestController controller{targets, cursor, default_cursor_image};
+
+    EXPECT_CALL(cursor, move_to(_)).Times(AnyNumber());
+    EXPECT_CALL(cursor, show(_)).Times(AnyNumber());
+
+    auto const reset_hit_tests = [&]
+        {
+            bottom.hit_tests = middle.hit_tests = top.hit_tests = 0;
+        };
+
+    controller.cursor_moved_to(45.0f, 45.0f);
+    reset_hit_tests();
+    controller.cursor_moved_to(46.0f, 46.0f);
+
+    EXPECT_THAT(top.hit_tests, Eq(1));
+    EXPECT_THAT(middle.hit_tests, Eq(0));
+    EXPECT_THAT(bottom.hit_tests, Eq(0));
+
+    controller.cursor_moved_to(5.0f, 5.0f);
+    reset_hit_tests();
+    controller.cursor_moved_to(6.0f, 6.0f);
+
+    EXPECT_THAT(top.hit_tests, Eq(1));
+    EXPECT_THAT(middle.hit_tests, Eq(1));
+    EXPECT_THAT(bottom.hit_tests, Eq(1));
+}
+
+TEST_F(TestCursorController, motion_onto_a_surface_below_does_not_hit_test_the_surface_left_again)
+{
+    StubInputSurface bottom{{{0, 0}, {10, 10}}, std::make_shared<NamedCursorImage>(cursor_name_1)};
+    StubInputSurface top{{{40, 40}, {10, 10}}, std::make_shared<NamedCursorImage>(cursor_name_2)};
+    StubScene targets({mt::fake_shared(bottom), mt::fake_shared(top)});
+
+    TestController controller{targets, cursor, default_cursor_image};
+
+    EXPECT_CALL(cursor, move_to(_)).Times(AnyNumber());
+    {
+        InSequence seq;
+        EXPECT_CALL(cursor, show(CursorNamed(cursor_name_2))).Times(1);
+        EXPECT_CALL(cursor, show(CursorNamed(cursor_name_1))).Times(1);
+    }
+
+    controller.cursor_moved_to(45.0f, 45.0f);
+    top.hit_tests = bottom.hit_tests = 0;
+    controller.cursor_moved_to(5.0f, 5.0f);
+
+    EXPECT_THAT(top.hit_tests, Eq(1));
+    EXPECT_THAT(bottom.hit_tests, Eq(1));
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/report/logging/input_latency_report.h"
+#include "mir/logging/logger.h"
+#include "mir/test/doubles/advanceable_clock.h"
+#include "mir/test/doubles/stub_renderable.h"
+#include "mir/test/doubles/stub_buffer.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+namespace mg = mir::graphics;
+namespace ml = mir::logging;
+namespace mtd = mir::test::doubles;
+namespace mrl = mir::report::logging;
+
+using namespace std::chrono_literals;
+using namespace testing;
+
+namespace
+{
+class Recorder : public ml::Logger
+{
+public:
+    void log(ml::Severity, std::string const& message, std::string const&) override
+    {
+        messages.push_back(message);
+    }
+
+    std::vector<std::string> messages;
+};
+
+struct LoggingInputLatencyReport : Test
+{
+    auto input_time_now() const -> std::chrono::nanoseconds
+    {
+        return clock->now().time_since_epoch();
+    }
+
+    void show(std::shared_ptr<mg::Buffer> const& buffer)
+    {
+        report.renderables_in_frame(display_id, {std::make_shared<mtd::StubRenderable>(buffer)});
+    }
+
+    void flush_report()
+    {
+        clock->advance_by(1s);
+        report.frame_posted(display_id);
+    }
+
+    std::shared_ptr<mtd::AdvanceableClock> const clock = std::make_shared<mtd::AdvanceableClock>();
+    std::shared_ptr<Recorder> const recorder = std::make_shared<Recorder>();
+    mrl::InputLatencyReport report{recorder, clock};
+
+    void const* const display_id = "display";
+    void const* const surface = "surface";
+    std::shared_ptr<mg::Buffer> const buffer = std::make_shared<mtd::StubBuffer>();
+};
+}
+
+TEST_F(LoggingInputLatencyReport, reports_time_from_input_to_post_of_response)
+{
+    report.buffer_committed(surface, buffer->id(), input_time_now());
+    clock->advance_by(5ms);
+    show(buffer);
+    clock->advance_by(11ms);
+    report.frame_posted(display_id);
+
+    flush_report();
+
+    ASSERT_THAT(recorder->messages, SizeIs(1));
+    EXPECT_THAT(recorder->messages[0], HasSubstr("over 1 frames"));
+    EXPECT_THAT(recorder->messages[0], HasSubstr("min 16.000 ms"));
+    EXPECT_THAT(recorder->messages[0], HasSubstr("max 16.000 ms"));
+}
+
+TEST_F(LoggingInputLatencyReport, ignores_buffers_not_committed_in_response_to_input)
+{
+    show(buffer);
+    report.frame_posted(display_id);
+
+    flush_report();
+
+    EXPECT_THAT(recorder->messages, IsEmpty());
+}
+
+TEST_F(LoggingInputLatencyReport, replaced_response_is_measured_from_earliest_input)
+{
+    auto const replacement = std::make_shared<mtd::StubBuffer>();
+
+    report.buffer_committed(surface, buffer->id(), input_time_now());
+    clock->advance_by(10ms);
+    report.buffer_committed(surface, replacement->id(), input_time_now());
+    clock->advance_by(10ms);
+    show(replacement);
+    report.frame_posted(display_id);
+
+    flush_report();
+
+    ASSERT_THAT(recorder->messages, SizeIs(1));
+    EXPECT_THAT(recorder->messages[0], HasSubstr("min 20.000 ms"));
+}
+
+TEST_F(LoggingInputLatencyReport, forgets_responses_of_destroyed_surfaces)
+{
+    report.buffer_committed(surface, buffer->id(), input_time_now());
+    show(buffer);
+    report.surface_destroyed(surface);
+    report.frame_posted(display_id);
+
+    flush_report();
+
+    EXPECT_THAT(recorder->messages, IsEmpty());
+}
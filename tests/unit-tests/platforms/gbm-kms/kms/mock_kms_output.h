@@ -43,6 +43,8 @@ struct MockKMSOutput : public graphics::gbm::KMSOutput
     MOCK_METHOD2(configure, void(geometry::Displacement, size_t));
     MOCK_CONST_METHOD0(size, geometry::Size());
     MOCK_CONST_METHOD0(max_refresh_rate, int());
+    MOCK_METHOD1(allow_adaptive_sync, void(bool));
+    MOCK_METHOD1(set_adaptive_sync, bool(bool));
 
     bool set_crtc(graphics::gbm::FBHandle const& fb) override
     {
@@ -37,6 +37,7 @@
 
 #include <unordered_map>
 #include <algorithm>
+#include <array>
 
 #include <string.h>
 
@@ -472,6 +473,112 @@ TEST_F(MesaCursorTest, pads_missing_data_when_buffer_size_differs)
     cursor_tmp.show(SinglePixelCursorImage());
 }
 
+namespace
+{
+/// A 64x64 image in which every pixel differs from its neighbours, so any padding or reordering shows
+struct PatternedCursorImage : public StubCursorImage
+{
+    PatternedCursorImage()
+    {
+        for (uint32_t i = 0; i != pixels.size(); ++i)
+        {
+            pixels[i] = 0xff000000 | i;
+        }
+    }
+
+    void const* as_argb_8888() const
+    {
+        return pixels.data();
+    }
+
+    std::array<uint32_t, 64*64> pixels;
+};
+
+// Each row of the buffer holds the corresponding row of the image, followed by transparency up to the stride
+MATCHER_P2(HoldsImageWithStride, image, stride, "")
+{
+    size_t const width = image->size().width.as_uint32_t();
+    size_t const height = image->size().height.as_uint32_t();
+    auto const image_bytes = static_cast<uint8_t const*>(image->as_argb_8888());
+    auto const buffer_bytes = static_cast<uint8_t const*>(arg);
+    for (size_t y = 0; y != height; ++y)
+    {
+        auto const row = buffer_bytes + y*stride;
+        if (memcmp(row, image_bytes + y*width*4, width*4) != 0)
+            return false;
+        for (size_t x = width*4; x != stride; ++x)
+        {
+            if (row[x] != 0)
+                return false;
+        }
+    }
+    return true;
+}
+}
+
+TEST_F(MesaCursorTest, image_that_exactly_fits_the_buffer_is_written_unpadded)
+{
+    using namespace ::testing;
+
+    PatternedCursorImage const image;
+    size_t const stride = cursor_side * 4;
+    ON_CALL(mock_gbm, gbm_bo_get_stride(_))
+        .WillByDefault(Return(stride));
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(mock_gbm.fake_gbm.bo, HoldsImageWithStride(&image, stride), sizeof image.pixels));
+
+    cursor.show(image);
+}
+
+TEST_F(MesaCursorTest, image_as_wide_as_the_buffer_is_padded_to_a_wider_stride)
+{
+    using namespace ::testing;
+
+    PatternedCursorImage const image;
+    size_t const stride = cursor_side * 4 + 64;
+    ON_CALL(mock_gbm, gbm_bo_get_stride(_))
+        .WillByDefault(Return(stride));
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(mock_gbm.fake_gbm.bo, HoldsImageWithStride(&image, stride), stride * cursor_side));
+
+    cursor.show(image);
+}
+
+TEST_F(MesaCursorTest, writes_image_to_buffer_created_after_show)
+{
+    using namespace testing;
+
+    cursor.show(stub_image);
+
+    // The cursor has no buffer for an output it hasn't seen before
+    ON_CALL(*output_container.outputs[0], id())
+        .WillByDefault(Return(7));
+
+    EXPECT_CALL(mock_gbm, gbm_bo_write(mock_gbm.fake_gbm.bo, NotNull(), _));
+
+    cursor.move_to({10, 10});
+}
+
+TEST_F(MesaCursorTest, rewrites_every_buffer_when_a_smaller_buffer_is_created)
+{
+    using namespace testing;
+
+    cursor.show(stub_image);
+
+    ON_CALL(mock_gbm, gbm_bo_get_width(_))
+        .WillByDefault(Return(32));
+    ON_CALL(mock_gbm, gbm_bo_get_height(_))
+        .WillByDefault(Return(32));
+    ON_CALL(*output_container.outputs[0], id())
+        .WillByDefault(Return(7));
+
+    // Both the existing buffer and the new one are cropped to the smaller size
+    EXPECT_CALL(mock_gbm, gbm_bo_write(mock_gbm.fake_gbm.bo, NotNull(), _))
+        .Times(2);
+
+    cursor.move_to({10, 10});
+}
+
 TEST_F(MesaCursorTest, does_not_throw_when_images_are_too_large)
 {
     using namespace testing;
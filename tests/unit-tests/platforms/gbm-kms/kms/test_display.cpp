@@ -57,6 +57,8 @@
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
+#include <chrono>
+#include <future>
 #include <fcntl.h>
 
 namespace mg=mir::graphics;
@@ -894,3 +896,75 @@ TEST_F(MesaDisplayTest, can_change_configuration_metadata_without_invalidating_d
         EXPECT_THAT(display_buffer->transformation(), Eq(rotate_inverted));
     }
 }
+
+TEST_F(MesaDisplayTest, reconfigures_changed_outputs_without_holding_configuration_lock_over_removal)
+{
+    using namespace testing;
+
+    // Two outputs on one card, so that they can be placed in separate groups
+    mock_drm.reset(drm_device);
+    std::vector<drmModeModeInfo> modes{
+        mtd::FakeDRMResources::create_mode(1920, 1080, 138500, 2080, 1111, mtd::FakeDRMResources::PreferredMode)};
+    for (uint32_t i = 0; i != 2; ++i)
+    {
+        uint32_t const crtc_id{20 + i};
+        uint32_t const encoder_id{30 + i};
+        std::vector<uint32_t> possible_encoder_ids{encoder_id};
+
+        mock_drm.add_crtc(drm_device, crtc_id, modes[0]);
+        mock_drm.add_encoder(drm_device, encoder_id, crtc_id, 1u << i);
+        mock_drm.add_connector(
+            drm_device,
+            1 + i,
+            DRM_MODE_CONNECTOR_HDMIA,
+            DRM_MODE_CONNECTED,
+            encoder_id,
+            modes,
+            possible_encoder_ids,
+            mir::geometry::Size{150, 100});
+    }
+    mock_drm.prepare(drm_device);
+
+    auto display = create_display(create_platform());
+
+    auto const place_second_output_at = [&](mir::geometry::Point top_left)
+        {
+            auto config = display->configuration();
+            int index{0};
+            config->for_each_output(
+                [&](mg::UserDisplayConfigurationOutput& output)
+                {
+                    if (index++ == 1)
+                        output.top_left = top_left;
+                });
+            return config;
+        };
+
+    display->configure(*place_second_output_at({1920, 0}));
+
+    std::vector<mg::DisplaySyncGroup*> groups_before;
+    display->for_each_display_sync_group([&](mg::DisplaySyncGroup& group) { groups_before.push_back(&group); });
+    ASSERT_THAT(groups_before, SizeIs(2));
+
+    std::vector<mg::DisplaySyncGroup*> removed;
+    auto const applied = display->apply_keeping_unchanged_sync_groups(
+        *place_second_output_at({1920, 100}),
+        [&](mg::DisplaySyncGroup& group)
+        {
+            removed.push_back(&group);
+
+            // A compositing thread finishing with the group may need the display
+            auto const other_thread = std::async(std::launch::async, [&] { display->configuration(); });
+            EXPECT_THAT(other_thread.wait_for(std::chrono::seconds{5}), Eq(std::future_status::ready));
+        });
+
+    EXPECT_TRUE(applied);
+    ASSERT_THAT(removed, SizeIs(1));
+
+    std::vector<mg::DisplaySyncGroup*> groups_after;
+    display->for_each_display_sync_group([&](mg::DisplaySyncGroup& group) { groups_after.push_back(&group); });
+    EXPECT_THAT(groups_after, SizeIs(2));
+
+    auto const kept = groups_before[0] == removed[0] ? groups_before[1] : groups_before[0];
+    EXPECT_THAT(groups_after, Contains(kept));
+}
@@ -245,6 +245,66 @@ TEST_F(MesaDisplayBufferTest, frames_requiring_gl_are_not_throttled)
     }
 }
 
+TEST_F(MesaDisplayBufferTest, fullscreen_frames_engage_adaptive_sync)
+{
+    graphics::gbm::DisplayBuffer db(
+        graphics::gbm::BypassOption::allowed,
+        null_display_report(),
+        {mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    EXPECT_CALL(*mock_kms_output, set_adaptive_sync(true))
+        .WillRepeatedly(Return(true));
+
+    ASSERT_TRUE(db.overlay(bypassable_list));
+    db.post();
+}
+
+TEST_F(MesaDisplayBufferTest, composited_frames_do_not_engage_adaptive_sync)
+{
+    graphics::RenderableList non_fullscreen_list{
+        std::make_shared<FakeRenderable>(geometry::Rectangle{{12, 34}, {1, 1}})
+    };
+
+    graphics::gbm::DisplayBuffer db(
+        graphics::gbm::BypassOption::allowed,
+        null_display_report(),
+        {mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    EXPECT_CALL(*mock_kms_output, set_adaptive_sync(true)).Times(0);
+
+    ASSERT_FALSE(db.overlay(non_fullscreen_list));
+    db.post();
+}
+
+TEST_F(MesaDisplayBufferTest, adaptive_sync_bypass_is_not_throttled)
+{
+    ON_CALL(*mock_kms_output, set_adaptive_sync(true))
+        .WillByDefault(Return(true));
+
+    graphics::gbm::DisplayBuffer db(
+        graphics::gbm::BypassOption::allowed,
+        null_display_report(),
+        {mock_kms_output},
+        make_output_surface(),
+        display_area,
+        identity);
+
+    for (int frame = 0; frame < 5; ++frame)
+    {
+        ASSERT_TRUE(db.overlay(bypassable_list));
+        db.post();
+
+        // The display refreshes when the next frame is flipped, so there's nothing to wait for
+        ASSERT_EQ(0, db.recommended_sleep().count());
+    }
+}
+
 TEST_F(MesaDisplayBufferTest, bypass_buffer_only_referenced_once_by_db)
 {
     graphics::gbm::DisplayBuffer db(
@@ -341,6 +341,28 @@ TEST_F(GLRenderer, dont_set_scissor_test_when_unnecessary)
     renderer.render(renderable_list);
 }
 
+TEST_F(GLRenderer, uploads_vertices_of_whole_frame_to_one_buffer)
+{
+    GLuint const vertex_buffer = 7;
+    renderable_list.push_back(renderable);
+
+    ON_CALL(mock_gl, glGenBuffers(1, _))
+        .WillByDefault(SetArgPointee<1>(vertex_buffer));
+    EXPECT_CALL(mock_gl, glBufferData(GL_ARRAY_BUFFER, 8 * sizeof(mir::gl::Vertex), _, _))
+        .Times(1);
+    EXPECT_CALL(mock_gl, glDrawArrays(_, 0, 4));
+    EXPECT_CALL(mock_gl, glDrawArrays(_, 4, 4));
+    EXPECT_CALL(mock_gl, glVertexAttribPointer(_, _, _, _, _, _))
+        .Times(2);
+    EXPECT_CALL(mock_gl, glDisable(GL_BLEND))
+        .Times(1);
+
+    mrg::Renderer renderer(display_buffer);
+    renderer.render(renderable_list);
+
+    EXPECT_CALL(mock_gl, glDeleteBuffers(1, Pointee(vertex_buffer)));
+}
+
 
 TEST_F(GLRenderer, unchanged_viewport_avoids_gl_calls)
 {
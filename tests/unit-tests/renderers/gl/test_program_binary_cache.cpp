@@ -0,0 +1,237 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/renderers/gl/program_binary_cache.h"
+
+#include "mir_test_framework/temporary_environment_value.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <dirent.h>
+#include <signal.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <system_error>
+
+namespace mrg = mir::renderer::gl;
+namespace mtf = mir_test_framework;
+using namespace testing;
+
+namespace
+{
+struct ProgramBinaryCache : Test
+{
+    ProgramBinaryCache()
+    {
+        char tmp_name[] = "/tmp/mir_program_cache_XXXXXX";
+        if (mkdtemp(tmp_name) == nullptr)
+        {
+            throw std::system_error{errno, std::system_category(), "Failed to create temporary directory"};
+        }
+        directory = tmp_name;
+    }
+
+    ~ProgramBinaryCache()
+    {
+        for (auto const& file : cache_files())
+        {
+            unlink(file.c_str());
+        }
+        rmdir(directory.c_str());
+    }
+
+    auto cache_files() const -> std::vector<std::string>
+    {
+        std::vector<std::string> files;
+        if (auto const dir = opendir(directory.c_str()))
+        {
+            while (auto const entry = readdir(dir))
+            {
+                if (entry->d_name[0] != '.')
+                    files.push_back(directory + "/" + entry->d_name);
+            }
+            closedir(dir);
+        }
+        return files;
+    }
+
+    auto cache_size() const -> off_t
+    {
+        off_t size{0};
+        for (auto const& file : cache_files())
+        {
+            struct stat file_stat;
+            if (stat(file.c_str(), &file_stat) == 0)
+                size += file_stat.st_size;
+        }
+        return size;
+    }
+
+    static auto binary(char fill, size_t size = 64) -> mrg::ProgramBinaryCache::Binary
+    {
+        return {0x1234, std::vector<char>(size, fill)};
+    }
+
+    std::string directory;
+    std::string const key{"vendor\nrenderer\nversion\nshader source"};
+};
+}
+
+TEST_F(ProgramBinaryCache, misses_when_nothing_is_stored)
+{
+    mrg::ProgramBinaryCache cache{directory, mrg::ProgramBinaryCache::default_max_size};
+
+    EXPECT_THAT(cache.find(key), IsNull());
+}
+
+TEST_F(ProgramBinaryCache, finds_stored_binary)
+{
+    mrg::ProgramBinaryCache cache{directory, mrg::ProgramBinaryCache::default_max_size};
+    cache.store(key, binary('a'));
+
+    auto const found = cache.find(key);
+
+    ASSERT_THAT(found, NotNull());
+    EXPECT_THAT(found->format, Eq(0x1234u));
+    EXPECT_THAT(found->data, Eq(binary('a').data));
+}
+
+TEST_F(ProgramBinaryCache, finds_binary_stored_by_an_earlier_run)
+{
+    mrg::ProgramBinaryCache{directory, mrg::ProgramBinaryCache::default_max_size}.store(key, binary('a'));
+    mrg::ProgramBinaryCache cache{directory, mrg::ProgramBinaryCache::default_max_size};
+
+    auto const found = cache.find(key);
+
+    ASSERT_THAT(found, NotNull());
+    EXPECT_THAT(found->format, Eq(0x1234u));
+    EXPECT_THAT(found->data, Eq(binary('a').data));
+}
+
+TEST_F(ProgramBinaryCache, misses_binary_stored_for_another_key)
+{
+    mrg::ProgramBinaryCache{directory, mrg::ProgramBinaryCache::default_max_size}.store(key, binary('a'));
+    mrg::ProgramBinaryCache cache{directory, mrg::ProgramBinaryCache::default_max_size};
+
+    EXPECT_THAT(cache.find(key + " with changes"), IsNull());
+}
+
+TEST_F(ProgramBinaryCache, misses_corrupt_file)
+{
+    mrg::ProgramBinaryCache{directory, mrg::ProgramBinaryCache::default_max_size}.store(key, binary('a'));
+    auto const files = cache_files();
+    ASSERT_THAT(files, SizeIs(1));
+    std::ofstream{files.front(), std::ios::binary | std::ios::trunc} << "not a program binary";
+
+    mrg::ProgramBinaryCache cache{directory, mrg::ProgramBinaryCache::default_max_size};
+
+    EXPECT_THAT(cache.find(key), IsNull());
+}
+
+TEST_F(ProgramBinaryCache, misses_truncated_file)
+{
+    mrg::ProgramBinaryCache{directory, mrg::ProgramBinaryCache::default_max_size}.store(key, binary('a'));
+    auto const files = cache_files();
+    ASSERT_THAT(files, SizeIs(1));
+    ASSERT_THAT(truncate(files.front().c_str(), sizeof(uint32_t) + key.size()), Eq(0));
+
+    mrg::ProgramBinaryCache cache{directory, mrg::ProgramBinaryCache::default_max_size};
+
+    EXPECT_THAT(cache.find(key), IsNull());
+}
+
+TEST_F(ProgramBinaryCache, failed_write_keeps_previously_stored_binary)
+{
+    mrg::ProgramBinaryCache{directory, mrg::ProgramBinaryCache::default_max_size}.store(key, binary('a', 4096));
+
+    {
+        // Simulate a full disk: writes beyond 64 bytes fail with EFBIG
+        auto const old_handler = signal(SIGXFSZ, SIG_IGN);
+        rlimit old_limit;
+        getrlimit(RLIMIT_FSIZE, &old_limit);
+        rlimit limit{64, old_limit.rlim_max};
+        setrlimit(RLIMIT_FSIZE, &limit);
+
+        mrg::ProgramBinaryCache{directory, mrg::ProgramBinaryCache::default_max_size}.store(key, binary('b', 4096));
+
+        setrlimit(RLIMIT_FSIZE, &old_limit);
+        signal(SIGXFSZ, old_handler);
+    }
+
+    EXPECT_THAT(cache_files(), SizeIs(1));
+    mrg::ProgramBinaryCache cache{directory, mrg::ProgramBinaryCache::default_max_size};
+    auto const found = cache.find(key);
+    ASSERT_THAT(found, NotNull());
+    EXPECT_THAT(found->data, Eq(binary('a', 4096).data));
+}
+
+TEST_F(ProgramBinaryCache, found_binary_outlives_replacement)
+{
+    mrg::ProgramBinaryCache cache{directory, mrg::ProgramBinaryCache::default_max_size};
+    cache.store(key, binary('a'));
+
+    auto const found = cache.find(key);
+    cache.store(key, binary('b'));
+
+    EXPECT_THAT(found->data, Eq(binary('a').data));
+    EXPECT_THAT(cache.find(key)->data, Eq(binary('b').data));
+}
+
+TEST_F(ProgramBinaryCache, keeps_directory_within_max_size)
+{
+    auto const max_size = 1024;
+    mrg::ProgramBinaryCache cache{directory, max_size};
+
+    for (char fill = 'a'; fill != 'z'; ++fill)
+    {
+        cache.store(key + fill, binary(fill, 256));
+    }
+
+    EXPECT_THAT(cache_size(), Le(max_size));
+    EXPECT_THAT(cache_files(), Not(IsEmpty()));
+
+    // The most recent binary is never the one evicted
+    mrg::ProgramBinaryCache later{directory, max_size};
+    EXPECT_THAT(later.find(key + 'y'), NotNull());
+}
+
+TEST_F(ProgramBinaryCache, keeps_binaries_in_memory_without_a_directory)
+{
+    mrg::ProgramBinaryCache cache{"", mrg::ProgramBinaryCache::default_max_size};
+    cache.store(key, binary('a'));
+
+    EXPECT_THAT(cache.find(key), NotNull());
+}
+
+TEST(ProgramBinaryCacheDirectory, is_under_xdg_cache_home)
+{
+    mtf::TemporaryEnvironmentValue const disable{"MIR_DISABLE_GL_PROGRAM_CACHE", nullptr};
+    mtf::TemporaryEnvironmentValue const cache_home{"XDG_CACHE_HOME", "/some/cache"};
+
+    EXPECT_THAT(mrg::ProgramBinaryCache::default_directory(), Eq("/some/cache/mir"));
+}
+
+TEST(ProgramBinaryCacheDirectory, can_be_disabled)
+{
+    mtf::TemporaryEnvironmentValue const disable{"MIR_DISABLE_GL_PROGRAM_CACHE", "1"};
+    mtf::TemporaryEnvironmentValue const cache_home{"XDG_CACHE_HOME", "/some/cache"};
+
+    EXPECT_THAT(mrg::ProgramBinaryCache::default_directory(), IsEmpty());
+}
@@ -33,6 +33,7 @@
 #include "mir/test/display_config_matchers.h"
 #include "mir/test/doubles/fake_alarm_factory.h"
 #include "mir/test/doubles/mock_display_configuration_observer.h"
+#include "mir/test/doubles/null_display_sync_group.h"
 
 #include <mutex>
 #include <boost/throw_exception.hpp>
@@ -333,6 +334,38 @@ TEST_F(MediatingDisplayChangerTest, handles_hardware_change_when_display_buffers
     changer->configure_for_hardware_change(conf);
 }
 
+TEST_F(MediatingDisplayChangerTest, enables_new_outputs_without_stopping_compositor_if_display_keeps_unchanged_groups)
+{
+    using namespace testing;
+
+    auto conf = changer->base_configuration();
+    conf->for_each_output(
+        [](mg::UserDisplayConfigurationOutput& output)
+        {
+            output.used = true;
+        });
+
+    mtd::NullDisplaySyncGroup removed_group;
+
+    EXPECT_CALL(mock_compositor, stop()).Times(0);
+    EXPECT_CALL(mock_display, configure(_)).Times(0);
+    EXPECT_CALL(mock_compositor, start()).Times(0);
+
+    InSequence s;
+    EXPECT_CALL(mock_conf_policy, apply_to(Ref(*conf)));
+    EXPECT_CALL(mock_display, apply_keeping_unchanged_sync_groups(Ref(*conf), _))
+        .WillOnce(Invoke(
+            [&](auto const&, auto const& before_removal)
+            {
+                before_removal(removed_group);
+                return true;
+            }));
+    EXPECT_CALL(mock_compositor, stop_compositing_to(Ref(removed_group)));
+    EXPECT_CALL(mock_compositor, start_compositing_to_new_groups());
+
+    changer->configure_for_hardware_change(conf);
+}
+
 TEST_F(MediatingDisplayChangerTest, hardware_change_doesnt_apply_base_config_if_per_session_config_is_active)
 {
     using namespace testing;
@@ -84,6 +84,7 @@ struct MockSceneObserver : public ms::Observer
     MOCK_METHOD1(surface_removed, void(std::shared_ptr<ms::Surface> const&));
     MOCK_METHOD1(surfaces_reordered, void(ms::SurfaceSet const&));
     MOCK_METHOD0(scene_changed, void());
+    MOCK_METHOD1(scene_damaged, void(geom::Rectangle const&));
 
     MOCK_METHOD1(surface_exists, void(std::shared_ptr<ms::Surface> const&));
     MOCK_METHOD0(end_observation, void());
@@ -952,6 +953,22 @@ TEST_F(SurfaceStack, scene_observers_notified_of_generic_scene_change)
     stack.emit_scene_changed();
 }
 
+TEST_F(SurfaceStack, scene_observers_notified_of_scene_damage)
+{
+    MockSceneObserver o1, o2;
+    geom::Rectangle const damage{{10, 20}, {30, 40}};
+
+    EXPECT_CALL(o1, scene_damaged(damage)).Times(1);
+    EXPECT_CALL(o2, scene_damaged(damage)).Times(1);
+    EXPECT_CALL(o1, scene_changed()).Times(0);
+    EXPECT_CALL(o2, scene_changed()).Times(0);
+
+    stack.add_observer(mt::fake_shared(o1));
+    stack.add_observer(mt::fake_shared(o2));
+
+    stack.emit_scene_damaged(damage);
+}
+
 TEST_F(SurfaceStack, for_each_enumerates_all_input_surfaces)
 {
     using namespace ::testing;
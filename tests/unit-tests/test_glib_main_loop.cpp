@@ -715,6 +715,47 @@ TEST_F(GLibMainLoopTest, dispatches_actions_resumed_from_within_another_action)
     EXPECT_THAT(actions, ElementsAre(1, 0));
 }
 
+TEST_F(GLibMainLoopTest, keeps_order_of_actions_resumed_from_within_another_action)
+{
+    using namespace testing;
+
+    std::vector<int> actions;
+    void const* const owner1_ptr{&actions};
+    int const owner2{0};
+
+    ml.enqueue(
+        owner1_ptr,
+        [&]
+        {
+            int const id = 0;
+            actions.push_back(id);
+        });
+
+    ml.enqueue(
+        &owner2,
+        [&]
+        {
+            int const id = 1;
+            actions.push_back(id);
+            ml.resume_processing_for(owner1_ptr);
+        });
+
+    ml.enqueue(
+        owner1_ptr,
+        [&]
+        {
+            int const id = 2;
+            actions.push_back(id);
+            ml.stop();
+        });
+
+    ml.pause_processing_for(owner1_ptr);
+
+    ml.run();
+
+    EXPECT_THAT(actions, ElementsAre(1, 0, 2));
+}
+
 TEST_F(GLibMainLoopTest, handles_enqueue_from_within_action)
 {
     using namespace testing;
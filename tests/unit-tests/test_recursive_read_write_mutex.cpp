@@ -174,3 +174,137 @@ TEST_F(RecursiveReadWriteMutex, read_lock_waits_for_write_locks_on_other_threads
 
     threads.push_back(std::thread{writer_function});
 }
+
+TEST_F(RecursiveReadWriteMutex, recursive_read_lock_does_not_wait_for_pending_write_lock)
+{
+    auto const reader_function =
+        [&]{
+            mutex.read_lock();
+            read_and_write_barrier.ready();
+
+            // Give the writer a chance to start waiting
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+            mutex.read_lock();
+            notify_read_locked();
+
+            readonly_barrier.ready();
+
+            notify_read_unlocking();
+            mutex.read_unlock();
+            mutex.read_unlock();
+        };
+
+    auto const writer_function =
+        [&]{
+            read_and_write_barrier.ready();
+
+            mutex.write_lock();
+            notify_write_locked();
+            mutex.write_unlock();
+        };
+
+    InSequence seq;
+
+    EXPECT_CALL(*this, notify_read_locked()).Times(reader_threads);
+    EXPECT_CALL(*this, notify_read_unlocking()).Times(reader_threads);
+    EXPECT_CALL(*this, notify_write_locked()).Times(1);
+
+    for (auto i = 0U; i != reader_threads; ++i)
+        threads.push_back(std::thread{reader_function});
+
+    threads.push_back(std::thread{writer_function});
+}
+
+TEST_F(RecursiveReadWriteMutex, read_lock_can_be_upgraded_while_another_thread_waits_to_write)
+{
+    mt::Barrier reader_and_writer_barrier{2};
+
+    auto const upgrading_reader_function =
+        [&]{
+            mutex.read_lock();
+            reader_and_writer_barrier.ready();
+
+            // Give the writer a chance to start waiting for our read lock
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+            mutex.write_lock();
+            notify_write_locked();
+            mutex.write_unlock();
+
+            notify_read_unlocking();
+            mutex.read_unlock();
+        };
+
+    auto const writer_function =
+        [&]{
+            reader_and_writer_barrier.ready();
+
+            mutex.write_lock();
+            notify_write_locked();
+            mutex.write_unlock();
+        };
+
+    InSequence seq;
+
+    EXPECT_CALL(*this, notify_write_locked()).Times(1);
+    EXPECT_CALL(*this, notify_read_unlocking()).Times(1);
+    EXPECT_CALL(*this, notify_write_locked()).Times(1);
+
+    threads.push_back(std::thread{upgrading_reader_function});
+    threads.push_back(std::thread{writer_function});
+    // The barrier is local, so don't leave the threads to TearDown()
+    for (auto& thread : threads)
+        thread.join();
+}
+
+TEST_F(RecursiveReadWriteMutex, read_lock_does_not_wait_for_pending_write_lock)
+{
+    mt::Barrier first_reader_and_writer_barrier{2};
+    mt::Barrier readers_barrier{2};
+
+    auto const first_reader_function =
+        [&]{
+            mutex.read_lock();
+            first_reader_and_writer_barrier.ready();
+
+            // Hold the read lock until the second reader has its own
+            readers_barrier.ready();
+
+            notify_read_unlocking();
+            mutex.read_unlock();
+        };
+
+    auto const second_reader_function =
+        [&]{
+            // Give the writer a chance to start waiting for the first reader
+            std::this_thread::sleep_for(std::chrono::milliseconds{10});
+
+            mutex.read_lock();
+            notify_read_locked();
+            mutex.read_unlock();
+
+            readers_barrier.ready();
+        };
+
+    auto const writer_function =
+        [&]{
+            first_reader_and_writer_barrier.ready();
+
+            mutex.write_lock();
+            notify_write_locked();
+            mutex.write_unlock();
+        };
+
+    InSequence seq;
+
+    EXPECT_CALL(*this, notify_read_locked()).Times(1);
+    EXPECT_CALL(*this, notify_read_unlocking()).Times(1);
+    EXPECT_CALL(*this, notify_write_locked()).Times(1);
+
+    threads.push_back(std::thread{first_reader_function});
+    threads.push_back(std::thread{writer_function});
+    threads.push_back(std::thread{second_reader_function});
+    for (auto& thread : threads)
+        thread.join();
+}
@@ -157,3 +157,26 @@ TEST_F(ThreadSafeListTest, clears_all_elements)
 
     EXPECT_THAT(elements_seen, Eq(0));
 }
+
+TEST_F(ThreadSafeListTest, can_add_element_while_iterating)
+{
+    using namespace testing;
+
+    std::vector<Element> elements_seen;
+
+    list.add(element1);
+
+    list.for_each(
+        [&] (Element const&)
+        {
+            list.add(element2);
+        });
+
+    list.for_each(
+        [&] (Element const& element)
+        {
+            elements_seen.push_back(element);
+        });
+
+    EXPECT_THAT(elements_seen, ElementsAre(element1, element2));
+}
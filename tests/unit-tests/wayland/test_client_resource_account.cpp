@@ -0,0 +1,281 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "src/server/frontend_wayland/client_resource_account.h"
+#include "mir/test/doubles/advanceable_clock.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+struct ClientResourceAccountTest : Test
+{
+    auto account_with(mf::ClientResourceLimits const& limits) -> std::unique_ptr<mf::ClientResourceAccount>
+    {
+        return std::make_unique<mf::ClientResourceAccount>(
+            limits,
+            clock,
+            [this](char const* resource, size_t value, size_t limit)
+            {
+                exceeded_resources.push_back(resource);
+                exceeded_values.push_back(value);
+                exceeded_limits.push_back(limit);
+            });
+    }
+
+    std::shared_ptr<mtd::AdvanceableClock> const clock{std::make_shared<mtd::AdvanceableClock>()};
+    std::vector<std::string> exceeded_resources;
+    std::vector<size_t> exceeded_values;
+    std::vector<size_t> exceeded_limits;
+};
+}
+
+TEST_F(ClientResourceAccountTest, counts_surfaces)
+{
+    auto const account = account_with({});
+
+    account->surface_created();
+    account->surface_created();
+    account->surface_created();
+    account->surface_destroyed();
+
+    EXPECT_THAT(account->usage().surfaces, Eq(2u));
+}
+
+TEST_F(ClientResourceAccountTest, counts_pending_frame_callbacks)
+{
+    auto const account = account_with({});
+
+    account->frame_callback_requested();
+    account->frame_callback_requested();
+    account->frame_callback_done();
+
+    EXPECT_THAT(account->usage().pending_frame_callbacks, Eq(1u));
+}
+
+TEST_F(ClientResourceAccountTest, counts_do_not_go_below_zero)
+{
+    auto const account = account_with({});
+
+    account->surface_destroyed();
+    account->frame_callback_done();
+    account->buffer_memory_changed(4096, 0);
+
+    EXPECT_THAT(account->usage().surfaces, Eq(0u));
+    EXPECT_THAT(account->usage().pending_frame_callbacks, Eq(0u));
+    EXPECT_THAT(account->usage().buffer_memory, Eq(0u));
+}
+
+TEST_F(ClientResourceAccountTest, tracks_buffer_memory_as_buffers_change)
+{
+    auto const account = account_with({});
+
+    account->buffer_memory_changed(0, 4096);
+    account->buffer_memory_changed(0, 1024);
+    account->buffer_memory_changed(4096, 2048);
+
+    EXPECT_THAT(account->usage().buffer_memory, Eq(3072u));
+}
+
+TEST_F(ClientResourceAccountTest, counts_commits_in_the_current_second)
+{
+    auto const account = account_with({});
+
+    account->surface_committed();
+    account->surface_committed();
+    clock->advance_by(999ms);
+    account->surface_committed();
+
+    EXPECT_THAT(account->usage().commits_per_second, Eq(3u));
+
+    clock->advance_by(1ms);
+    account->surface_committed();
+
+    EXPECT_THAT(account->usage().commits_per_second, Eq(1u));
+}
+
+TEST_F(ClientResourceAccountTest, accumulates_dispatched_requests)
+{
+    auto const account = account_with({});
+
+    account->requests_dispatched(3, 2ms);
+    account->requests_dispatched(5, 1ms);
+
+    EXPECT_THAT(account->usage().requests, Eq(8u));
+    EXPECT_THAT(account->usage().wayland_thread_time, Eq(3ms));
+}
+
+TEST_F(ClientResourceAccountTest, no_limit_is_exceeded_when_unlimited)
+{
+    auto const account = account_with({});
+
+    for (auto i = 0; i != 1000; ++i)
+    {
+        account->surface_created();
+        account->frame_callback_requested();
+        account->surface_committed();
+        account->buffer_memory_changed(0, 1024*1024);
+    }
+
+    EXPECT_FALSE(account->exceeded());
+    EXPECT_THAT(exceeded_resources, IsEmpty());
+}
+
+TEST_F(ClientResourceAccountTest, going_over_surface_limit_is_reported)
+{
+    mf::ClientResourceLimits limits;
+    limits.surfaces = 2;
+    auto const account = account_with(limits);
+
+    account->surface_created();
+    account->surface_created();
+    EXPECT_FALSE(account->exceeded());
+
+    account->surface_created();
+    EXPECT_TRUE(account->exceeded());
+    EXPECT_THAT(exceeded_resources, ElementsAre("surfaces"));
+    EXPECT_THAT(exceeded_values, ElementsAre(3u));
+    EXPECT_THAT(exceeded_limits, ElementsAre(2u));
+}
+
+TEST_F(ClientResourceAccountTest, destroyed_surfaces_do_not_count_towards_surface_limit)
+{
+    mf::ClientResourceLimits limits;
+    limits.surfaces = 1;
+    auto const account = account_with(limits);
+
+    for (auto i = 0; i != 10; ++i)
+    {
+        account->surface_created();
+        account->surface_destroyed();
+    }
+
+    EXPECT_FALSE(account->exceeded());
+}
+
+TEST_F(ClientResourceAccountTest, going_over_pending_frame_callback_limit_is_reported)
+{
+    mf::ClientResourceLimits limits;
+    limits.pending_frame_callbacks = 1;
+    auto const account = account_with(limits);
+
+    account->frame_callback_requested();
+    account->frame_callback_done();
+    account->frame_callback_requested();
+    EXPECT_FALSE(account->exceeded());
+
+    account->frame_callback_requested();
+    EXPECT_THAT(exceeded_resources, ElementsAre("pending frame callbacks"));
+    EXPECT_THAT(exceeded_values, ElementsAre(2u));
+}
+
+TEST_F(ClientResourceAccountTest, going_over_commit_rate_limit_is_reported)
+{
+    mf::ClientResourceLimits limits;
+    limits.commits_per_second = 60;
+    auto const account = account_with(limits);
+
+    for (auto i = 0; i != 60; ++i)
+    {
+        account->surface_committed();
+    }
+    EXPECT_FALSE(account->exceeded());
+
+    account->surface_committed();
+    EXPECT_THAT(exceeded_resources, ElementsAre("commits per second"));
+    EXPECT_THAT(exceeded_values, ElementsAre(61u));
+}
+
+TEST_F(ClientResourceAccountTest, commits_spread_over_seconds_do_not_exceed_commit_rate_limit)
+{
+    mf::ClientResourceLimits limits;
+    limits.commits_per_second = 60;
+    auto const account = account_with(limits);
+
+    for (auto i = 0; i != 600; ++i)
+    {
+        account->surface_committed();
+        clock->advance_by(33ms);
+    }
+
+    EXPECT_FALSE(account->exceeded());
+}
+
+TEST_F(ClientResourceAccountTest, going_over_buffer_memory_limit_is_reported)
+{
+    mf::ClientResourceLimits limits;
+    limits.buffer_memory = 8192;
+    auto const account = account_with(limits);
+
+    account->buffer_memory_changed(0, 4096);
+    account->buffer_memory_changed(0, 4096);
+    EXPECT_FALSE(account->exceeded());
+
+    account->buffer_memory_changed(0, 1);
+    EXPECT_THAT(exceeded_resources, ElementsAre("bytes of buffers"));
+    EXPECT_THAT(exceeded_values, ElementsAre(8193u));
+}
+
+TEST_F(ClientResourceAccountTest, replacing_buffers_with_no_larger_ones_does_not_exceed_buffer_memory_limit)
+{
+    mf::ClientResourceLimits limits;
+    limits.buffer_memory = 8192;
+    auto const account = account_with(limits);
+
+    account->buffer_memory_changed(0, 8192);
+    for (auto i = 0; i != 10; ++i)
+    {
+        account->buffer_memory_changed(8192, 8192);
+    }
+
+    EXPECT_FALSE(account->exceeded());
+}
+
+TEST_F(ClientResourceAccountTest, only_the_first_limit_exceeded_is_reported)
+{
+    mf::ClientResourceLimits limits;
+    limits.surfaces = 1;
+    limits.pending_frame_callbacks = 1;
+    auto const account = account_with(limits);
+
+    account->surface_created();
+    account->surface_created();
+    account->surface_created();
+    account->frame_callback_requested();
+    account->frame_callback_requested();
+
+    EXPECT_THAT(exceeded_resources, ElementsAre("surfaces"));
+}
+
+TEST_F(ClientResourceAccountTest, usage_is_still_counted_after_a_limit_is_exceeded)
+{
+    mf::ClientResourceLimits limits;
+    limits.surfaces = 1;
+    auto const account = account_with(limits);
+
+    account->surface_created();
+    account->surface_created();
+    account->surface_created();
+
+    EXPECT_THAT(account->usage().surfaces, Eq(3u));
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "src/server/frontend_wayland/cursor_image_cache.h"
+#include "mir/graphics/cursor_image.h"
+#include "mir/test/doubles/mock_surface.h"
+#include "mir/test/doubles/stub_buffer.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+namespace mg = mir::graphics;
+namespace mtd = mir::test::doubles;
+namespace geom = mir::geometry;
+
+using namespace testing;
+
+namespace
+{
+/// A 2x2 cursor buffer, every byte of which is \a fill
+auto cursor_buffer(unsigned char fill) -> std::shared_ptr<mtd::StubBuffer>
+{
+    auto const buffer = std::make_shared<mtd::StubBuffer>(
+        mg::BufferProperties{geom::Size{2, 2}, mir_pixel_format_argb_8888, mg::BufferUsage::software});
+    std::fill(buffer->written_pixels.begin(), buffer->written_pixels.end(), fill);
+    return buffer;
+}
+
+struct CursorSurface : mtd::MockSurface
+{
+    CursorSurface()
+    {
+        ON_CALL(*this, set_cursor_image(_))
+            .WillByDefault(SaveArg<0>(&image));
+        ON_CALL(*this, cursor_image())
+            .WillByDefault(ReturnPointee(&image));
+    }
+
+    MOCK_METHOD1(set_cursor_image, void(std::shared_ptr<mg::CursorImage> const&));
+    MOCK_CONST_METHOD0(cursor_image, std::shared_ptr<mg::CursorImage>());
+
+    std::shared_ptr<mg::CursorImage> image;
+};
+
+struct CursorImageCache : Test
+{
+    geom::Displacement const hotspot{1, 1};
+    mf::CursorImageCache cache;
+    /// Gives every image the same hash
+    mf::CursorImageCache colliding_cache{[](auto&, auto const&) { return size_t{42}; }};
+};
+}
+
+TEST_F(CursorImageCache, identical_buffers_give_the_same_image)
+{
+    auto const image = cache.image_of(cursor_buffer(0x7f), hotspot);
+
+    EXPECT_THAT(cache.image_of(cursor_buffer(0x7f), hotspot), Eq(image));
+}
+
+TEST_F(CursorImageCache, different_pixels_give_different_images)
+{
+    auto const image = cache.image_of(cursor_buffer(0x7f), hotspot);
+
+    EXPECT_THAT(cache.image_of(cursor_buffer(0x80), hotspot), Ne(image));
+}
+
+TEST_F(CursorImageCache, different_hotspots_give_different_images)
+{
+    auto const image = cache.image_of(cursor_buffer(0x7f), hotspot);
+
+    EXPECT_THAT(cache.image_of(cursor_buffer(0x7f), geom::Displacement{0, 0}), Ne(image));
+}
+
+TEST_F(CursorImageCache, image_is_a_copy_of_the_buffer)
+{
+    auto const buffer = cursor_buffer(0x7f);
+    auto const image = cache.image_of(buffer, hotspot);
+    std::fill(buffer->written_pixels.begin(), buffer->written_pixels.end(), 0x80);
+
+    EXPECT_THAT(image->size(), Eq(geom::Size{2, 2}));
+    EXPECT_THAT(image->hotspot(), Eq(hotspot));
+    EXPECT_THAT(static_cast<unsigned char const*>(image->as_argb_8888())[0], Eq(0x7f));
+}
+
+TEST_F(CursorImageCache, hash_collision_with_different_pixels_is_not_reused)
+{
+    auto const image = colliding_cache.image_of(cursor_buffer(0x7f), hotspot);
+    auto const colliding_image = colliding_cache.image_of(cursor_buffer(0x80), hotspot);
+
+    EXPECT_THAT(colliding_image, Ne(image));
+    EXPECT_THAT(static_cast<unsigned char const*>(colliding_image->as_argb_8888())[0], Eq(0x80));
+}
+
+TEST_F(CursorImageCache, hash_collision_with_identical_pixels_is_reused)
+{
+    auto const image = colliding_cache.image_of(cursor_buffer(0x7f), hotspot);
+
+    EXPECT_THAT(colliding_cache.image_of(cursor_buffer(0x7f), hotspot), Eq(image));
+}
+
+TEST_F(CursorImageCache, image_is_not_kept_alive_by_the_cache)
+{
+    std::weak_ptr<mg::CursorImage> const image = cache.image_of(cursor_buffer(0x7f), hotspot);
+
+    EXPECT_TRUE(image.expired());
+}
+
+TEST_F(CursorImageCache, applying_sets_the_surface_cursor_image)
+{
+    NiceMock<CursorSurface> surface;
+
+    EXPECT_CALL(surface, set_cursor_image(NotNull()));
+
+    cache.apply_to(surface, cursor_buffer(0x7f), hotspot);
+}
+
+TEST_F(CursorImageCache, reapplying_an_identical_buffer_does_not_set_the_surface_cursor_image)
+{
+    NiceMock<CursorSurface> surface;
+    cache.apply_to(surface, cursor_buffer(0x7f), hotspot);
+    auto const image = surface.image;
+
+    EXPECT_CALL(surface, set_cursor_image(_)).Times(0);
+
+    cache.apply_to(surface, cursor_buffer(0x7f), hotspot);
+    EXPECT_THAT(surface.image, Eq(image));
+}
+
+TEST_F(CursorImageCache, applying_a_different_buffer_sets_the_surface_cursor_image)
+{
+    NiceMock<CursorSurface> surface;
+    cache.apply_to(surface, cursor_buffer(0x7f), hotspot);
+    auto const image = surface.image;
+
+    EXPECT_CALL(surface, set_cursor_image(Ne(image)));
+
+    cache.apply_to(surface, cursor_buffer(0x80), hotspot);
+}
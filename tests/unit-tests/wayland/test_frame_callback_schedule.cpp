@@ -0,0 +1,255 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "src/server/frontend_wayland/frame_callback_schedule.h"
+#include "src/server/frontend_wayland/frame_executor.h"
+#include "mir/test/doubles/fake_alarm_factory.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+namespace mf = mir::frontend;
+namespace mtd = mir::test::doubles;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+auto const frame_interval = 16ms;
+auto const occluded_interval = 1000ms;
+
+/// A surface's frame callbacks, as far as its FrameCallbackSchedule can see
+struct FakeSurface
+{
+    FakeSurface(std::shared_ptr<mir::Executor> const& frame, std::shared_ptr<mir::Executor> const& occluded)
+        : schedule{
+            frame,
+            occluded,
+            [this]() { return pending; },
+            [this]() { if (pending) { pending = false; ++sent; } }}
+    {
+    }
+
+    bool pending{false};
+    int sent{0};
+    mf::FrameCallbackSchedule schedule;
+};
+
+struct FrameCallbackScheduleTest : Test
+{
+    mtd::FakeAlarmFactory alarm_factory;
+    std::shared_ptr<mf::FrameExecutor> const frame_executor{
+        std::make_shared<mf::FrameExecutor>(alarm_factory)};
+    std::shared_ptr<mf::FrameExecutor> const occluded_executor{
+        std::make_shared<mf::FrameExecutor>(alarm_factory, occluded_interval)};
+    FakeSurface surface{frame_executor, occluded_executor};
+
+    // FakeAlarms fire once the clock is past their deadline
+    void advance_past(std::chrono::milliseconds interval)
+    {
+        alarm_factory.advance_by(interval + 1ms);
+    }
+};
+}
+
+TEST_F(FrameCallbackScheduleTest, surfaces_start_visible)
+{
+    EXPECT_FALSE(surface.schedule.occluded());
+}
+
+TEST_F(FrameCallbackScheduleTest, visible_commit_without_buffer_is_called_back_after_a_frame)
+{
+    surface.pending = true;
+    surface.schedule.committed_without_buffer();
+
+    EXPECT_THAT(surface.sent, Eq(0));
+    advance_past(frame_interval);
+    EXPECT_THAT(surface.sent, Eq(1));
+}
+
+TEST_F(FrameCallbackScheduleTest, visible_commit_with_buffer_waits_for_the_buffer_to_be_consumed)
+{
+    surface.pending = true;
+    surface.schedule.committed_buffer();
+
+    advance_past(occluded_interval);
+    EXPECT_THAT(surface.sent, Eq(0));
+}
+
+TEST_F(FrameCallbackScheduleTest, occluded_commit_without_buffer_is_throttled)
+{
+    surface.schedule.set_occluded(true);
+    surface.pending = true;
+    surface.schedule.committed_without_buffer();
+
+    advance_past(frame_interval);
+    EXPECT_THAT(surface.sent, Eq(0));
+
+    alarm_factory.advance_by(occluded_interval);
+    EXPECT_THAT(surface.sent, Eq(1));
+}
+
+TEST_F(FrameCallbackScheduleTest, occluded_commit_with_buffer_is_called_back_on_the_throttled_schedule)
+{
+    surface.schedule.set_occluded(true);
+    surface.pending = true;
+    surface.schedule.committed_buffer();
+
+    advance_past(frame_interval);
+    EXPECT_THAT(surface.sent, Eq(0));
+
+    alarm_factory.advance_by(occluded_interval);
+    EXPECT_THAT(surface.sent, Eq(1));
+}
+
+TEST_F(FrameCallbackScheduleTest, occluded_surface_gets_a_callback_per_interval_however_often_it_commits)
+{
+    surface.schedule.set_occluded(true);
+
+    for (auto i = 0; i != 10 * 60; ++i)
+    {
+        surface.pending = true;
+        surface.schedule.committed_without_buffer();
+        alarm_factory.advance_by(frame_interval);
+    }
+
+    // 10 seconds of 60Hz commits
+    EXPECT_THAT(surface.sent, AllOf(Ge(9), Le(10)));
+}
+
+TEST_F(FrameCallbackScheduleTest, without_occluded_executor_occluded_callbacks_are_held)
+{
+    FakeSurface held_surface{frame_executor, nullptr};
+    held_surface.schedule.set_occluded(true);
+    held_surface.pending = true;
+    held_surface.schedule.committed_without_buffer();
+    held_surface.schedule.committed_buffer();
+
+    advance_past(10 * occluded_interval);
+    EXPECT_THAT(held_surface.sent, Eq(0));
+}
+
+TEST_F(FrameCallbackScheduleTest, pending_callbacks_are_released_when_surface_becomes_visible)
+{
+    surface.schedule.set_occluded(true);
+    surface.pending = true;
+    surface.schedule.committed_without_buffer();
+
+    surface.schedule.set_occluded(false);
+    advance_past(frame_interval);
+
+    EXPECT_THAT(surface.sent, Eq(1));
+}
+
+TEST_F(FrameCallbackScheduleTest, held_callbacks_are_released_when_surface_becomes_visible)
+{
+    FakeSurface held_surface{frame_executor, nullptr};
+    held_surface.schedule.set_occluded(true);
+    held_surface.pending = true;
+    held_surface.schedule.committed_buffer();
+
+    held_surface.schedule.set_occluded(false);
+    advance_past(frame_interval);
+
+    EXPECT_THAT(held_surface.sent, Eq(1));
+}
+
+TEST_F(FrameCallbackScheduleTest, pending_callbacks_are_throttled_when_surface_becomes_occluded)
+{
+    surface.pending = true;
+    surface.schedule.committed_buffer();
+
+    surface.schedule.set_occluded(true);
+    advance_past(frame_interval);
+    EXPECT_THAT(surface.sent, Eq(0));
+
+    alarm_factory.advance_by(occluded_interval);
+    EXPECT_THAT(surface.sent, Eq(1));
+}
+
+TEST_F(FrameCallbackScheduleTest, nothing_is_scheduled_when_occlusion_changes_without_pending_callbacks)
+{
+    auto const wakeups_before = alarm_factory.wakeup_count();
+
+    surface.schedule.set_occluded(true);
+    surface.schedule.set_occluded(false);
+    advance_past(occluded_interval);
+
+    EXPECT_THAT(alarm_factory.wakeup_count(), Eq(wakeups_before));
+}
+
+TEST_F(FrameCallbackScheduleTest, setting_the_same_occlusion_again_does_not_reschedule)
+{
+    surface.schedule.set_occluded(true);
+    surface.pending = true;
+    surface.schedule.set_occluded(true);
+
+    advance_past(occluded_interval);
+    EXPECT_THAT(surface.sent, Eq(0));
+}
+
+TEST_F(FrameCallbackScheduleTest, added_child_takes_the_occlusion_of_its_parent)
+{
+    FakeSurface child{frame_executor, occluded_executor};
+    surface.schedule.set_occluded(true);
+
+    surface.schedule.add_child(&child.schedule);
+
+    EXPECT_TRUE(child.schedule.occluded());
+}
+
+TEST_F(FrameCallbackScheduleTest, occlusion_propagates_to_children_and_grandchildren)
+{
+    FakeSurface child{frame_executor, occluded_executor};
+    FakeSurface grandchild{frame_executor, occluded_executor};
+    surface.schedule.add_child(&child.schedule);
+    child.schedule.add_child(&grandchild.schedule);
+
+    surface.schedule.set_occluded(true);
+    EXPECT_TRUE(child.schedule.occluded());
+    EXPECT_TRUE(grandchild.schedule.occluded());
+
+    surface.schedule.set_occluded(false);
+    EXPECT_FALSE(child.schedule.occluded());
+    EXPECT_FALSE(grandchild.schedule.occluded());
+}
+
+TEST_F(FrameCallbackScheduleTest, childrens_pending_callbacks_are_released_when_parent_becomes_visible)
+{
+    FakeSurface child{frame_executor, nullptr};
+    surface.schedule.add_child(&child.schedule);
+    surface.schedule.set_occluded(true);
+    child.pending = true;
+    child.schedule.committed_without_buffer();
+
+    surface.schedule.set_occluded(false);
+    advance_past(frame_interval);
+
+    EXPECT_THAT(child.sent, Eq(1));
+}
+
+TEST_F(FrameCallbackScheduleTest, removed_child_no_longer_follows_its_parent)
+{
+    FakeSurface child{frame_executor, occluded_executor};
+    surface.schedule.add_child(&child.schedule);
+    surface.schedule.remove_child(&child.schedule);
+
+    surface.schedule.set_occluded(true);
+
+    EXPECT_FALSE(child.schedule.occluded());
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright © 2021 Canonical Ltd.
+ *
+ * This program is free software: you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 or 3,
+ * as published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program. If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "src/server/frontend_wayland/pending_input_queue.h"
+#include "mir/events/event_builders.h"
+#include "mir_toolkit/events/event.h"
+
+#include <gtest/gtest.h>
+#include <gmock/gmock.h>
+
+#include <atomic>
+#include <thread>
+
+namespace mf = mir::frontend;
+namespace mev = mir::events;
+
+using namespace testing;
+using namespace std::chrono_literals;
+
+namespace
+{
+/// A key event identified by its timestamp
+auto key_event(int n) -> mf::PendingInputQueue::EventUPtr
+{
+    return mev::make_key_event(
+        MirInputDeviceId(), std::chrono::nanoseconds{n}, std::vector<uint8_t>{}, mir_keyboard_action_down,
+        xkb_keysym_t(), 0, MirInputEventModifiers());
+}
+
+auto id_of(MirEvent const* event) -> int
+{
+    return mir_input_event_get_event_time(mir_event_get_input_event(event));
+}
+
+struct PendingInputQueueTest : Test
+{
+    /// The ids of the events the next drain() hands over
+    auto drain() -> std::vector<int>
+    {
+        std::vector<int> handled;
+        queue.drain([&](MirEvent const* event) { handled.push_back(id_of(event)); });
+        return handled;
+    }
+
+    mf::PendingInputQueue queue;
+};
+}
+
+TEST_F(PendingInputQueueTest, first_event_needs_a_drain)
+{
+    EXPECT_THAT(queue.push(key_event(1)), Eq(true));
+}
+
+TEST_F(PendingInputQueueTest, events_queued_behind_a_pending_drain_do_not_need_another)
+{
+    queue.push(key_event(1));
+
+    EXPECT_THAT(queue.push(key_event(2)), Eq(false));
+    EXPECT_THAT(queue.push(key_event(3)), Eq(false));
+}
+
+TEST_F(PendingInputQueueTest, drain_hands_over_the_whole_batch_in_order)
+{
+    queue.push(key_event(1));
+    queue.push(key_event(2));
+    queue.push(key_event(3));
+
+    EXPECT_THAT(drain(), ElementsAre(1, 2, 3));
+}
+
+TEST_F(PendingInputQueueTest, drained_events_are_not_handed_over_again)
+{
+    queue.push(key_event(1));
+    drain();
+
+    EXPECT_THAT(drain(), IsEmpty());
+}
+
+TEST_F(PendingInputQueueTest, event_after_drain_needs_another_drain)
+{
+    queue.push(key_event(1));
+    drain();
+
+    EXPECT_THAT(queue.push(key_event(2)), Eq(true));
+    EXPECT_THAT(drain(), ElementsAre(2));
+}
+
+TEST_F(PendingInputQueueTest, event_pushed_during_drain_is_left_for_the_next_drain)
+{
+    queue.push(key_event(1));
+    queue.push(key_event(2));
+
+    std::vector<int> handled;
+    std::vector<bool> needed_drain;
+    queue.drain(
+        [&](MirEvent const* event)
+        {
+            handled.push_back(id_of(event));
+            needed_drain.push_back(queue.push(key_event(id_of(event) + 10)));
+        });
+
+    EXPECT_THAT(handled, ElementsAre(1, 2));
+    EXPECT_THAT(needed_drain, ElementsAre(true, false));
+    EXPECT_THAT(drain(), ElementsAre(11, 12));
+}
+
+TEST_F(PendingInputQueueTest, events_pushed_from_another_thread_are_each_handed_over_once_in_order)
+{
+    size_t const event_count = 10000;
+    std::atomic<int> drains_needed{0};
+
+    std::thread producer{
+        [&]
+        {
+            for (size_t i = 1; i <= event_count; ++i)
+            {
+                if (queue.push(key_event(i)))
+                {
+                    ++drains_needed;
+                }
+            }
+        }};
+
+    std::vector<int> handled;
+    auto drain_as_needed = [&]
+        {
+            while (drains_needed > 0)
+            {
+                --drains_needed;
+                for (auto const id : drain())
+                {
+                    handled.push_back(id);
+                }
+            }
+        };
+
+    // Every event is behind a push that needed a drain, so this finishes once they have all been handed over
+    while (handled.size() < event_count)
+    {
+        drain_as_needed();
+        std::this_thread::yield();
+    }
+    producer.join();
+
+    ASSERT_THAT(handled.size(), Eq(event_count));
+    for (size_t i = 0; i != event_count; ++i)
+    {
+        EXPECT_THAT(handled[i], Eq(static_cast<int>(i + 1)));
+    }
+}
@@ -166,3 +166,31 @@ TEST_F(WaylandExecutorTest, spawning_is_threadsafe)
 
     EXPECT_THAT(counter, Eq(thread_count));
 }
+
+TEST_F(WaylandExecutorTest, running_pending_work_runs_spawned_tasks_without_dispatching_the_event_loop)
+{
+    mf::WaylandExecutor executor{the_event_loop};
+
+    bool executed{false};
+    executor.spawn([&executed]() { executed = true; });
+
+    executor.run_pending_work();
+
+    EXPECT_TRUE(executed);
+}
+
+TEST_F(WaylandExecutorTest, dispatching_after_running_pending_work_does_not_run_tasks_again)
+{
+    mf::WaylandExecutor executor{the_event_loop};
+
+    int executions{0};
+    executor.spawn([&executions]() { ++executions; });
+
+    executor.run_pending_work();
+    while (mt::fd_is_readable(event_loop_fd))
+    {
+        wl_event_loop_dispatch(the_event_loop, 0);
+    }
+
+    EXPECT_THAT(executions, Eq(1));
+}